@@ -3,19 +3,36 @@
 #include <string>
 #include <iostream>
 #include <map>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <atomic>
+#include <expected>
+#include <chrono>
 
 #include "./binance_type.hpp"
+#include "./binance_error.hpp"
+#include "./binance_policy.hpp"
+#include "./endpoint.hpp"
+#include "./decoder.hpp"
+#include "./sbe.hpp"
 #include "../request/request.hpp"
+#include "../stream/depth_decoder.hpp"
 #include "../utils/utils.hpp"
+#include "../utils/singleflight.hpp"
+#include "../utils/ttl_cache.hpp"
+#include "../utils/parallel.hpp"
 #include "../utils/json.hpp"
 
 
 using json = nlohmann::json;
 using namespace nlohmann::literals;
 
-const std::string host{"https://api.binance.com"};
-const int port{443};
 const std::string dttm_format = std::string{"%d.%m.%Y %H:%M:%S"};
+/// @brief Одновременных запросов cancel_all по нескольким парам (вес запроса 1)
+const size_t cancel_all_parallel{20};
+/// @brief Лимит веса запросов REST в минуту (REQUEST_WEIGHT)
+const uint64_t request_weight_limit{6000};
 
 struct BaseHeader : public headerparams {
 public:
@@ -26,17 +43,99 @@ public:
   }
 };
 
-/// @brief Класс Binance
-class Binance {
+class OrderTemplate;
+
+/// @brief Формат ответов REST API
+enum class ResponseFormat {
+  JSON = 0,
+  SBE = 1 // application/sbe (схема sbe_schema_id:sbe_schema_version), при отказе сервера - JSON
+};
+
+/// @brief Класс Binance.
+/// Транспорт, подпись и часы задаются политиками (binance_policy.hpp) и вызываются без виртуальных функций:
+/// для своих политик (симулятор, воспроизведение записанных ответов, другой транспорт) подключите binance_impl.hpp.
+/// Методы потокобезопасны: один экземпляр разделяется всеми потоками стратегий. Кеши, объединение запросов
+/// и бюджет веса (лимит на IP) работают только в пределах экземпляра, поэтому клиент на поток не нужен и вреден.
+/// Политики вызываются из нескольких потоков одновременно; transport() отдает политику без синхронизации.
+/// @tparam Transport Транспорт запросов REST
+/// @tparam Signer Подпись запросов
+/// @tparam Clock Часы
+template<typename Transport = RestTransport, typename Signer = HmacSigner, typename Clock = SystemClock>
+class BasicBinance {
 private:
   Auth auth_key;
-  Order json_to_order(const json &js_order);
+  [[no_unique_address]] Transport transport_policy;
+  [[no_unique_address]] Signer signer_policy;
+  [[no_unique_address]] Clock clock_policy;
+  SingleFlight<BinanceResult<bool>> ping_flight;
+  SingleFlight<BinanceResult<uint64_t>> time_flight;
+  SingleFlight<BinanceResult<dec::decimal<8>>> price_flight;
+  SingleFlight<BinanceResult<PriceTable>> prices_flight;
+  SingleFlight<BinanceResult<Balance>> balance_flight;
+  SingleFlight<BinanceResult<Order>> order_flight;
+  SingleFlight<BinanceResult<std::vector<Order>>> orders_flight;
+  SingleFlight<BinanceResult<Commission>> commission_flight;
+  SingleFlight<BinanceResult<DepthSnapshot>> depth_flight;
+  std::atomic<std::shared_ptr<const ExchangeInfo>> order_filters{};
+  std::atomic<bool> sbe_format{false};
+  WeightBudget weight_budget{request_weight_limit};
+  WeightBudget order_budget{order_burst_limit, order_burst_window_ms};
+  WorkerPool workers;
+  std::array<EndpointCounters, endpoint_count> endpoint_counters{};
+  // Кеши объявлены последними и разрушаются первыми: деструктор TtlCache дожидается потока обновления,
+  // загрузчики которого вызывают call<E> (счетчики, бюджет веса, формат, политики)
+  TtlCache<BinanceResult<bool>> ping_cache;
+  TtlCache<BinanceResult<int64_t>> time_cache;
+  TtlCache<BinanceResult<dec::decimal<8>>> price_cache;
+  TtlCache<BinanceResult<PriceTable>> prices_cache;
+  TtlCache<BinanceResult<std::shared_ptr<const ExchangeInfo>>> exchange_cache;
+  std::string flight_key(const std::string &path, const urlparams &u_params);
+  BinanceError round_order(Order &order);
+  BinanceError admit_order();
+  template<typename E>
+  BinanceResult<typename E::Result> send_order(Order &order, OrderRespType resp_type);
+  BinanceResult<RequestResult> negotiate(RequestType r_type, const std::string &path, const headerparams &h_params, const urlparams &u_params);
   void sign(headerparams& h_params, urlparams& u_params);
   void check_error(const RequestResult &r_result);
+  /// @brief Занять вес эндпоинта E (отказ учитывается в счетчиках)
+  template<typename E>
+  bool admit() {
+    if (weight_budget.acquire(E::info.weight, clock_policy.now_ms())) {
+      return true;
+    }
+    endpoint_counters[static_cast<size_t>(E::info.id)].rejected.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /// @brief Запрос и разбор ответа эндпоинта E с учетом вызова, ошибки и задержки
+  template<typename E>
+  BinanceResult<typename E::Result> dispatch(const headerparams &h_params, const urlparams &u_params) {
+    static const std::string path{E::info.path};
+    auto start = std::chrono::steady_clock::now();
+    BinanceResult<RequestResult> r_result{};
+    if constexpr (E::info.sbe) {
+      r_result = negotiate(E::info.method, path, h_params, u_params);
+    }
+    else {
+      r_result = transport_policy.request(E::info.method, path, h_params, u_params);
+    }
+    BinanceResult<typename E::Result> result{r_result.has_value() ? E::decode(*r_result) : std::unexpected(r_result.error())};
+    EndpointCounters &counters = endpoint_counters[static_cast<size_t>(E::info.id)];
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.weight.fetch_add(E::info.weight, std::memory_order_relaxed);
+    if (!result.has_value()) {
+      counters.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+    counters.latency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    return result;
+  }
 public:
   /// @brief Конструктор класса Binance
   /// @param key - Ключи доступа
-  Binance(Auth key);
+  /// @param transport - Транспорт
+  /// @param signer - Подпись
+  /// @param clock - Часы
+  BasicBinance(Auth key, Transport transport = Transport{}, Signer signer = Signer{}, Clock clock = Clock{});
 
   /// @brief Пинг сервера Binance
   /// @return - True успех
@@ -63,17 +162,83 @@ public:
   /// @return - Прайс
   /// @exception BinanceException
   dec::decimal<8> symbol_price(const std::string &symbol);
+
+  /// @brief Возврат цен за несколько пар одним запросом
+  /// @param symbols Торговые пары (пустой список - все пары)
+  /// @return - Таблица цен
+  /// @exception BinanceException
+  PriceTable prices(std::span<const std::string_view> symbols);
+
+  /// @brief Возврат цен за все пары одним запросом
+  /// @return - Таблица цен
+  /// @exception BinanceException
+  PriceTable all_prices();
+  /// @brief Снимок стакана
+  /// @param symbol Торговая пара
+  /// @param limit Количество уровней (1 - 5000)
+  /// @return - Снимок стакана (цены и количества в единицах 1e-8)
+  /// @exception BinanceException
+  DepthSnapshot depth(const std::string &symbol, size_t limit = 5000);
                                 /* Запросы с авторизацие */
   /// @brief Получение баланса пользователя
   /// @return - Баланс
   /// @exception BinanceException
   Balance balance();
 
+  /// @brief Загрузка фильтров торговых пар (/api/v3/exchangeInfo).
+  /// После загрузки create_order округляет цену и количество ордера до tickSize/stepSize
+  /// и проверяет фильтры локально, не отправляя заведомо отклоняемые ордера.
+  /// @return - Таблица фильтров
+  /// @exception BinanceException
+  std::shared_ptr<const ExchangeInfo> load_exchange_info();
+
+  /// @brief Загруженная таблица фильтров торговых пар
+  /// @return - Таблица фильтров (nullptr - не загружена)
+  std::shared_ptr<const ExchangeInfo> exchange_info();
+
   /// @brief Создать лимитный ордер
-  /// @param order Ордер для создания
+  /// @param order Ордер для создания (при загруженных фильтрах цена и количество округляются)
+  /// @param resp_type Состав ответа: ACK - известны только orderId и time (статус NONE, цена и количество из запроса);
+  /// RESULT - ордер; FULL - ордер и сделки (fills, ответ всегда в JSON)
   /// @return - Новый ордер
+  /// @exception BinanceException (ExceptionType::Filter - ордер не прошел локальную проверку фильтров)
+  Order create_order(Order &order, OrderRespType resp_type = OrderRespType::RESULT);
+
+  /// @brief Создать лимитный ордер с минимальным ответом (newOrderRespType=ACK):
+  /// разбираются только orderId, clientOrderId и transactTime
+  /// @param order Ордер для создания (при загруженных фильтрах цена и количество округляются)
+  /// @return - Подтверждение приема ордера
+  /// @exception BinanceException (ExceptionType::Filter - ордер не прошел локальную проверку фильтров)
+  OrderAck create_order_ack(Order &order);
+
+  /// @brief Создать несколько ордеров (лесенку): запросы подписываются и отправляются параллельно по пулу соединений
+  /// из потоков пула клиента, не более max_parallel одновременно, поэтому 50 ордеров выставляются примерно за один RTT.
+  /// Ордера сверх бюджета ORDERS клиента (order_limit за 10 секунд) не подписываются и не отправляются (ошибка -1015)
+  /// @param orders Ордера (при загруженных фильтрах цена и количество округляются)
+  /// @param max_parallel Одновременных запросов
+  /// @return - Новый ордер или ошибка для каждого ордера в порядке orders
+  std::vector<BinanceResult<Order>> create_orders(std::span<Order> orders, size_t max_parallel = order_burst_limit);
+
+  /// @brief Проверка ордера без выставления (/api/v3/order/test): подпись, фильтры и параметры проверяются сервером
+  /// @param order Ордер (при загруженных фильтрах цена и количество округляются)
   /// @exception BinanceException
-  Order create_order(Order &order);
+  void test_order(Order &order);
+
+  /// @brief Прогрев пути создания ордера без влияния на рынок: подпись -> отправка -> разбор ответа
+  /// через /api/v3/order/test. Открывает (или поддерживает) keep-alive соединение и прогревает код и память,
+  /// чтобы первый реальный ордер не платил за холодный старт. Для периодического прогрева - OrderWarmup.
+  /// @param order Ордер, похожий на будущие реальные
+  /// @return - Время прогона (нс)
+  /// @exception BinanceException
+  uint64_t warmup(const Order &order);
+
+  /// @brief Создать лимитный ордер по шаблону: неизменная часть запроса и подписи уже подготовлена
+  /// @param order_template Шаблон (пара, сторона, ключи)
+  /// @param price Цена
+  /// @param quantity Количество
+  /// @return - Новый ордер
+  /// @exception BinanceException (ExceptionType::Filter - ордер не прошел локальную проверку фильтров)
+  Order create_order(OrderTemplate &order_template, const dec::decimal<8> &price, const dec::decimal<8> &quantity);
 
   /// @brief Открытые ордера
   /// @param symbol Торговая пара
@@ -88,6 +253,35 @@ public:
   /// @exception BinanceException
   Order cancel_order(const std::string &symbol, const uint64_t &order_id);
 
+  /// @brief Отмена всех открытых ордеров пары одним запросом (DELETE /api/v3/openOrders)
+  /// @param symbol Торговая пара
+  /// @return - Отмененные ордера (пустой вектор - открытых ордеров нет)
+  /// @exception BinanceException
+  std::vector<Order> cancel_all(const std::string &symbol);
+
+  /// @brief Отмена всех открытых ордеров нескольких пар: запросы по парам выполняются параллельно,
+  /// не более max_parallel одновременно, поэтому отмена по 20 парам занимает около одного RTT
+  /// @param symbols Торговые пары
+  /// @param max_parallel Одновременных запросов
+  /// @return - Результаты в порядке symbols (ошибка пары не прерывает отмену остальных)
+  std::vector<CancelAllResult> cancel_all(std::span<const std::string> symbols, size_t max_parallel = cancel_all_parallel);
+
+  /// @brief Отмена ордера и создание нового одним запросом (POST /api/v3/order/cancelReplace)
+  /// @param order_id Id отменяемого ордера
+  /// @param order Новый лимитный ордер той же пары (при загруженных фильтрах цена и количество округляются)
+  /// @param mode Создавать ли новый ордер, если отмена не удалась
+  /// @return - Результаты обеих частей; частичный отказ (-2021, -2022) возвращается в результате, а не исключением
+  /// @exception BinanceException
+  CancelReplaceResult cancel_replace(const uint64_t &order_id, Order &order, CancelReplaceMode mode = CancelReplaceMode::STOP_ON_FAILURE);
+
+  /// @brief Уменьшение количества ордера с сохранением места в очереди (PUT /api/v3/order/amend/keepPriority)
+  /// @param symbol Торговая пара
+  /// @param order_id Id ордера
+  /// @param new_qty Новое количество (меньше текущего)
+  /// @return - Измененный ордер
+  /// @exception BinanceException
+  AmendResult amend_order(const std::string &symbol, const uint64_t &order_id, const dec::decimal<8> &new_qty);
+
   /// @brief Информация по ордеру
   /// @param symbol Торговая пара
   /// @param order_id Id ордера
@@ -107,8 +301,145 @@ public:
   /// @return - Вектор ордеров
   /// @exception BinanceException
   std::vector<Order> all_orders(const std::string &symbol);
+
+  /// @brief Создание ключа потока пользовательских данных (POST /api/v3/userDataStream).
+  /// Ключ действует 60 минут, продлевается keepalive_listen_key.
+  /// @return - listenKey
+  /// @exception BinanceException
+  std::string create_listen_key();
+
+  /// @brief Продление ключа потока пользовательских данных на 60 минут (PUT /api/v3/userDataStream)
+  /// @param listen_key Ключ
+  /// @exception BinanceException
+  void keepalive_listen_key(const std::string &listen_key);
+
+  /// @brief Закрытие ключа потока пользовательских данных (DELETE /api/v3/userDataStream)
+  /// @param listen_key Ключ
+  /// @exception BinanceException
+  void close_listen_key(const std::string &listen_key);
+
+                                /* Типизированный вызов эндпоинта */
+  /// @brief Запрос к эндпоинту E (endpoint::Ping, endpoint::NewOrder, ...): заголовки, подпись и ключ по E::info.auth,
+  /// проверка бюджета веса, запрос (SBE - если E::info.sbe), разбор ответа E::decode и счетчики эндпоинта.
+  /// Путь, метод, вес и авторизация известны при компиляции, поэтому каждая инстанциация - прямой код без поиска в таблице.
+  /// @param params Параметры запроса (подпись добавляется в копию)
+  /// @return - Результат или ошибка (ExceptionType::Filter, -1003 - запрос не отправлен, исчерпан бюджет веса)
+  template<typename E>
+  BinanceResult<typename E::Result> call(urlparams params = urlparams()) {
+    // Бюджет проверяется до заголовков и подписи: отклоненный запрос ничего не стоит
+    if (!admit<E>()) {
+      return std::unexpected(BinanceError{ExceptionType::Filter, -1003, ErrorMessage::WEIGHT_BUDGET});
+    }
+    BaseHeader header;
+    if constexpr (EndpointAuth::SIGNED == E::info.auth) {
+      sign(header, params);
+    }
+    else if constexpr (EndpointAuth::API_KEY == E::info.auth) {
+      header.add("X-MBX-APIKEY", auth_key.api_key);
+    }
+    return dispatch<E>(header, params);
+  }
+
+  /// @brief Запрос к эндпоинту E с готовыми заголовками и параметрами (подписанными заранее, например OrderTemplate)
+  /// @param h_params Заголовки
+  /// @param u_params Параметры запроса
+  /// @return - Результат или ошибка
+  template<typename E>
+  BinanceResult<typename E::Result> call(const headerparams &h_params, const urlparams &u_params) {
+    if (!admit<E>()) {
+      return std::unexpected(BinanceError{ExceptionType::Filter, -1003, ErrorMessage::WEIGHT_BUDGET});
+    }
+    return dispatch<E>(h_params, u_params);
+  }
+
+  /// @brief Статистика эндпоинта: запросы, ошибки, отказы по бюджету веса, вес и задержки
+  /// @param id Эндпоинт
+  /// @return - Статистика
+  EndpointStats endpoint_stats(EndpointId id);
+
+  /// @brief Вес запросов, занятый в текущей минуте
+  uint64_t weight_used() const;
+
+  /// @brief Локальный лимит веса запросов в минуту (по умолчанию request_weight_limit)
+  /// @param limit Лимит (0 - все запросы отклоняются без отправки)
+  void weight_limit(uint64_t limit);
+
+  /// @brief Новых ордеров, выставленных в текущем окне лимита ORDERS (10 секунд)
+  uint64_t orders_used() const;
+
+  /// @brief Локальный лимит новых ордеров за 10 секунд (по умолчанию order_burst_limit).
+  /// Расходуется всеми путями создания ордера (create_order, create_orders, шаблон, cancel_replace), кроме test_order
+  /// @param limit Лимит (0 - все ордера отклоняются без отправки, ошибка -1015)
+  void order_limit(uint64_t limit);
+
+                                /* Вызовы без исключений */
+  // Те же запросы, что и у одноименных методов без префикса try_, но ошибка возвращается в BinanceResult:
+  // тело ошибки разбирается один раз без JSON DOM, отказ (-2010, -2011, фильтры) не стоит исключения.
+  // ping, время, цены и exchangeInfo проходят через кеш ответов: ошибка возвращается, но не кешируется.
+
+  BinanceResult<bool> try_ping();
+  BinanceResult<uint64_t> try_timestamp_ms();
+  BinanceResult<dec::decimal<8>> try_symbol_price(const std::string &symbol);
+  BinanceResult<PriceTable> try_prices(std::span<const std::string_view> symbols);
+  BinanceResult<PriceTable> try_all_prices();
+  BinanceResult<DepthSnapshot> try_depth(const std::string &symbol, size_t limit = 5000);
+  BinanceResult<Balance> try_balance();
+  BinanceResult<std::shared_ptr<const ExchangeInfo>> try_load_exchange_info();
+  /// @brief Загруженная таблица фильтров, при отсутствии - загрузка (try_load_exchange_info)
+  BinanceResult<std::shared_ptr<const ExchangeInfo>> try_exchange_info();
+  BinanceResult<Order> try_create_order(Order &order, OrderRespType resp_type = OrderRespType::RESULT);
+  BinanceResult<OrderAck> try_create_order_ack(Order &order);
+  BinanceResult<void> try_test_order(Order &order);
+  BinanceResult<Order> try_create_order(OrderTemplate &order_template, const dec::decimal<8> &price, const dec::decimal<8> &quantity);
+  BinanceResult<std::vector<Order>> try_open_orders(const std::string &symbol);
+  BinanceResult<Order> try_cancel_order(const std::string &symbol, const uint64_t &order_id);
+  BinanceResult<std::vector<Order>> try_cancel_all(const std::string &symbol);
+  BinanceResult<CancelReplaceResult> try_cancel_replace(const uint64_t &order_id, Order &order,
+                                                        CancelReplaceMode mode = CancelReplaceMode::STOP_ON_FAILURE);
+  BinanceResult<AmendResult> try_amend_order(const std::string &symbol, const uint64_t &order_id, const dec::decimal<8> &new_qty);
+  BinanceResult<Order> try_order_info(const std::string &symbol, const uint64_t &order_id);
+  BinanceResult<Commission> try_order_commission(const std::string &symbol, const uint64_t &order_id);
+  BinanceResult<std::vector<Order>> try_all_orders(const std::string &symbol);
+  BinanceResult<std::string> try_create_listen_key();
+  BinanceResult<void> try_keepalive_listen_key(const std::string &listen_key);
+  BinanceResult<void> try_close_listen_key(const std::string &listen_key);
+
+  /// @brief Статистика объединения одинаковых одновременных запросов.
+  /// Одинаковые запросы на чтение (ping, время, цена, баланс, ордера, коммиссия),
+  /// пришедшие из разных потоков одновременно, выполняются одним HTTP запросом.
+  /// @return - Количество вызовов, выполненных и объединенных запросов
+  SingleFlightStats flight_stats();
+  /// @brief Настройка кеширования ответов публичного эндпоинта.
+  /// По умолчанию кеш выключен (ttl = 0), каждый вызов обращается к серверу.
+  /// @param endpoint Эндпоинт: "/api/v3/ping", "/api/v3/time", "/api/v3/ticker/price", "/api/v3/exchangeInfo"
+  /// @param policy Политика свежести
+  /// @return - True успех; False - эндпоинт не поддерживает кеширование
+  bool cache_policy(const std::string &endpoint, CachePolicy policy);
+
+  /// @brief Формат ответов: SBE для времени сервера, цен, баланса и ордеров (остальные эндпоинты - JSON).
+  /// SBE ответ декодируется без разбора текста; если сервер не поддерживает схему,
+  /// запрос повторяется в JSON и формат переключается на JSON.
+  /// @param format Формат
+  void response_format(ResponseFormat format);
+
+  /// @brief Текущий формат ответов (JSON после отказа сервера от SBE)
+  ResponseFormat response_format() const;
+
+  /// @brief Статистика кеша эндпоинта (попадания, промахи, задержки)
+  /// @param endpoint Эндпоинт
+  /// @return - Статистика
+  CacheStats cache_stats(const std::string &endpoint);
+
+  /// @brief Транспорт клиента (настройка симулятора или воспроизведения)
+  Transport &transport();
+
   /// @brief Деструктор класса Binance
-  ~Binance();
+  ~BasicBinance();
 };
 
+/// @brief Клиент с политиками по умолчанию: libcurl, HMAC SHA256, системное время.
+/// Собран в binance.cpp, остальные единицы трансляции его не инстанцируют
+extern template class BasicBinance<RestTransport, HmacSigner, SystemClock>;
+using Binance = BasicBinance<>;
+
 
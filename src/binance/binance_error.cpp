@@ -0,0 +1,122 @@
+#include "binance_error.hpp"
+#include "exchange_info.hpp"
+
+#include <utility>
+
+namespace {
+
+inline constexpr auto error_messages = make_enum_table<ErrorMessage>({
+  {ErrorMessage::NONE, ""},
+  {ErrorMessage::TOO_MANY_ORDERS, "Too many new orders."},
+  {ErrorMessage::OUTSIDE_RECV_WINDOW, "Timestamp for this request is outside of the recvWindow."},
+  {ErrorMessage::INVALID_SIGNATURE, "Signature for this request is not valid."},
+  {ErrorMessage::FILTER_PRICE, "Filter failure: PRICE_FILTER"},
+  {ErrorMessage::FILTER_LOT_SIZE, "Filter failure: LOT_SIZE"},
+  {ErrorMessage::FILTER_MIN_NOTIONAL, "Filter failure: MIN_NOTIONAL"},
+  {ErrorMessage::FILTER_NOTIONAL, "Filter failure: NOTIONAL"},
+  {ErrorMessage::FILTER_PERCENT_PRICE, "Filter failure: PERCENT_PRICE_BY_SIDE"},
+  {ErrorMessage::FILTER_MAX_NUM_ORDERS, "Filter failure: MAX_NUM_ORDERS"},
+  {ErrorMessage::INSUFFICIENT_BALANCE, "Account has insufficient balance for requested action."},
+  {ErrorMessage::WOULD_MATCH, "Order would immediately match and take."},
+  {ErrorMessage::WOULD_TRIGGER, "Order would immediately trigger."},
+  {ErrorMessage::MARKET_CLOSED, "Market is closed."},
+  {ErrorMessage::DUPLICATE_ORDER, "Duplicate order sent."},
+  {ErrorMessage::UNKNOWN_ORDER, "Unknown order sent."},
+  {ErrorMessage::ORDER_NOT_EXIST, "Order does not exist."},
+  {ErrorMessage::INVALID_API_KEY, "Invalid API-key, IP, or permissions for action."},
+  {ErrorMessage::INVALID_RESPONSE, "Response is not valid"},
+  {ErrorMessage::WEIGHT_BUDGET, "Request weight budget exceeded"},
+  {ErrorMessage::INVALID_SYMBOL, "Invalid symbol."},
+  {ErrorMessage::CONNECTION_CLOSED, "Connection closed"},
+  {ErrorMessage::NOT_CONNECTED, "Not connected"},
+  {ErrorMessage::NOT_LOGGED_ON, "Not logged on"},
+  {ErrorMessage::REQUEST_TIMEOUT, "Request timeout"},
+  {ErrorMessage::TOO_MANY_PENDING, "Too many pending requests"},
+  {ErrorMessage::INVALID_ORDER, "Order is not valid"},
+  {ErrorMessage::INVALID_ORDER_ACK, "Order ack is not valid"},
+  {ErrorMessage::NO_ORDER_RESPONSE, "newOrderResponse not found"},
+  {ErrorMessage::TEMPLATE_ORDER_TYPE, "OrderTemplate supports LIMIT and LIMIT_MAKER only"},
+  {ErrorMessage::FILTER_FAILURE, "Filter failure"},
+  {ErrorMessage::NEW_ORDER_REJECTED, "New order rejected"},
+  {ErrorMessage::CANCEL_REJECTED, "Cancel rejected"},
+  {ErrorMessage::BINANCE_ERROR, "Binance error"},
+  {ErrorMessage::SERVER_ERROR, "Server error"},
+  {ErrorMessage::TRANSPORT_ERROR, "Transport error"}
+});
+
+/// @brief Общий текст для кода Binance, текст которого не найден в таблице
+/// (например, -1021 с разницей времени в тексте)
+inline constexpr std::pair<int, ErrorMessage> binance_code_messages[] = {
+  {-1013, ErrorMessage::FILTER_FAILURE},
+  {-1015, ErrorMessage::TOO_MANY_ORDERS},
+  {-1021, ErrorMessage::OUTSIDE_RECV_WINDOW},
+  {-1022, ErrorMessage::INVALID_SIGNATURE},
+  {-1121, ErrorMessage::INVALID_SYMBOL},
+  {-2010, ErrorMessage::NEW_ORDER_REJECTED},
+  {-2011, ErrorMessage::CANCEL_REJECTED},
+  {-2013, ErrorMessage::ORDER_NOT_EXIST},
+  {-2015, ErrorMessage::INVALID_API_KEY}
+};
+
+/// @brief Текст ошибки фильтра по FilterResult (code ошибки ExceptionType::Filter)
+constexpr ErrorMessage filter_message(int code) {
+  switch (static_cast<FilterResult>(code)) {
+    case FilterResult::UNKNOWN_SYMBOL: return ErrorMessage::INVALID_SYMBOL;
+    case FilterResult::PRICE_FILTER: return ErrorMessage::FILTER_PRICE;
+    case FilterResult::LOT_SIZE: return ErrorMessage::FILTER_LOT_SIZE;
+    case FilterResult::MIN_NOTIONAL: return ErrorMessage::FILTER_MIN_NOTIONAL;
+    case FilterResult::PERCENT_PRICE: return ErrorMessage::FILTER_PERCENT_PRICE;
+    default: return ErrorMessage::FILTER_FAILURE;
+  }
+}
+
+/// @brief Общий текст ошибки, текст которой не найден в таблице
+constexpr ErrorMessage generic_message(ExceptionType type, int code) {
+  switch (type) {
+    case ExceptionType::Binance:
+      for (const auto &[b_code, message] : binance_code_messages) {
+        if (b_code == code) {
+          return message;
+        }
+      }
+      return ErrorMessage::BINANCE_ERROR;
+    case ExceptionType::Filter:
+      return filter_message(code);
+    case ExceptionType::Server:
+      return ErrorMessage::SERVER_ERROR;
+    case ExceptionType::Transport:
+      return ErrorMessage::TRANSPORT_ERROR;
+    default:
+      return ErrorMessage::NONE;
+  }
+}
+
+}
+
+ErrorMessage error_message_id(std::string_view text) {
+  return error_messages.from_str(text, ErrorMessage::NONE);
+}
+
+std::string_view error_message(ErrorMessage message) {
+  return error_messages.to_str(message, "");
+}
+
+std::string_view BinanceError::msg() const {
+  return error_message(message);
+}
+
+BinanceException BinanceError::exception() const {
+  return BinanceException{type, code, std::string{msg()}};
+}
+
+BinanceError make_error(ExceptionType type, int code, std::string_view text) {
+  ErrorMessage message = error_message_id(text);
+  if (ErrorMessage::NONE == message) {
+    message = generic_message(type, code);
+  }
+  return BinanceError{type, code, message};
+}
+
+BinanceError make_error(const BinanceException &e) {
+  return make_error(e.e_type, e.e_code, e.e_msg);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <vector>
+#include <expected>
+#include <type_traits>
+
+#include "./binance_type.hpp"
+
+/// @brief Идентификатор текста ошибки. Известные тексты имеют постоянные значения,
+/// остальные сводятся к общему тексту по коду Binance или по типу ошибки (make_error)
+enum class ErrorMessage : uint16_t {
+  NONE = 0,
+  TOO_MANY_ORDERS = 1, // -1015 "Too many new orders."
+  OUTSIDE_RECV_WINDOW = 2, // -1021
+  INVALID_SIGNATURE = 3, // -1022
+  FILTER_PRICE = 4, // -1013 "Filter failure: PRICE_FILTER"
+  FILTER_LOT_SIZE = 5, // -1013 "Filter failure: LOT_SIZE"
+  FILTER_MIN_NOTIONAL = 6, // -1013 "Filter failure: MIN_NOTIONAL"
+  FILTER_NOTIONAL = 7, // -1013 "Filter failure: NOTIONAL"
+  FILTER_PERCENT_PRICE = 8, // -1013 "Filter failure: PERCENT_PRICE_BY_SIDE"
+  FILTER_MAX_NUM_ORDERS = 9, // -1013 "Filter failure: MAX_NUM_ORDERS"
+  INSUFFICIENT_BALANCE = 10, // -2010
+  WOULD_MATCH = 11, // -2010 отказ LIMIT_MAKER
+  WOULD_TRIGGER = 12, // -2010
+  MARKET_CLOSED = 13, // -2010
+  DUPLICATE_ORDER = 14, // -2010
+  UNKNOWN_ORDER = 15, // -2011
+  ORDER_NOT_EXIST = 16, // -2013
+  INVALID_API_KEY = 17, // -2015
+  INVALID_RESPONSE = 18, // Ответ сервера не разобран
+  WEIGHT_BUDGET = 19, // Запрос не отправлен: исчерпан локальный бюджет веса
+  INVALID_SYMBOL = 20, // -1121
+  CONNECTION_CLOSED = 21, // WebSocket/FIX соединение закрыто
+  NOT_CONNECTED = 22,
+  NOT_LOGGED_ON = 23,
+  REQUEST_TIMEOUT = 24,
+  TOO_MANY_PENDING = 25,
+  INVALID_ORDER = 26,
+  INVALID_ORDER_ACK = 27,
+  NO_ORDER_RESPONSE = 28,
+  TEMPLATE_ORDER_TYPE = 29,
+  FILTER_FAILURE = 30, // -1013 с другим текстом, ExceptionType::Filter без своего текста
+  NEW_ORDER_REJECTED = 31, // -2010 с другим текстом
+  CANCEL_REJECTED = 32, // -2011 с другим текстом
+  BINANCE_ERROR = 33, // Прочие ошибки Binance - текст по коду не сохраняется
+  SERVER_ERROR = 34,
+  TRANSPORT_ERROR = 35
+};
+
+/// @brief Ошибка вызова без исключений: тип, код и идентификатор текста.
+/// Копируется без выделения памяти (trivially copyable), текст - error_message(message)
+struct BinanceError {
+  ExceptionType type{ExceptionType::None};
+  int code{0}; // Код Binance, HTTP статус, CURLcode или FilterResult - по type
+  ErrorMessage message{ErrorMessage::NONE};
+
+  /// @brief Текст ошибки
+  std::string_view msg() const;
+
+  /// @brief Исключение для throwing API
+  BinanceException exception() const;
+};
+
+static_assert(std::is_trivially_copyable_v<BinanceError>);
+
+/// @brief Результат вызова без исключений
+template<typename T>
+using BinanceResult = std::expected<T, BinanceError>;
+
+/// @brief Результат отмены всех открытых ордеров одной пары (cancel_all по нескольким парам)
+struct CancelAllResult {
+  std::string symbol{};
+  std::vector<Order> orders{}; // Отмененные ордера
+  BinanceError error{}; // error.type == ExceptionType::None - успех
+};
+
+/// @brief Идентификатор известного текста ошибки (таблица строится при компиляции, без блокировок)
+/// @param text Текст ошибки
+/// @return - Идентификатор (ErrorMessage::NONE - текст вне таблицы)
+ErrorMessage error_message_id(std::string_view text);
+
+/// @brief Текст ошибки по идентификатору (статическая строка)
+/// @param message Идентификатор
+/// @return - Текст (пустой - неизвестный идентификатор)
+std::string_view error_message(ErrorMessage message);
+
+/// @brief Ошибка с текстом: известный текст, иначе общий текст по коду Binance или по типу.
+/// Исходный текст неизвестной ошибки не сохраняется - code остается в ошибке
+BinanceError make_error(ExceptionType type, int code, std::string_view text);
+
+/// @brief Ошибка из исключения
+BinanceError make_error(const BinanceException &e);
+
+/// @brief Значение или исключение BinanceException (throwing API поверх std::expected)
+template<typename T>
+T value_or_throw(BinanceResult<T> &&result) {
+  if (!result.has_value()) {
+    throw result.error().exception();
+  }
+  if constexpr (!std::is_void_v<T>) {
+    return std::move(*result);
+  }
+}
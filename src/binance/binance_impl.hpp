@@ -0,0 +1,653 @@
+#pragma once
+
+#include "./binance.hpp"
+#include "./order_template.hpp"
+#include "./order_builder.hpp"
+
+// Определения методов BasicBinance. Клиент с политиками по умолчанию собирается в binance.cpp;
+// этот заголовок подключается только для клиента со своими политиками.
+
+template<typename Transport, typename Signer, typename Clock>
+BasicBinance<Transport, Signer, Clock>::BasicBinance(Auth key, Transport transport, Signer signer, Clock clock)
+    : auth_key(key), transport_policy(std::move(transport)), signer_policy(std::move(signer)), clock_policy(std::move(clock)) {}
+
+template<typename Transport, typename Signer, typename Clock>
+bool BasicBinance<Transport, Signer, Clock>::ping() {
+  return value_or_throw(try_ping());
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<bool> BasicBinance<Transport, Signer, Clock>::try_ping() {
+  return ping_cache.get("/api/v3/ping", [this]() {
+    return ping_flight.run("/api/v3/ping", [this]() {
+      return call<endpoint::Ping>();
+    });
+  });
+}
+
+template<typename Transport, typename Signer, typename Clock>
+int BasicBinance<Transport, Signer, Clock>::diff_time() {
+  uint64_t current_time{clock_policy.now_ms()};
+  uint64_t server_timestamp{timestamp_ms()};
+  return server_timestamp - current_time;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+uint64_t BasicBinance<Transport, Signer, Clock>::timestamp_ms() {
+  return value_or_throw(try_timestamp_ms());
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<uint64_t> BasicBinance<Transport, Signer, Clock>::try_timestamp_ms() {
+  // В кеше хранится смещение времени сервера относительно системного времени
+  BinanceResult<int64_t> offset = time_cache.get("/api/v3/time", [this]() -> BinanceResult<int64_t> {
+    BinanceResult<uint64_t> server_time = time_flight.run("/api/v3/time", [this]() {
+      return call<endpoint::Time>();
+    });
+    if (!server_time.has_value()) {
+      return std::unexpected(server_time.error());
+    }
+    return static_cast<int64_t>(*server_time - clock_policy.now_ms());
+  });
+  if (!offset.has_value()) {
+    return std::unexpected(offset.error());
+  }
+  return clock_policy.now_ms() + *offset;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+std::string BasicBinance<Transport, Signer, Clock>::data_time() {
+  std::string dttm = since_epoch_dttm(timestamp_ms(), dttm_format);
+  return dttm;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+dec::decimal<8> BasicBinance<Transport, Signer, Clock>::symbol_price(const std::string &symbol) {
+  return value_or_throw(try_symbol_price(symbol));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<dec::decimal<8>> BasicBinance<Transport, Signer, Clock>::try_symbol_price(const std::string &symbol) {
+  urlparams params;
+  params.add("symbol", symbol);
+  std::string key{flight_key("/api/v3/ticker/price", params)};
+  return price_cache.get(key, [this, key, params]() {
+    return price_flight.run(key, [&]() {
+      return call<endpoint::TickerPrice>(params);
+    });
+  });
+}
+
+template<typename Transport, typename Signer, typename Clock>
+PriceTable BasicBinance<Transport, Signer, Clock>::prices(std::span<const std::string_view> symbols) {
+  return value_or_throw(try_prices(symbols));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<PriceTable> BasicBinance<Transport, Signer, Clock>::try_prices(std::span<const std::string_view> symbols) {
+  urlparams params;
+  if (1 == symbols.size()) {
+    params.add("symbol", symbols.front());
+  }
+  else if (!symbols.empty()) {
+    std::string js_symbols{"["};
+    for (auto &symbol : symbols) {
+      js_symbols += std::format("{}\"{}\"", (1 == js_symbols.size()) ? "" : ",", symbol);
+    }
+    js_symbols += "]";
+    params.add("symbols", url_encode(js_symbols));
+  }
+  std::string key{flight_key("/api/v3/ticker/price", params)};
+  return prices_cache.get(key, [this, key, params]() {
+    return prices_flight.run(key, [&]() {
+      return call<endpoint::TickerPrices>(params);
+    });
+  });
+}
+
+template<typename Transport, typename Signer, typename Clock>
+PriceTable BasicBinance<Transport, Signer, Clock>::all_prices() {
+  return prices(std::span<const std::string_view>{});
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<PriceTable> BasicBinance<Transport, Signer, Clock>::try_all_prices() {
+  return try_prices(std::span<const std::string_view>{});
+}
+
+template<typename Transport, typename Signer, typename Clock>
+DepthSnapshot BasicBinance<Transport, Signer, Clock>::depth(const std::string &symbol, size_t limit) {
+  return value_or_throw(try_depth(symbol, limit));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<DepthSnapshot> BasicBinance<Transport, Signer, Clock>::try_depth(const std::string &symbol, size_t limit) {
+  urlparams params;
+  params.add("symbol", symbol);
+  params.add("limit", limit);
+  std::string key{flight_key("/api/v3/depth", params)};
+  return depth_flight.run(key, [&]() {
+    return call<endpoint::Depth>(params);
+  });
+}
+
+template<typename Transport, typename Signer, typename Clock>
+std::shared_ptr<const ExchangeInfo> BasicBinance<Transport, Signer, Clock>::load_exchange_info() {
+  return value_or_throw(try_load_exchange_info());
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<std::shared_ptr<const ExchangeInfo>> BasicBinance<Transport, Signer, Clock>::try_load_exchange_info() {
+  BinanceResult<std::shared_ptr<const ExchangeInfo>> info = exchange_cache.get("/api/v3/exchangeInfo", [this]() {
+    return call<endpoint::ExchangeInfo>();
+  });
+  if (info.has_value()) {
+    order_filters.store(*info);
+  }
+  return info;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+std::shared_ptr<const ExchangeInfo> BasicBinance<Transport, Signer, Clock>::exchange_info() {
+  return order_filters.load();
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<std::shared_ptr<const ExchangeInfo>> BasicBinance<Transport, Signer, Clock>::try_exchange_info() {
+  std::shared_ptr<const ExchangeInfo> info = order_filters.load();
+  if (info) {
+    return info;
+  }
+  return try_load_exchange_info();
+}
+
+template<typename Transport, typename Signer, typename Clock>
+bool BasicBinance<Transport, Signer, Clock>::cache_policy(const std::string &endpoint, CachePolicy policy) {
+  if ("/api/v3/ping" == endpoint) {
+    ping_cache.policy(policy);
+  }
+  else if ("/api/v3/time" == endpoint) {
+    time_cache.policy(policy);
+  }
+  else if ("/api/v3/ticker/price" == endpoint) {
+    price_cache.policy(policy);
+    prices_cache.policy(policy);
+  }
+  else if ("/api/v3/exchangeInfo" == endpoint) {
+    exchange_cache.policy(policy);
+  }
+  else {
+    return false;
+  }
+  return true;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+CacheStats BasicBinance<Transport, Signer, Clock>::cache_stats(const std::string &endpoint) {
+  if ("/api/v3/ping" == endpoint) {
+    return ping_cache.stats();
+  }
+  else if ("/api/v3/time" == endpoint) {
+    return time_cache.stats();
+  }
+  else if ("/api/v3/ticker/price" == endpoint) {
+    CacheStats result{price_cache.stats()};
+    CacheStats bulk{prices_cache.stats()};
+    result.hits += bulk.hits;
+    result.stale_hits += bulk.stale_hits;
+    result.misses += bulk.misses;
+    result.refreshes += bulk.refreshes;
+    result.refresh_errors += bulk.refresh_errors;
+    result.hit_p50_ns = std::max(result.hit_p50_ns, bulk.hit_p50_ns);
+    result.hit_p99_ns = std::max(result.hit_p99_ns, bulk.hit_p99_ns);
+    result.miss_p50_ns = std::max(result.miss_p50_ns, bulk.miss_p50_ns);
+    result.miss_p99_ns = std::max(result.miss_p99_ns, bulk.miss_p99_ns);
+    return result;
+  }
+  else if ("/api/v3/exchangeInfo" == endpoint) {
+    return exchange_cache.stats();
+  }
+  return CacheStats{};
+}
+
+template<typename Transport, typename Signer, typename Clock>
+Balance BasicBinance<Transport, Signer, Clock>::balance() {
+  return value_or_throw(try_balance());
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<Balance> BasicBinance<Transport, Signer, Clock>::try_balance() {
+  urlparams params;
+  params.add("omitZeroBalances", true);
+  return balance_flight.run(flight_key("/api/v3/account", params), [&]() {
+    return call<endpoint::Account>(params);
+  });
+}
+
+template<typename Transport, typename Signer, typename Clock>
+template<typename E>
+BinanceResult<typename E::Result> BasicBinance<Transport, Signer, Clock>::send_order(Order &order, OrderRespType resp_type) {
+  BinanceError error{round_order(order)};
+  // /api/v3/order/test не расходует лимит ORDERS
+  if constexpr (EndpointId::TEST_ORDER != E::info.id) {
+    if (ExceptionType::None == error.type) {
+      error = admit_order();
+    }
+  }
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  urlparams params;
+  order_params(order, [&params](const char *key, std::string_view value) { params.add(key, value); });
+  params.add("newOrderRespType", order_resp_type_to_str(resp_type));
+  return call<E>(params);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+Order BasicBinance<Transport, Signer, Clock>::create_order(Order &order, OrderRespType resp_type) {
+  return value_or_throw(try_create_order(order, resp_type));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<Order> BasicBinance<Transport, Signer, Clock>::try_create_order(Order &order, OrderRespType resp_type) {
+  if (OrderRespType::ACK == resp_type) {
+    BinanceResult<OrderAck> ack{try_create_order_ack(order)};
+    if (!ack.has_value()) {
+      return std::unexpected(ack.error());
+    }
+    Order result{order.symbol, ack->orderId, order.price, order.origQty, order.side, OrderStatus::NONE, ack->transactTime};
+    return result;
+  }
+  if (OrderRespType::FULL == resp_type) {
+    // Сделки (fills) разбираются только из JSON ответа
+    return send_order<endpoint::NewOrderFull>(order, resp_type);
+  }
+  return send_order<endpoint::NewOrder>(order, resp_type);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+OrderAck BasicBinance<Transport, Signer, Clock>::create_order_ack(Order &order) {
+  return value_or_throw(try_create_order_ack(order));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<OrderAck> BasicBinance<Transport, Signer, Clock>::try_create_order_ack(Order &order) {
+  return send_order<endpoint::NewOrderAck>(order, OrderRespType::ACK);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+void BasicBinance<Transport, Signer, Clock>::test_order(Order &order) {
+  value_or_throw(try_test_order(order));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<void> BasicBinance<Transport, Signer, Clock>::try_test_order(Order &order) {
+  BinanceResult<bool> result{send_order<endpoint::TestOrder>(order, OrderRespType::RESULT)};
+  if (!result.has_value()) {
+    return std::unexpected(result.error());
+  }
+  return {};
+}
+
+template<typename Transport, typename Signer, typename Clock>
+uint64_t BasicBinance<Transport, Signer, Clock>::warmup(const Order &order) {
+  auto start = std::chrono::steady_clock::now();
+  Order test{order};
+  test_order(test);
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceError BasicBinance<Transport, Signer, Clock>::admit_order() {
+  if (!order_budget.acquire(1, clock_policy.now_ms())) {
+    return BinanceError{ExceptionType::Filter, -1015, ErrorMessage::TOO_MANY_ORDERS};
+  }
+  return BinanceError{};
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceError BasicBinance<Transport, Signer, Clock>::round_order(Order &order) {
+  std::shared_ptr<const ExchangeInfo> filters = order_filters.load();
+  if (filters) {
+    FilterResult f_result = filters->round(order);
+    if (FilterResult::OK != f_result) {
+      return make_error(ExceptionType::Filter, static_cast<int>(f_result), filter_result_to_str(f_result));
+    }
+  }
+  return BinanceError{};
+}
+
+template<typename Transport, typename Signer, typename Clock>
+Order BasicBinance<Transport, Signer, Clock>::create_order(OrderTemplate &order_template, const dec::decimal<8> &price, const dec::decimal<8> &quantity) {
+  return value_or_throw(try_create_order(order_template, price, quantity));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<Order> BasicBinance<Transport, Signer, Clock>::try_create_order(OrderTemplate &order_template, const dec::decimal<8> &price, const dec::decimal<8> &quantity) {
+  Order order{order_template.symbol(), 0, price, quantity, order_template.side(), OrderStatus::NEW, 0};
+  order.type = order_template.type();
+  BinanceError error{round_order(order)};
+  if (ExceptionType::None == error.type) {
+    error = admit_order();
+  }
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  urlparams params;
+  params.url_params = order_template.query(order.price, order.origQty, clock_policy.now_ms());
+  return call<endpoint::NewOrder>(order_template.header(), params);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+std::vector<Order> BasicBinance<Transport, Signer, Clock>::open_orders(const std::string &symbol) {
+  return value_or_throw(try_open_orders(symbol));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<std::vector<Order>> BasicBinance<Transport, Signer, Clock>::try_open_orders(const std::string &symbol) {
+  urlparams params;
+  params.add("symbol", symbol);
+  return orders_flight.run(flight_key("/api/v3/openOrders", params), [&]() {
+    return call<endpoint::OpenOrders>(params);
+  });
+}
+
+template<typename Transport, typename Signer, typename Clock>
+Order BasicBinance<Transport, Signer, Clock>::cancel_order(const std::string &symbol, const uint64_t &order_id) {
+  return value_or_throw(try_cancel_order(symbol, order_id));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<Order> BasicBinance<Transport, Signer, Clock>::try_cancel_order(const std::string &symbol, const uint64_t &order_id) {
+  urlparams params;
+  params.add("symbol", symbol);
+  params.add("orderId", order_id);
+  return call<endpoint::CancelOrder>(params);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+std::vector<Order> BasicBinance<Transport, Signer, Clock>::cancel_all(const std::string &symbol) {
+  return value_or_throw(try_cancel_all(symbol));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<std::vector<Order>> BasicBinance<Transport, Signer, Clock>::try_cancel_all(const std::string &symbol) {
+  urlparams params;
+  params.add("symbol", symbol);
+  return call<endpoint::CancelOpenOrders>(params);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+std::vector<CancelAllResult> BasicBinance<Transport, Signer, Clock>::cancel_all(std::span<const std::string> symbols, size_t max_parallel) {
+  std::vector<CancelAllResult> results(symbols.size());
+  workers.parallel_for(symbols.size(), max_parallel, [&](size_t i) {
+    results[i].symbol = symbols[i];
+    BinanceResult<std::vector<Order>> canceled{try_cancel_all(symbols[i])};
+    if (canceled.has_value()) {
+      results[i].orders = std::move(*canceled);
+    }
+    else {
+      results[i].error = canceled.error();
+    }
+  });
+  return results;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+std::vector<BinanceResult<Order>> BasicBinance<Transport, Signer, Clock>::create_orders(std::span<Order> orders, size_t max_parallel) {
+  std::vector<BinanceResult<Order>> results(orders.size());
+  workers.parallel_for(orders.size(), max_parallel, [&](size_t i) {
+    results[i] = try_create_order(orders[i]);
+  });
+  return results;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+CancelReplaceResult BasicBinance<Transport, Signer, Clock>::cancel_replace(const uint64_t &order_id, Order &order, CancelReplaceMode mode) {
+  return value_or_throw(try_cancel_replace(order_id, order, mode));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<CancelReplaceResult> BasicBinance<Transport, Signer, Clock>::try_cancel_replace(const uint64_t &order_id, Order &order, CancelReplaceMode mode) {
+  BinanceError error{round_order(order)};
+  if (ExceptionType::None == error.type) {
+    error = admit_order();
+  }
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  urlparams params;
+  order_params(order, [&params](const char *key, std::string_view value) { params.add(key, value); });
+  params.add("cancelReplaceMode", cancel_replace_mode_to_str(mode));
+  params.add("cancelOrderId", order_id);
+  params.add("newOrderRespType", std::string{"RESULT"});
+  return call<endpoint::CancelReplace>(params);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+AmendResult BasicBinance<Transport, Signer, Clock>::amend_order(const std::string &symbol, const uint64_t &order_id, const dec::decimal<8> &new_qty) {
+  return value_or_throw(try_amend_order(symbol, order_id, new_qty));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<AmendResult> BasicBinance<Transport, Signer, Clock>::try_amend_order(const std::string &symbol, const uint64_t &order_id, const dec::decimal<8> &new_qty) {
+  urlparams params;
+  params.add("symbol", symbol);
+  params.add("orderId", order_id);
+  params.add("newQty", new_qty);
+  return call<endpoint::AmendKeepPriority>(params);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+Order BasicBinance<Transport, Signer, Clock>::order_info(const std::string &symbol, const uint64_t &order_id) {
+  return value_or_throw(try_order_info(symbol, order_id));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<Order> BasicBinance<Transport, Signer, Clock>::try_order_info(const std::string &symbol, const uint64_t &order_id) {
+  urlparams params;
+  params.add("symbol", symbol);
+  params.add("orderId", order_id);
+  return order_flight.run(flight_key("/api/v3/order", params), [&]() {
+    return call<endpoint::QueryOrder>(params);
+  });
+}
+
+template<typename Transport, typename Signer, typename Clock>
+Commission BasicBinance<Transport, Signer, Clock>::order_commission(const std::string &symbol, const uint64_t &order_id) {
+  return value_or_throw(try_order_commission(symbol, order_id));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<Commission> BasicBinance<Transport, Signer, Clock>::try_order_commission(const std::string &symbol, const uint64_t &order_id) {
+  urlparams params;
+  params.add("symbol", symbol);
+  params.add("orderId", order_id);
+  return commission_flight.run(flight_key("/api/v3/myTrades", params), [&]() {
+    return call<endpoint::MyTrades>(params);
+  });
+}
+
+template<typename Transport, typename Signer, typename Clock>
+std::vector<Order> BasicBinance<Transport, Signer, Clock>::all_orders(const std::string &symbol) {
+  return value_or_throw(try_all_orders(symbol));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<std::vector<Order>> BasicBinance<Transport, Signer, Clock>::try_all_orders(const std::string &symbol) {
+  urlparams params;
+  params.add("symbol", symbol);
+  return orders_flight.run(flight_key("/api/v3/allOrders", params), [&]() {
+    return call<endpoint::AllOrders>(params);
+  });
+}
+
+template<typename Transport, typename Signer, typename Clock>
+void BasicBinance<Transport, Signer, Clock>::response_format(ResponseFormat format) {
+  sbe_format = (ResponseFormat::SBE == format);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+ResponseFormat BasicBinance<Transport, Signer, Clock>::response_format() const {
+  return sbe_format ? ResponseFormat::SBE : ResponseFormat::JSON;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+std::string BasicBinance<Transport, Signer, Clock>::create_listen_key() {
+  return value_or_throw(try_create_listen_key());
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<std::string> BasicBinance<Transport, Signer, Clock>::try_create_listen_key() {
+  return call<endpoint::UserStreamCreate>();
+}
+
+template<typename Transport, typename Signer, typename Clock>
+void BasicBinance<Transport, Signer, Clock>::keepalive_listen_key(const std::string &listen_key) {
+  value_or_throw(try_keepalive_listen_key(listen_key));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<void> BasicBinance<Transport, Signer, Clock>::try_keepalive_listen_key(const std::string &listen_key) {
+  urlparams params;
+  params.add("listenKey", listen_key);
+  BinanceResult<bool> result{call<endpoint::UserStreamKeepalive>(params)};
+  if (!result.has_value()) {
+    return std::unexpected(result.error());
+  }
+  return {};
+}
+
+template<typename Transport, typename Signer, typename Clock>
+void BasicBinance<Transport, Signer, Clock>::close_listen_key(const std::string &listen_key) {
+  value_or_throw(try_close_listen_key(listen_key));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<void> BasicBinance<Transport, Signer, Clock>::try_close_listen_key(const std::string &listen_key) {
+  urlparams params;
+  params.add("listenKey", listen_key);
+  BinanceResult<bool> result{call<endpoint::UserStreamClose>(params)};
+  if (!result.has_value()) {
+    return std::unexpected(result.error());
+  }
+  return {};
+}
+
+template<typename Transport, typename Signer, typename Clock>
+SingleFlightStats BasicBinance<Transport, Signer, Clock>::flight_stats() {
+  SingleFlightStats result{};
+  for (const SingleFlightStats &st : {ping_flight.stats(), time_flight.stats(), price_flight.stats(), prices_flight.stats(), balance_flight.stats(),
+                                      order_flight.stats(), orders_flight.stats(), commission_flight.stats(), depth_flight.stats()}) {
+    result.calls += st.calls;
+    result.executed += st.executed;
+    result.coalesced += st.coalesced;
+  }
+  return result;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+std::string BasicBinance<Transport, Signer, Clock>::flight_key(const std::string &path, const urlparams &u_params) {
+  return u_params.url_params.empty() ? path : std::format("{}?{}", path, u_params.url_params);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+void BasicBinance<Transport, Signer, Clock>::sign(headerparams &h_params, urlparams &u_params) {
+  h_params.add("X-MBX-APIKEY", auth_key.api_key);
+  u_params.add("recvWindow", 5000);
+  u_params.add("timestamp", clock_policy.now_ms());
+  u_params.add("signature", signer_policy.sign(auth_key.user_key, u_params.url_params));
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BinanceResult<RequestResult> BasicBinance<Transport, Signer, Clock>::negotiate(RequestType r_type, const std::string &path, const headerparams &h_params, const urlparams &u_params) {
+  if (!sbe_format) {
+    return transport_policy.request(r_type, path, h_params, u_params);
+  }
+  headerparams sbe_header{h_params};
+  for (auto &line : sbe_header.header_params) {
+    if (line.starts_with("Accept:")) {
+      line = std::format("Accept: {}", sbe_content_type);
+    }
+  }
+  sbe_header.add("X-MBX-SBE", sbe_schema_header());
+  RequestResult r_result = transport_policy.request(r_type, path, sbe_header, u_params);
+  if (0 != r_result.transport.code) {
+    return r_result;
+  }
+  if (is_sbe_response(r_result)) {
+    if (sbe_supported(r_result.body)) {
+      return r_result;
+    }
+    // Ответ другой схемы декодировать нельзя. Запрос уже выполнен сервером: повтор допустим только для GET,
+    // повтор ордера или отмены выставил бы второй ордер (или вернул ложную ошибку)
+    sbe_format = false;
+    if (RequestType::GET != r_type) {
+      return std::unexpected(BinanceError{ExceptionType::Server, r_result.header.code, ErrorMessage::INVALID_RESPONSE});
+    }
+    return transport_policy.request(r_type, path, h_params, u_params);
+  }
+  if ((400 == r_result.header.code) || (406 == r_result.header.code)) {
+    // Схема или версия не поддерживается сервером (ошибка заголовка X-MBX-SBE): запрос не выполнен, повтор в JSON безопасен
+    json js = json::parse(r_result.body, nullptr, false);
+    int code = js.is_object() ? js.value("code", 0) : 0;
+    if ((406 == r_result.header.code) || (-1152 == code) || (-1153 == code)) {
+      sbe_format = false;
+      return transport_policy.request(r_type, path, h_params, u_params);
+    }
+  }
+  return r_result;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+void BasicBinance<Transport, Signer, Clock>::check_error(const RequestResult &r_result) {
+  BinanceError error{response_error(r_result)};
+  if (ExceptionType::None != error.type) {
+    throw error.exception();
+  }
+}
+
+template<typename Transport, typename Signer, typename Clock>
+EndpointStats BasicBinance<Transport, Signer, Clock>::endpoint_stats(EndpointId id) {
+  EndpointStats result{};
+  size_t index = static_cast<size_t>(id);
+  if (index >= endpoint_count) {
+    return result;
+  }
+  const EndpointCounters &counters = endpoint_counters[index];
+  result.calls = counters.calls.load(std::memory_order_relaxed);
+  result.errors = counters.errors.load(std::memory_order_relaxed);
+  result.rejected = counters.rejected.load(std::memory_order_relaxed);
+  result.weight = counters.weight.load(std::memory_order_relaxed);
+  result.p50_ns = counters.latency.percentile(50.0);
+  result.p99_ns = counters.latency.percentile(99.0);
+  return result;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+uint64_t BasicBinance<Transport, Signer, Clock>::weight_used() const {
+  return weight_budget.weight_used();
+}
+
+template<typename Transport, typename Signer, typename Clock>
+void BasicBinance<Transport, Signer, Clock>::weight_limit(uint64_t limit) {
+  weight_budget.limit(limit);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+uint64_t BasicBinance<Transport, Signer, Clock>::orders_used() const {
+  return order_budget.weight_used();
+}
+
+template<typename Transport, typename Signer, typename Clock>
+void BasicBinance<Transport, Signer, Clock>::order_limit(uint64_t limit) {
+  order_budget.limit(limit);
+}
+
+template<typename Transport, typename Signer, typename Clock>
+Transport &BasicBinance<Transport, Signer, Clock>::transport() {
+  return transport_policy;
+}
+
+template<typename Transport, typename Signer, typename Clock>
+BasicBinance<Transport, Signer, Clock>::~BasicBinance() {}
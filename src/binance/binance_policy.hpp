@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+#include "../request/request.hpp"
+#include "../utils/utils.hpp"
+
+const std::string host{"https://api.binance.com"};
+const int port{443};
+
+// Политики клиента BasicBinance<Transport, Signer, Clock>. Вызываются напрямую (без виртуальных функций),
+// поэтому своя политика встраивается в путь запроса так же, как политика по умолчанию.
+// Методы политик вызываются из нескольких потоков одновременно (create_orders, cancel_all) и должны быть потокобезопасны.
+
+/// @brief Транспорт по умолчанию: HTTPS через Request (libcurl).
+/// Request на каждый вызов переиспользует общий кэш keep-alive соединений и TLS сессий.
+/// Требование к транспорту: RequestResult request(RequestType, const std::string &path, const headerparams &, const urlparams &)
+struct RestTransport {
+  RequestResult request(RequestType r_type, const std::string &path, const headerparams &h_params, const urlparams &u_params) {
+    Request request{host, port};
+    return request.request(r_type, path, h_params, u_params);
+  }
+};
+
+/// @brief Подпись по умолчанию: HMAC SHA256 строки запроса секретным ключом (hex).
+/// Требование к подписи: std::string sign(const std::string &key, const std::string &payload)
+struct HmacSigner {
+  std::string sign(const std::string &key, const std::string &payload) const {
+    return hmac_sha256(key.c_str(), payload.c_str());
+  }
+};
+
+/// @brief Часы по умолчанию: системное время (мс с начала эпохи).
+/// Требование к часам: uint64_t now_ms() - время для timestamp запросов, окна бюджета веса и смещения времени сервера
+struct SystemClock {
+  uint64_t now_ms() const {
+    return current_ms_epoch();
+  }
+};
@@ -1,35 +1,37 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <numeric>
 
 #include "../utils/decimal.hpp"
+#include "../utils/enum_table.hpp"
 
 enum class ExceptionType {
   None = 0,
   Transport = 1,
   Server = 2,
   Binance = 3,
+  Filter = 4,
 };
 
+inline constexpr auto exception_type_names = make_enum_table<ExceptionType>({
+  {ExceptionType::None, "None"},
+  {ExceptionType::Transport, "Transport"},
+  {ExceptionType::Server, "Server"},
+  {ExceptionType::Binance, "Binance"},
+  {ExceptionType::Filter, "Filter"}
+});
+
 struct BinanceException {
 ExceptionType e_type{ExceptionType::None};
 int e_code{0};
 std::string e_msg{};
-std::string e_type_str() {
-  std::map<ExceptionType, std::string> err_m {
-      {ExceptionType::None, std::string{"None"}},
-      {ExceptionType::Transport, std::string{"Transport"}},
-      {ExceptionType::Server, std::string{"Server"}},
-      {ExceptionType::Binance, std::string{"Binance"}}
-    };
-    if (err_m.find(e_type) != err_m.end()) {
-      return err_m[e_type];
-    }
-    else {
-      return std::string{"NONE"};
-    }
+std::string_view e_type_str() const {
+  return exception_type_names.to_str(e_type, "NONE");
 }
 };
 
@@ -48,7 +50,31 @@ enum class OrderStatus {
   NONE = 0,
   NEW = 1,
   FILLED = 2,
-  CANCELED = 3
+  CANCELED = 3,
+  PARTIALLY_FILLED = 4,
+  REJECTED = 5,
+  EXPIRED = 6,
+  PENDING_NEW = 7,
+  PENDING_CANCEL = 8,
+  EXPIRED_IN_MATCH = 9
+};
+
+enum class OrderType {
+  NONE = 0,
+  LIMIT = 1,
+  MARKET = 2,
+  LIMIT_MAKER = 3,
+  STOP_LOSS = 4,
+  STOP_LOSS_LIMIT = 5,
+  TAKE_PROFIT = 6,
+  TAKE_PROFIT_LIMIT = 7
+};
+
+enum class TimeInForce {
+  NONE = 0,
+  GTC = 1,
+  IOC = 2,
+  FOK = 3
 };
 
 struct BalanceData {
@@ -123,70 +149,255 @@ struct Commission {
   }
 };
 
+/// @brief Таблица цен: непрерывный массив цен и индекс торговых пар
+struct PriceTable {
+  std::vector<std::string> symbols; // Торговые пары (в порядке ответа сервера)
+  std::vector<dec::decimal<8>> prices; // Цены (prices[i] - цена symbols[i])
+  std::vector<uint32_t> index; // Позиции symbols, отсортированные по названию пары
+
+  dec::decimal<8> operator [] (std::string_view symbol) const {
+    return this->get(symbol);
+  };
+
+  void reserve(size_t count) {
+    this->symbols.reserve(count);
+    this->prices.reserve(count);
+  }
+
+  void add(std::string_view symbol, dec::decimal<8> price) {
+    this->symbols.emplace_back(symbol);
+    this->prices.push_back(price);
+  }
+
+  void build_index() {
+    this->index.resize(this->symbols.size());
+    std::iota(this->index.begin(), this->index.end(), 0);
+    std::sort(this->index.begin(), this->index.end(), [this](uint32_t a, uint32_t b) {
+      return this->symbols[a] < this->symbols[b];
+    });
+  }
+
+  /// @brief Позиция пары в таблице (-1 - пара не найдена)
+  int64_t find(std::string_view symbol) const {
+    auto it = std::lower_bound(this->index.begin(), this->index.end(), symbol, [this](uint32_t pos, std::string_view sym) {
+      return std::string_view(this->symbols[pos]) < sym;
+    });
+    if ((it != this->index.end()) && (this->symbols[*it] == symbol)) {
+      return *it;
+    }
+    return -1;
+  }
+
+  bool contains(std::string_view symbol) const {
+    return 0 <= this->find(symbol);
+  }
+
+  dec::decimal<8> get(std::string_view symbol) const {
+    int64_t pos = this->find(symbol);
+    return (0 <= pos) ? this->prices[pos] : dec::decimal<8>("0.00000000");
+  }
+
+  size_t size() const {
+    return this->symbols.size();
+  }
+
+  void clear() {
+    this->symbols.clear();
+    this->prices.clear();
+    this->index.clear();
+  }
+};
+
+/// @brief Сделка по ордеру (ответ newOrderRespType=FULL)
+struct Fill {
+  dec::decimal<8> price{};
+  dec::decimal<8> qty{};
+  dec::decimal<8> commission{};
+  std::string commissionAsset{};
+  uint64_t tradeId{0};
+};
+
 struct Order {
   std::string symbol{};
   uint64_t orderId{0};
-  dec::decimal<8> price{"0.00000000"};
-  dec::decimal<8> origQty{"0.00000000"};
+  dec::decimal<8> price{};
+  dec::decimal<8> origQty{};
   Side side{Side::NONE};
   OrderStatus status{OrderStatus::NONE};
   uint64_t time{0};
+  OrderType type{OrderType::LIMIT};
+  TimeInForce timeInForce{TimeInForce::GTC}; // Только для LIMIT, STOP_LOSS_LIMIT, TAKE_PROFIT_LIMIT
+  dec::decimal<8> stopPrice{}; // Только для STOP_LOSS*, TAKE_PROFIT*
+  dec::decimal<8> quoteOrderQty{}; // MARKET на сумму в котируемой валюте (origQty = 0)
+  std::vector<Fill> fills{}; // Только для newOrderRespType=FULL
 };
 
-static std::string side_to_str(Side side) {
-  std::map<Side, std::string> side_m {
-      {Side::NONE, std::string{"NONE"}},
-      {Side::BUY, std::string{"BUY"}},
-      {Side::SELL, std::string{"SELL"}}
-  };
-  if (side_m.find(side) != side_m.end()) {
-    return side_m[side];
-  }
-  else {
-    return std::string{"NONE"};
-  }
+/// @brief Бюджет новых ордеров (лимит ORDERS: 50 ордеров за 10 секунд), отсчитывается клиентом и сессией
+const size_t order_burst_limit{50};
+/// @brief Окно лимита ORDERS (мс)
+const uint64_t order_burst_window_ms{10000};
+
+/// @brief Подтверждение приема ордера (ответ newOrderRespType=ACK)
+struct OrderAck {
+  std::string symbol{};
+  uint64_t orderId{0};
+  std::string clientOrderId{};
+  uint64_t transactTime{0};
+};
+
+/// @brief Состав ответа на создание ордера
+enum class OrderRespType {
+  NONE = 0,
+  ACK = 1, // orderId, clientOrderId, transactTime
+  RESULT = 2, // + цена, количество, статус
+  FULL = 3 // + сделки (fills)
+};
+
+inline constexpr auto order_resp_type_names = make_enum_table<OrderRespType>({
+  {OrderRespType::ACK, "ACK"},
+  {OrderRespType::RESULT, "RESULT"},
+  {OrderRespType::FULL, "FULL"}
+});
+
+static constexpr std::string_view order_resp_type_to_str(OrderRespType resp_type) {
+  return order_resp_type_names.to_str(resp_type, "RESULT");
 }
 
-static Side str_to_side(std::string side) {
-  std::map<std::string, Side> side_m {
-    {std::string{"NONE"}, Side::NONE},
-    {std::string{"BUY"}, Side::BUY},
-    {std::string{"SELL"}, Side::SELL}
-  };
-  if (side_m.find(side) != side_m.end()) {
-    return side_m[side];
-  }
-  else {
-    return Side::NONE;
-  }
+static constexpr OrderRespType str_to_order_resp_type(std::string_view resp_type) {
+  return order_resp_type_names.from_str(resp_type, OrderRespType::NONE);
 }
 
-static std::string order_status_to_str(OrderStatus status) {
-  std::map<OrderStatus, std::string> status_m {
-    {OrderStatus::NONE, std::string{"NONE"}},
-    {OrderStatus::NEW, std::string{"NEW"}},
-    {OrderStatus::FILLED, std::string{"FILLED"}},
-    {OrderStatus::CANCELED, std::string{"CANCELED"}}
-  };
-  if (status_m.find(status) != status_m.end()) {
-    return status_m[status];
-  }
-  else {
-    return std::string{"NONE"};
-  }
+inline constexpr auto side_names = make_enum_table<Side>({
+  {Side::NONE, "NONE"},
+  {Side::BUY, "BUY"},
+  {Side::SELL, "SELL"}
+});
+
+static constexpr std::string_view side_to_str(Side side) {
+  return side_names.to_str(side, "NONE");
 }
 
-static OrderStatus str_to_order_status(std::string status) {
-  std::map<std::string, OrderStatus> status_m {
-    {std::string{"NONE"}, OrderStatus::NONE},
-    {std::string{"NEW"}, OrderStatus::NEW},
-    {std::string{"FILLED"}, OrderStatus::FILLED},
-    {std::string{"CANCELED"}, OrderStatus::CANCELED}
-  };
-  if (status_m.find(status) != status_m.end()) {
-    return status_m[status];
-  }
-  else {
-    return OrderStatus::NONE;
-  }
-}
\ No newline at end of file
+static constexpr Side str_to_side(std::string_view side) {
+  return side_names.from_str(side, Side::NONE);
+}
+
+inline constexpr auto order_status_names = make_enum_table<OrderStatus>({
+  {OrderStatus::NONE, "NONE"},
+  {OrderStatus::NEW, "NEW"},
+  {OrderStatus::FILLED, "FILLED"},
+  {OrderStatus::CANCELED, "CANCELED"},
+  {OrderStatus::PARTIALLY_FILLED, "PARTIALLY_FILLED"},
+  {OrderStatus::REJECTED, "REJECTED"},
+  {OrderStatus::EXPIRED, "EXPIRED"},
+  {OrderStatus::PENDING_NEW, "PENDING_NEW"},
+  {OrderStatus::PENDING_CANCEL, "PENDING_CANCEL"},
+  {OrderStatus::EXPIRED_IN_MATCH, "EXPIRED_IN_MATCH"}
+});
+
+static constexpr std::string_view order_status_to_str(OrderStatus status) {
+  return order_status_names.to_str(status, "NONE");
+}
+
+static constexpr OrderStatus str_to_order_status(std::string_view status) {
+  return order_status_names.from_str(status, OrderStatus::NONE);
+}
+
+inline constexpr auto order_type_names = make_enum_table<OrderType>({
+  {OrderType::LIMIT, "LIMIT"},
+  {OrderType::MARKET, "MARKET"},
+  {OrderType::LIMIT_MAKER, "LIMIT_MAKER"},
+  {OrderType::STOP_LOSS, "STOP_LOSS"},
+  {OrderType::STOP_LOSS_LIMIT, "STOP_LOSS_LIMIT"},
+  {OrderType::TAKE_PROFIT, "TAKE_PROFIT"},
+  {OrderType::TAKE_PROFIT_LIMIT, "TAKE_PROFIT_LIMIT"}
+});
+
+static constexpr std::string_view order_type_to_str(OrderType type) {
+  return order_type_names.to_str(type, "NONE");
+}
+
+static constexpr OrderType str_to_order_type(std::string_view type) {
+  return order_type_names.from_str(type, OrderType::NONE);
+}
+
+inline constexpr auto time_in_force_names = make_enum_table<TimeInForce>({
+  {TimeInForce::GTC, "GTC"},
+  {TimeInForce::IOC, "IOC"},
+  {TimeInForce::FOK, "FOK"}
+});
+
+static constexpr std::string_view time_in_force_to_str(TimeInForce tif) {
+  return time_in_force_names.to_str(tif, "NONE");
+}
+
+static constexpr TimeInForce str_to_time_in_force(std::string_view tif) {
+  return time_in_force_names.from_str(tif, TimeInForce::NONE);
+}
+
+/// @brief Тип ордера передает цену (price)
+static constexpr bool order_type_has_price(OrderType type) {
+  return (OrderType::LIMIT == type) || (OrderType::LIMIT_MAKER == type) ||
+         (OrderType::STOP_LOSS_LIMIT == type) || (OrderType::TAKE_PROFIT_LIMIT == type);
+}
+
+/// @brief Тип ордера передает стоп-цену (stopPrice)
+static constexpr bool order_type_has_stop_price(OrderType type) {
+  return (OrderType::STOP_LOSS == type) || (OrderType::STOP_LOSS_LIMIT == type) ||
+         (OrderType::TAKE_PROFIT == type) || (OrderType::TAKE_PROFIT_LIMIT == type);
+}
+
+/// @brief Тип ордера передает timeInForce
+static constexpr bool order_type_has_time_in_force(OrderType type) {
+  return (OrderType::LIMIT == type) || (OrderType::STOP_LOSS_LIMIT == type) || (OrderType::TAKE_PROFIT_LIMIT == type);
+}
+/// @brief Режим cancelReplace: при ошибке отмены новый ордер не создается (STOP_ON_FAILURE) или создается (ALLOW_FAILURE)
+enum class CancelReplaceMode {
+  STOP_ON_FAILURE = 0,
+  ALLOW_FAILURE = 1
+};
+
+/// @brief Результат одной части (отмена или новый ордер) cancelReplace
+enum class LegResult {
+  NONE = 0,
+  SUCCESS = 1,
+  FAILURE = 2,
+  NOT_ATTEMPTED = 3
+};
+
+inline constexpr auto cancel_replace_mode_names = make_enum_table<CancelReplaceMode>({
+  {CancelReplaceMode::STOP_ON_FAILURE, "STOP_ON_FAILURE"},
+  {CancelReplaceMode::ALLOW_FAILURE, "ALLOW_FAILURE"}
+});
+
+static constexpr std::string_view cancel_replace_mode_to_str(CancelReplaceMode mode) {
+  return cancel_replace_mode_names.to_str(mode, "STOP_ON_FAILURE");
+}
+
+inline constexpr auto leg_result_names = make_enum_table<LegResult>({
+  {LegResult::SUCCESS, "SUCCESS"},
+  {LegResult::FAILURE, "FAILURE"},
+  {LegResult::NOT_ATTEMPTED, "NOT_ATTEMPTED"}
+});
+
+static constexpr LegResult str_to_leg_result(std::string_view result) {
+  return leg_result_names.from_str(result, LegResult::NONE);
+}
+
+/// @brief Результат отмены и создания ордера одним запросом (cancelReplace)
+struct CancelReplaceResult {
+  LegResult cancel_result{LegResult::NONE};
+  LegResult new_order_result{LegResult::NONE};
+  Order canceled{}; // Отмененный ордер (cancel_result == SUCCESS)
+  Order created{}; // Новый ордер (new_order_result == SUCCESS)
+  int cancel_code{0}; // Ошибка отмены (cancel_result == FAILURE)
+  std::string cancel_msg{};
+  int new_order_code{0}; // Ошибка создания (new_order_result == FAILURE)
+  std::string new_order_msg{};
+};
+
+/// @brief Результат уменьшения количества ордера с сохранением приоритета (amend/keepPriority)
+struct AmendResult {
+  uint64_t transact_time{0};
+  uint64_t execution_id{0};
+  Order order{}; // Ордер после изменения (origQty - новое количество)
+};
@@ -0,0 +1,254 @@
+#include "decoder.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+
+/// @brief SAX обработчик ответа /api/v3/ticker/price
+class PriceTableSax : public nlohmann::json_sax<json> {
+private:
+  PriceTable &table;
+  std::string key_name{};
+  std::string symbol{};
+  int64_t unbiased{0};
+  dec::decimal<8> price{};
+  bool has_symbol{false};
+  bool has_price{false};
+public:
+  PriceTableSax(PriceTable &table) : table(table) {}
+  bool null() override { return true; }
+  bool boolean(bool) override { return true; }
+  bool number_integer(number_integer_t) override { return true; }
+  bool number_unsigned(number_unsigned_t) override { return true; }
+  bool number_float(number_float_t, const string_t&) override { return true; }
+  bool binary(binary_t&) override { return true; }
+  bool string(string_t &val) override {
+    if ("symbol" == key_name) {
+      symbol = val;
+      has_symbol = true;
+    }
+    else if ("price" == key_name) {
+      has_price = str_to_fixed<8>(val, unbiased);
+    }
+    return true;
+  }
+  bool start_object(std::size_t) override {
+    has_symbol = false;
+    has_price = false;
+    return true;
+  }
+  bool key(string_t &val) override {
+    key_name = val;
+    return true;
+  }
+  bool end_object() override {
+    if (has_symbol && has_price) {
+      price.setUnbiased(unbiased);
+      table.add(symbol, price);
+    }
+    has_symbol = false;
+    has_price = false;
+    return true;
+  }
+  bool start_array(std::size_t elements) override {
+    if (static_cast<std::size_t>(-1) != elements) {
+      table.reserve(elements);
+    }
+    return true;
+  }
+  bool end_array() override { return true; }
+  bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override { return false; }
+};
+
+/// @brief Строковое числовое поле объекта в единицах 1e-8 (0 - поля нет)
+int64_t json_fixed(const json &js, const char *key) {
+  int64_t value{0};
+  if (js.contains(key) && js[key].is_string()) {
+    str_to_fixed<8>(js[key].get_ref<const std::string&>(), value);
+  }
+  return value;
+}
+
+}
+
+bool decode_price_table(const std::string &body, PriceTable &table) {
+  table.clear();
+  PriceTableSax sax{table};
+  if (!json::sax_parse(body, &sax)) {
+    table.clear();
+    return false;
+  }
+  table.build_index();
+  return true;
+}
+
+bool decode_exchange_info(const std::string &body, ExchangeInfo &info) {
+  json js = json::parse(body, nullptr, false);
+  if (js.is_discarded() || !js.contains("symbols") || !js["symbols"].is_array()) {
+    return false;
+  }
+  for (auto &js_symbol : js["symbols"]) {
+    SymbolFilters f{};
+    f.symbol = js_symbol.value("symbol", std::string{});
+    if (!js_symbol.contains("filters")) {
+      info.add(f);
+      continue;
+    }
+    for (auto &js_filter : js_symbol["filters"]) {
+      std::string type{js_filter.value("filterType", std::string{})};
+      if ("PRICE_FILTER" == type) {
+        f.min_price = json_fixed(js_filter, "minPrice");
+        f.max_price = json_fixed(js_filter, "maxPrice");
+        f.tick_size = json_fixed(js_filter, "tickSize");
+      }
+      else if ("LOT_SIZE" == type) {
+        f.min_qty = json_fixed(js_filter, "minQty");
+        f.max_qty = json_fixed(js_filter, "maxQty");
+        f.step_size = json_fixed(js_filter, "stepSize");
+      }
+      else if ("MIN_NOTIONAL" == type) {
+        f.min_notional = json_fixed(js_filter, "minNotional");
+      }
+      else if ("NOTIONAL" == type) {
+        f.min_notional = json_fixed(js_filter, "minNotional");
+        f.max_notional = json_fixed(js_filter, "maxNotional");
+      }
+      else if ("PERCENT_PRICE" == type) {
+        f.bid_mult_up = f.ask_mult_up = json_fixed(js_filter, "multiplierUp");
+        f.bid_mult_down = f.ask_mult_down = json_fixed(js_filter, "multiplierDown");
+      }
+      else if ("PERCENT_PRICE_BY_SIDE" == type) {
+        f.bid_mult_up = json_fixed(js_filter, "bidMultiplierUp");
+        f.bid_mult_down = json_fixed(js_filter, "bidMultiplierDown");
+        f.ask_mult_up = json_fixed(js_filter, "askMultiplierUp");
+        f.ask_mult_down = json_fixed(js_filter, "askMultiplierDown");
+      }
+    }
+    info.add(f);
+  }
+  return true;
+}
+
+bool decode_order_ack(std::string_view body, OrderAck &ack) {
+  ack = OrderAck{};
+  JsonScanner scanner{body};
+  std::string_view key{};
+  std::string_view value{};
+  while (scanner.next(key, value)) {
+    if ("symbol" == key) {
+      ack.symbol = value;
+    }
+    else if ("orderId" == key) {
+      ack.orderId = json_to_u64(value);
+    }
+    else if ("clientOrderId" == key) {
+      ack.clientOrderId = value;
+    }
+    else if ("transactTime" == key) {
+      ack.transactTime = json_to_u64(value);
+    }
+  }
+  return 0 != ack.orderId;
+}
+
+bool decode_fills(std::string_view array, std::vector<Fill> &fills) {
+  fills.clear();
+  JsonScanner elements{array};
+  std::string_view object{};
+  while (elements.next(object)) {
+    Fill fill{};
+    JsonScanner scanner{object};
+    std::string_view key{};
+    std::string_view value{};
+    while (scanner.next(key, value)) {
+      if ("price" == key) {
+        fill.price = str_to_decimal<8>(value);
+      }
+      else if ("qty" == key) {
+        fill.qty = str_to_decimal<8>(value);
+      }
+      else if ("commission" == key) {
+        fill.commission = str_to_decimal<8>(value);
+      }
+      else if ("commissionAsset" == key) {
+        fill.commissionAsset = value;
+      }
+      else if ("tradeId" == key) {
+        fill.tradeId = json_to_u64(value);
+      }
+    }
+    fills.push_back(std::move(fill));
+  }
+  return !array.empty() && ('[' == array.front());
+}
+
+bool decode_error(std::string_view body, int &code, std::string_view &msg) {
+  JsonScanner scanner{body};
+  std::string_view key{};
+  std::string_view value{};
+  bool has_code{false};
+  bool has_msg{false};
+  while (scanner.next(key, value)) {
+    if ("code" == key) {
+      has_code = (std::errc{} == std::from_chars(value.data(), value.data() + value.size(), code).ec);
+    }
+    else if ("msg" == key) {
+      msg = value;
+      has_msg = true;
+    }
+  }
+  return has_code && has_msg;
+}
+
+Order json_to_order(const json &js_order) {
+  Order order;
+  order.symbol = js_order.value("symbol", std::string{});
+  order.orderId = js_order.value("orderId", uint64_t{});
+  order.price = dec::decimal<8>(js_order.value("price", std::string{}));
+  order.origQty = dec::decimal<8>(js_order.value("origQty", std::string{}));
+  order.side = str_to_side(js_order.value("side", std::string{}));
+  order.status = str_to_order_status(js_order.value("status", std::string{}));
+  order.type = str_to_order_type(js_order.value("type", std::string{"LIMIT"}));
+  order.timeInForce = str_to_time_in_force(js_order.value("timeInForce", std::string{}));
+  if (js_order.contains("stopPrice")) {
+    order.stopPrice = dec::decimal<8>(js_order.value("stopPrice", std::string{}));
+  }
+  if (js_order.contains("time")) {
+    order.time = js_order.value("time", uint64_t{});
+  }
+  else if (js_order.contains("transactTime")) {
+    order.time = js_order.value("transactTime", uint64_t{});
+  }
+  else {
+    order.time = 0;
+  }
+  return order;
+}
+
+CancelReplaceResult json_to_cancel_replace(const json &js_result) {
+  CancelReplaceResult result{};
+  result.cancel_result = str_to_leg_result(js_result.value("cancelResult", std::string{}));
+  result.new_order_result = str_to_leg_result(js_result.value("newOrderResult", std::string{}));
+  // Часть завершилась ошибкой - вместо ордера объект {"code", "msg"}
+  if (js_result.contains("cancelResponse") && js_result["cancelResponse"].is_object()) {
+    const json &js_cancel = js_result["cancelResponse"];
+    if (js_cancel.contains("code")) {
+      result.cancel_code = js_cancel.value("code", 0);
+      result.cancel_msg = js_cancel.value("msg", std::string{});
+    }
+    else {
+      result.canceled = json_to_order(js_cancel);
+    }
+  }
+  if (js_result.contains("newOrderResponse") && js_result["newOrderResponse"].is_object()) {
+    const json &js_order = js_result["newOrderResponse"];
+    if (js_order.contains("code")) {
+      result.new_order_code = js_order.value("code", 0);
+      result.new_order_msg = js_order.value("msg", std::string{});
+    }
+    else {
+      result.created = json_to_order(js_order);
+    }
+  }
+  return result;
+}
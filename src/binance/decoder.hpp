@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "./binance_type.hpp"
+#include "./exchange_info.hpp"
+#include "../utils/json.hpp"
+#include "../utils/fast_decimal.hpp"
+#include "../stream/json_scan.hpp"
+
+/// @brief Разбор ответа /api/v3/ticker/price (объект или массив объектов) в таблицу цен.
+/// Разбор выполняется SAX парсером без построения JSON DOM и без исключений.
+/// @param body Тело ответа сервера
+/// @param table Таблица цен (результат, индекс построен)
+/// @return True - успех; False - ответ не является корректным JSON
+bool decode_price_table(const std::string &body, PriceTable &table);
+
+/// @brief Разбор ответа /api/v3/exchangeInfo в таблицу фильтров торговых пар (без исключений)
+/// @param body Тело ответа сервера
+/// @param info Таблица фильтров (результат)
+/// @return True - успех; False - ответ не является корректным JSON
+bool decode_exchange_info(const std::string &body, ExchangeInfo &info);
+
+/// @brief Разбор ответа newOrderRespType=ACK: только symbol, orderId, clientOrderId, transactTime
+/// (последовательный проход по полям верхнего уровня, без JSON DOM)
+/// @param body Тело ответа (JSON объект)
+/// @param ack Подтверждение (результат)
+/// @return True - успех; False - orderId не найден
+bool decode_order_ack(std::string_view body, OrderAck &ack);
+
+/// @brief Разбор массива fills ответа newOrderRespType=FULL
+/// @param array JSON массив fills
+/// @param fills Сделки (результат)
+/// @return True - успех; False - массив не является корректным
+bool decode_fills(std::string_view array, std::vector<Fill> &fills);
+
+/// @brief Разбор тела ошибки {"code": -2010, "msg": "..."} без JSON DOM и без исключений
+/// @param body Тело ответа
+/// @param code Код ошибки Binance (результат)
+/// @param msg Текст ошибки (результат, ссылается на body; escape-последовательности не раскрываются)
+/// @return True - успех; False - тело не является ошибкой Binance
+bool decode_error(std::string_view body, int &code, std::string_view &msg);
+
+/// @brief Ордер из JSON объекта ответа (время - time или transactTime)
+/// @param js_order JSON объект ордера
+/// @return - Ордер
+Order json_to_order(const nlohmann::json &js_order);
+
+/// @brief Результат cancelReplace из JSON объекта (ответ или "data" частичного отказа)
+/// @param js_result JSON объект
+/// @return - Результаты обеих частей
+CancelReplaceResult json_to_cancel_replace(const nlohmann::json &js_result);
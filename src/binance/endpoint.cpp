@@ -0,0 +1,350 @@
+#include "endpoint.hpp"
+#include "decoder.hpp"
+#include "sbe.hpp"
+
+using json = nlohmann::json;
+
+BinanceError response_error(const RequestResult &r_result) {
+  if (0 != r_result.transport.code) {
+    return make_error(ExceptionType::Transport, r_result.transport.code, r_result.transport.msg);
+  }
+  else if (200 == r_result.header.code) {
+    return BinanceError{};
+  }
+  int code{0};
+  if (is_sbe_response(r_result)) {
+    std::string msg{};
+    if (sbe_decode_error(r_result.body, code, msg)) {
+      return make_error(ExceptionType::Binance, code, msg);
+    }
+    return make_error(ExceptionType::Server, r_result.header.code, r_result.header.msg);
+  }
+  std::string_view msg{};
+  if (decode_error(r_result.body, code, msg)) {
+    return make_error(ExceptionType::Binance, code, msg);
+  }
+  // Тело не JSON (страница прокси, обрыв) - ошибка транспорта, JSON без code/msg - ошибка сервера
+  ExceptionType type = json::accept(r_result.body) ? ExceptionType::Server : ExceptionType::Transport;
+  return make_error(type, r_result.header.code, r_result.header.msg);
+}
+
+bool is_sbe_response(const RequestResult &r_result) {
+  return r_result.content_type.starts_with(sbe_content_type);
+}
+
+namespace {
+
+BinanceError invalid_response(const RequestResult &r_result) {
+  return BinanceError{ExceptionType::Server, r_result.header.code, ErrorMessage::INVALID_RESPONSE};
+}
+
+/// @brief Ошибка ответа или JSON DOM тела
+BinanceResult<json> json_body(const RequestResult &r_result) {
+  BinanceError error{response_error(r_result)};
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  json js = json::parse(r_result.body, nullptr, false);
+  if (js.is_discarded()) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  return js;
+}
+
+/// @brief Ответ без данных: только проверка ошибки
+BinanceResult<bool> empty_body(const RequestResult &r_result) {
+  BinanceError error{response_error(r_result)};
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  return true;
+}
+
+BinanceResult<Order> decode_order(const RequestResult &r_result) {
+  BinanceError error{response_error(r_result)};
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  if (is_sbe_response(r_result)) {
+    Order order{};
+    if (!sbe_decode_order(r_result.body, order)) {
+      return std::unexpected(invalid_response(r_result));
+    }
+    return order;
+  }
+  json js = json::parse(r_result.body, nullptr, false);
+  if (!js.is_object()) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  return json_to_order(js);
+}
+
+BinanceResult<std::vector<Order>> decode_orders(const RequestResult &r_result) {
+  BinanceError error{response_error(r_result)};
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  std::vector<Order> orders{};
+  if (is_sbe_response(r_result)) {
+    if (!sbe_decode_orders(r_result.body, orders)) {
+      return std::unexpected(invalid_response(r_result));
+    }
+    return orders;
+  }
+  json js = json::parse(r_result.body, nullptr, false);
+  if (!js.is_array()) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  for (auto &js_order : js) {
+    orders.push_back(json_to_order(js_order));
+  }
+  return orders;
+}
+
+}
+
+namespace endpoint {
+
+BinanceResult<bool> Ping::decode(const RequestResult &r_result) {
+  return empty_body(r_result);
+}
+
+BinanceResult<uint64_t> Time::decode(const RequestResult &r_result) {
+  uint64_t time{0};
+  if (is_sbe_response(r_result) && (ExceptionType::None == response_error(r_result).type)) {
+    if (!sbe_decode_server_time(r_result.body, time)) {
+      return std::unexpected(invalid_response(r_result));
+    }
+    return time;
+  }
+  BinanceResult<json> js = json_body(r_result);
+  if (!js.has_value()) {
+    return std::unexpected(js.error());
+  }
+  return js->is_object() ? js->value("serverTime", uint64_t{}) : uint64_t{};
+}
+
+BinanceResult<dec::decimal<8>> TickerPrice::decode(const RequestResult &r_result) {
+  dec::decimal<8> price{};
+  if (is_sbe_response(r_result) && (ExceptionType::None == response_error(r_result).type)) {
+    if (!sbe_decode_price(r_result.body, price)) {
+      return std::unexpected(invalid_response(r_result));
+    }
+    return price;
+  }
+  BinanceResult<json> js = json_body(r_result);
+  if (!js.has_value()) {
+    return std::unexpected(js.error());
+  }
+  if (!js->is_object()) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  return dec::decimal<8>(js->value("price", std::string{}));
+}
+
+BinanceResult<PriceTable> TickerPrices::decode(const RequestResult &r_result) {
+  BinanceError error{response_error(r_result)};
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  PriceTable table{};
+  bool decoded = is_sbe_response(r_result) ? sbe_decode_price_table(r_result.body, table) : decode_price_table(r_result.body, table);
+  if (!decoded) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  return table;
+}
+
+BinanceResult<DepthSnapshot> Depth::decode(const RequestResult &r_result) {
+  BinanceError error{response_error(r_result)};
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  DepthSnapshot snapshot{};
+  if (!decode_depth_snapshot(r_result.body, snapshot)) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  return snapshot;
+}
+
+BinanceResult<std::shared_ptr<const ::ExchangeInfo>> ExchangeInfo::decode(const RequestResult &r_result) {
+  BinanceError error{response_error(r_result)};
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  auto result = std::make_shared<::ExchangeInfo>();
+  if (!decode_exchange_info(r_result.body, *result)) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  return std::shared_ptr<const ::ExchangeInfo>(result);
+}
+
+BinanceResult<Balance> Account::decode(const RequestResult &r_result) {
+  Balance balance{};
+  if (is_sbe_response(r_result) && (ExceptionType::None == response_error(r_result).type)) {
+    if (!sbe_decode_balance(r_result.body, balance)) {
+      return std::unexpected(invalid_response(r_result));
+    }
+    return balance;
+  }
+  BinanceResult<json> js = json_body(r_result);
+  if (!js.has_value()) {
+    return std::unexpected(js.error());
+  }
+  if (!js->is_object() || !js->contains("balances")) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  for(auto &array : (*js)["balances"]) {
+    balance.set(array.value("asset", std::string{}), array.value("free", std::string{}), array.value("locked", std::string{}));
+  }
+  return balance;
+}
+
+BinanceResult<Order> NewOrder::decode(const RequestResult &r_result) {
+  return decode_order(r_result);
+}
+
+BinanceResult<OrderAck> NewOrderAck::decode(const RequestResult &r_result) {
+  BinanceError error{response_error(r_result)};
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  OrderAck ack{};
+  bool decoded = is_sbe_response(r_result) ? sbe_decode_order_ack(r_result.body, ack) : decode_order_ack(r_result.body, ack);
+  if (!decoded) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  return ack;
+}
+
+BinanceResult<Order> NewOrderFull::decode(const RequestResult &r_result) {
+  BinanceResult<json> js = json_body(r_result);
+  if (!js.has_value()) {
+    return std::unexpected(js.error());
+  }
+  if (!js->is_object()) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  Order result{json_to_order(*js)};
+  // Сделки - тем же разбором без JSON DOM, что и в OrderSession
+  std::string_view fills{};
+  if (JsonScanner::find(r_result.body, "fills", fills) && !decode_fills(fills, result.fills)) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  return result;
+}
+
+BinanceResult<bool> TestOrder::decode(const RequestResult &r_result) {
+  return empty_body(r_result);
+}
+
+BinanceResult<std::vector<Order>> OpenOrders::decode(const RequestResult &r_result) {
+  return decode_orders(r_result);
+}
+
+BinanceResult<Order> CancelOrder::decode(const RequestResult &r_result) {
+  return decode_order(r_result);
+}
+
+BinanceResult<std::vector<Order>> CancelOpenOrders::decode(const RequestResult &r_result) {
+  std::vector<Order> orders{};
+  BinanceResult<json> js = json_body(r_result);
+  if (!js.has_value()) {
+    // -2011 (Unknown order sent) - открытых ордеров нет
+    if ((ExceptionType::Binance == js.error().type) && (-2011 == js.error().code)) {
+      return orders;
+    }
+    return std::unexpected(js.error());
+  }
+  for (auto &js_order : *js) {
+    if (js_order.contains("orderReports")) {
+      // Список ордеров (OCO): отчеты по каждому ордеру списка
+      for (auto &js_report : js_order["orderReports"]) {
+        orders.push_back(json_to_order(js_report));
+      }
+    }
+    else {
+      orders.push_back(json_to_order(js_order));
+    }
+  }
+  return orders;
+}
+
+BinanceResult<CancelReplaceResult> CancelReplace::decode(const RequestResult &r_result) {
+  if ((0 == r_result.transport.code) && (200 != r_result.header.code)) {
+    // Частичный отказ: результаты обеих частей в "data"
+    json js = json::parse(r_result.body, nullptr, false);
+    if (js.is_object() && js.contains("data") && js["data"].is_object()) {
+      return json_to_cancel_replace(js["data"]);
+    }
+  }
+  BinanceResult<json> js = json_body(r_result);
+  if (!js.has_value()) {
+    return std::unexpected(js.error());
+  }
+  if (!js->is_object()) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  return json_to_cancel_replace(*js);
+}
+
+BinanceResult<AmendResult> AmendKeepPriority::decode(const RequestResult &r_result) {
+  BinanceResult<json> js = json_body(r_result);
+  if (!js.has_value()) {
+    return std::unexpected(js.error());
+  }
+  if (!js->is_object()) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  AmendResult result{};
+  result.transact_time = js->value("transactTime", uint64_t{});
+  result.execution_id = js->value("executionId", uint64_t{});
+  if (js->contains("amendedOrder") && (*js)["amendedOrder"].is_object()) {
+    result.order = json_to_order((*js)["amendedOrder"]);
+  }
+  return result;
+}
+
+BinanceResult<Order> QueryOrder::decode(const RequestResult &r_result) {
+  return decode_order(r_result);
+}
+
+BinanceResult<Commission> MyTrades::decode(const RequestResult &r_result) {
+  BinanceResult<json> js = json_body(r_result);
+  if (!js.has_value()) {
+    return std::unexpected(js.error());
+  }
+  Commission cms{};
+  for (auto &js_cms : *js) {
+    if (js_cms.contains("commission") && (js_cms.contains("commissionAsset"))) {
+      cms.set(js_cms.value("commissionAsset", std::string{}), js_cms.value("commission", std::string{}));
+    }
+  }
+  return cms;
+}
+
+BinanceResult<std::vector<Order>> AllOrders::decode(const RequestResult &r_result) {
+  return decode_orders(r_result);
+}
+
+BinanceResult<std::string> UserStreamCreate::decode(const RequestResult &r_result) {
+  BinanceResult<json> js = json_body(r_result);
+  if (!js.has_value()) {
+    return std::unexpected(js.error());
+  }
+  std::string listen_key{js->is_object() ? js->value("listenKey", std::string{}) : std::string{}};
+  if (listen_key.empty()) {
+    return std::unexpected(invalid_response(r_result));
+  }
+  return listen_key;
+}
+
+BinanceResult<bool> UserStreamKeepalive::decode(const RequestResult &r_result) {
+  return empty_body(r_result);
+}
+
+BinanceResult<bool> UserStreamClose::decode(const RequestResult &r_result) {
+  return empty_body(r_result);
+}
+
+}
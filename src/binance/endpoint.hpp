@@ -0,0 +1,270 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+
+#include "./binance_type.hpp"
+#include "./binance_error.hpp"
+#include "./exchange_info.hpp"
+#include "../request/request.hpp"
+#include "../stream/depth_decoder.hpp"
+#include "../utils/histogram.hpp"
+
+/// @brief Авторизация запроса
+enum class EndpointAuth {
+  NONE = 0, // Публичный
+  API_KEY = 1, // Заголовок X-MBX-APIKEY без подписи (userDataStream)
+  SIGNED = 2 // X-MBX-APIKEY, recvWindow, timestamp и подпись HMAC SHA256
+};
+
+/// @brief Индекс эндпоинта в endpoint_table
+enum class EndpointId {
+  PING = 0,
+  TIME,
+  TICKER_PRICE,
+  TICKER_PRICES,
+  DEPTH,
+  EXCHANGE_INFO,
+  ACCOUNT,
+  NEW_ORDER,
+  NEW_ORDER_ACK,
+  NEW_ORDER_FULL,
+  TEST_ORDER,
+  OPEN_ORDERS,
+  CANCEL_ORDER,
+  CANCEL_OPEN_ORDERS,
+  CANCEL_REPLACE,
+  AMEND_KEEP_PRIORITY,
+  QUERY_ORDER,
+  MY_TRADES,
+  ALL_ORDERS,
+  USER_STREAM_CREATE,
+  USER_STREAM_KEEPALIVE,
+  USER_STREAM_CLOSE,
+  COUNT
+};
+
+inline constexpr size_t endpoint_count = static_cast<size_t>(EndpointId::COUNT);
+
+/// @brief Описание эндпоинта REST API
+struct EndpointInfo {
+  EndpointId id;
+  std::string_view name;
+  std::string_view path;
+  RequestType method;
+  uint16_t weight; // Вес запроса (REQUEST_WEIGHT); для depth - при limit 5000
+  EndpointAuth auth;
+  bool sbe; // Ответ может быть в SBE (Binance::response_format)
+};
+
+/// @brief Таблица эндпоинтов: путь, метод, вес, авторизация и формат ответа известны при компиляции
+inline constexpr std::array<EndpointInfo, endpoint_count> endpoint_table{{
+  {EndpointId::PING, "ping", "/api/v3/ping", RequestType::GET, 1, EndpointAuth::NONE, false},
+  {EndpointId::TIME, "time", "/api/v3/time", RequestType::GET, 1, EndpointAuth::NONE, true},
+  {EndpointId::TICKER_PRICE, "ticker_price", "/api/v3/ticker/price", RequestType::GET, 2, EndpointAuth::NONE, true},
+  {EndpointId::TICKER_PRICES, "ticker_prices", "/api/v3/ticker/price", RequestType::GET, 4, EndpointAuth::NONE, true},
+  {EndpointId::DEPTH, "depth", "/api/v3/depth", RequestType::GET, 250, EndpointAuth::NONE, false},
+  {EndpointId::EXCHANGE_INFO, "exchange_info", "/api/v3/exchangeInfo", RequestType::GET, 20, EndpointAuth::NONE, false},
+  {EndpointId::ACCOUNT, "account", "/api/v3/account", RequestType::GET, 20, EndpointAuth::SIGNED, true},
+  {EndpointId::NEW_ORDER, "new_order", "/api/v3/order", RequestType::POST, 1, EndpointAuth::SIGNED, true},
+  {EndpointId::NEW_ORDER_ACK, "new_order_ack", "/api/v3/order", RequestType::POST, 1, EndpointAuth::SIGNED, true},
+  {EndpointId::NEW_ORDER_FULL, "new_order_full", "/api/v3/order", RequestType::POST, 1, EndpointAuth::SIGNED, false},
+  {EndpointId::TEST_ORDER, "test_order", "/api/v3/order/test", RequestType::POST, 1, EndpointAuth::SIGNED, false},
+  {EndpointId::OPEN_ORDERS, "open_orders", "/api/v3/openOrders", RequestType::GET, 6, EndpointAuth::SIGNED, true},
+  {EndpointId::CANCEL_ORDER, "cancel_order", "/api/v3/order", RequestType::DELETE, 1, EndpointAuth::SIGNED, true},
+  {EndpointId::CANCEL_OPEN_ORDERS, "cancel_open_orders", "/api/v3/openOrders", RequestType::DELETE, 1, EndpointAuth::SIGNED, false},
+  {EndpointId::CANCEL_REPLACE, "cancel_replace", "/api/v3/order/cancelReplace", RequestType::POST, 1, EndpointAuth::SIGNED, false},
+  {EndpointId::AMEND_KEEP_PRIORITY, "amend_keep_priority", "/api/v3/order/amend/keepPriority", RequestType::PUT, 4, EndpointAuth::SIGNED, false},
+  {EndpointId::QUERY_ORDER, "query_order", "/api/v3/order", RequestType::GET, 4, EndpointAuth::SIGNED, true},
+  {EndpointId::MY_TRADES, "my_trades", "/api/v3/myTrades", RequestType::GET, 20, EndpointAuth::SIGNED, false},
+  {EndpointId::ALL_ORDERS, "all_orders", "/api/v3/allOrders", RequestType::GET, 20, EndpointAuth::SIGNED, true},
+  {EndpointId::USER_STREAM_CREATE, "user_stream_create", "/api/v3/userDataStream", RequestType::POST, 2, EndpointAuth::API_KEY, false},
+  {EndpointId::USER_STREAM_KEEPALIVE, "user_stream_keepalive", "/api/v3/userDataStream", RequestType::PUT, 2, EndpointAuth::API_KEY, false},
+  {EndpointId::USER_STREAM_CLOSE, "user_stream_close", "/api/v3/userDataStream", RequestType::DELETE, 2, EndpointAuth::API_KEY, false}
+}};
+
+/// @brief Ошибка ответа REST без исключений: транспорт, тело ошибки Binance (JSON или SBE) или HTTP статус
+/// @param r_result Результат запроса
+/// @return - Ошибка (type == ExceptionType::None - ответ успешный)
+BinanceError response_error(const RequestResult &r_result);
+
+/// @brief Ответ в формате SBE (Content-Type application/sbe)
+bool is_sbe_response(const RequestResult &r_result);
+
+/// @brief Описания эндпоинтов для Binance::call<E>: info - строка endpoint_table, Result - тип результата,
+/// decode - разбор ответа (ошибка ответа возвращается в BinanceResult, без исключений)
+namespace endpoint {
+
+template<EndpointId Id, typename R>
+struct Descriptor {
+  static_assert(Id == endpoint_table[static_cast<size_t>(Id)].id, "endpoint_table order must match EndpointId");
+  static constexpr const EndpointInfo &info = endpoint_table[static_cast<size_t>(Id)];
+  using Result = R;
+};
+
+struct Ping : Descriptor<EndpointId::PING, bool> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+/// @brief Время сервера (мс)
+struct Time : Descriptor<EndpointId::TIME, uint64_t> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct TickerPrice : Descriptor<EndpointId::TICKER_PRICE, dec::decimal<8>> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct TickerPrices : Descriptor<EndpointId::TICKER_PRICES, PriceTable> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct Depth : Descriptor<EndpointId::DEPTH, DepthSnapshot> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct ExchangeInfo : Descriptor<EndpointId::EXCHANGE_INFO, std::shared_ptr<const ::ExchangeInfo>> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct Account : Descriptor<EndpointId::ACCOUNT, Balance> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+/// @brief Новый ордер, newOrderRespType=RESULT
+struct NewOrder : Descriptor<EndpointId::NEW_ORDER, Order> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+/// @brief Новый ордер, newOrderRespType=ACK
+struct NewOrderAck : Descriptor<EndpointId::NEW_ORDER_ACK, OrderAck> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+/// @brief Новый ордер, newOrderRespType=FULL (сделки только в JSON)
+struct NewOrderFull : Descriptor<EndpointId::NEW_ORDER_FULL, Order> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct TestOrder : Descriptor<EndpointId::TEST_ORDER, bool> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct OpenOrders : Descriptor<EndpointId::OPEN_ORDERS, std::vector<Order>> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct CancelOrder : Descriptor<EndpointId::CANCEL_ORDER, Order> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+/// @brief Отмена всех открытых ордеров пары (-2011 - открытых ордеров нет, пустой результат)
+struct CancelOpenOrders : Descriptor<EndpointId::CANCEL_OPEN_ORDERS, std::vector<Order>> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+/// @brief Отмена и создание ордера (частичный отказ -2021/-2022 - результат, а не ошибка)
+struct CancelReplace : Descriptor<EndpointId::CANCEL_REPLACE, CancelReplaceResult> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct AmendKeepPriority : Descriptor<EndpointId::AMEND_KEEP_PRIORITY, AmendResult> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct QueryOrder : Descriptor<EndpointId::QUERY_ORDER, Order> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct MyTrades : Descriptor<EndpointId::MY_TRADES, Commission> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct AllOrders : Descriptor<EndpointId::ALL_ORDERS, std::vector<Order>> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+/// @brief Новый listenKey
+struct UserStreamCreate : Descriptor<EndpointId::USER_STREAM_CREATE, std::string> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct UserStreamKeepalive : Descriptor<EndpointId::USER_STREAM_KEEPALIVE, bool> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+struct UserStreamClose : Descriptor<EndpointId::USER_STREAM_CLOSE, bool> {
+  static BinanceResult<Result> decode(const RequestResult &r_result);
+};
+
+}
+
+/// @brief Статистика эндпоинта
+struct EndpointStats {
+  uint64_t calls{0}; // Отправленных запросов
+  uint64_t errors{0}; // Ответов с ошибкой
+  uint64_t rejected{0}; // Не отправлено: исчерпан бюджет веса
+  uint64_t weight{0}; // Израсходованный вес
+  uint64_t p50_ns{0}; // Задержка запроса с разбором ответа (p50)
+  uint64_t p99_ns{0}; // Задержка запроса с разбором ответа (p99)
+};
+
+/// @brief Счетчики эндпоинта (запись без блокировок)
+struct EndpointCounters {
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> errors{0};
+  std::atomic<uint64_t> rejected{0};
+  std::atomic<uint64_t> weight{0};
+  LatencyHistogram latency{};
+};
+
+/// @brief Локальный бюджет веса запросов на окно времени (REQUEST_WEIGHT 6000/мин; ORDERS 50/10 с - вес 1 на ордер).
+/// Запрос сверх бюджета не отправляется: сервер ответил бы -1003 (-1015) и, при повторах, блокировкой IP (418).
+/// Номер окна и занятый вес хранятся в одном 64-битном слове и меняются одним CAS:
+/// смена окна не теряет чужой вес, а отказ ничего не откатывает
+class WeightBudget {
+private:
+  static const uint64_t used_mask{0xffffffff};
+  std::atomic<uint64_t> state{0}; // Номер окна (старшие 32 бита) и занятый в нем вес (младшие 32 бита)
+  std::atomic<uint64_t> max_weight;
+  uint64_t window_ms;
+public:
+  /// @param limit Вес на окно
+  /// @param window_ms Длина окна (мс)
+  explicit WeightBudget(uint64_t limit, uint64_t window_ms = 60000) : max_weight(limit), window_ms(std::max<uint64_t>(window_ms, 1)) {}
+
+  /// @brief Занять вес в текущем окне
+  /// @param weight Вес запроса
+  /// @param now_ms Текущее время (мс)
+  /// @return True - вес занят; False - бюджет окна исчерпан (не более 2^32 - 1 в окне)
+  bool acquire(uint64_t weight, uint64_t now_ms) {
+    uint64_t current_window = (now_ms / window_ms) & used_mask;
+    uint64_t limit = std::min(max_weight.load(std::memory_order_relaxed), used_mask);
+    uint64_t current = state.load(std::memory_order_relaxed);
+    while (true) {
+      // Поток с отставшими часами учитывается в текущем окне и не возвращает окно назад
+      uint64_t window = std::max(current_window, current >> 32);
+      uint64_t used = (window == (current >> 32)) ? (current & used_mask) : 0;
+      if (used + weight > limit) {
+        return false;
+      }
+      if (state.compare_exchange_weak(current, (window << 32) | (used + weight), std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+  }
+
+  /// @brief Вес, занятый в последнем окне с запросами
+  uint64_t weight_used() const {
+    return state.load(std::memory_order_relaxed) & used_mask;
+  }
+
+  void limit(uint64_t limit) {
+    max_weight = limit;
+  }
+};
@@ -0,0 +1,103 @@
+#include "exchange_info.hpp"
+
+namespace {
+
+const int64_t fixed_one{100000000}; // 1.0 в единицах 1e-8
+
+/// @brief a * b в единицах 1e-8 (без переполнения)
+__int128 fixed_mul(int64_t a, int64_t b) {
+  return static_cast<__int128>(a) * b / fixed_one;
+}
+
+}
+
+void ExchangeInfo::add(const SymbolFilters &symbol_filters) {
+  auto it = index.find(symbol_filters.symbol);
+  if (it != index.end()) {
+    filters[it->second] = symbol_filters;
+  }
+  else {
+    index[symbol_filters.symbol] = static_cast<uint32_t>(filters.size());
+    filters.push_back(symbol_filters);
+  }
+}
+
+const SymbolFilters* ExchangeInfo::find(const std::string &symbol) const {
+  auto it = index.find(symbol);
+  return (it != index.end()) ? &filters[it->second] : nullptr;
+}
+
+size_t ExchangeInfo::size() const {
+  return filters.size();
+}
+
+FilterResult ExchangeInfo::validate(const Order &order, dec::decimal<8> avg_price) const {
+  const SymbolFilters *f = find(order.symbol);
+  if (nullptr == f) {
+    return FilterResult::UNKNOWN_SYMBOL;
+  }
+  // MARKET без цены: PRICE_FILTER и PERCENT_PRICE не применяются, NOTIONAL - по средней цене (если задана);
+  // MARKET на сумму (quoteOrderQty): LOT_SIZE не применяется, NOTIONAL - сама сумма
+  bool has_price = order_type_has_price(order.type);
+  bool quote_qty = (OrderType::MARKET == order.type) && (0 == order.origQty.getUnbiased());
+  int64_t avg = avg_price.getUnbiased();
+  int64_t price = has_price ? order.price.getUnbiased() : avg;
+  int64_t qty = order.origQty.getUnbiased();
+  if (has_price &&
+      ((price <= 0) ||
+       ((0 != f->min_price) && (price < f->min_price)) ||
+       ((0 != f->max_price) && (price > f->max_price)) ||
+       ((0 != f->tick_size) && (0 != (price - f->min_price) % f->tick_size)))) {
+    return FilterResult::PRICE_FILTER;
+  }
+  if (!quote_qty &&
+      ((qty <= 0) ||
+       ((0 != f->min_qty) && (qty < f->min_qty)) ||
+       ((0 != f->max_qty) && (qty > f->max_qty)) ||
+       ((0 != f->step_size) && (0 != (qty - f->min_qty) % f->step_size)))) {
+    return FilterResult::LOT_SIZE;
+  }
+  __int128 notional = quote_qty ? order.quoteOrderQty.getUnbiased() : fixed_mul(price, qty);
+  if ((quote_qty || (0 < price)) &&
+      (((0 != f->min_notional) && (notional < f->min_notional)) ||
+       ((0 != f->max_notional) && (notional > f->max_notional)))) {
+    return FilterResult::MIN_NOTIONAL;
+  }
+  if (has_price && (0 < avg)) {
+    bool buy = (Side::BUY == order.side);
+    int64_t mult_up = buy ? f->bid_mult_up : f->ask_mult_up;
+    int64_t mult_down = buy ? f->bid_mult_down : f->ask_mult_down;
+    if (((0 != mult_up) && (price > fixed_mul(avg, mult_up))) ||
+        ((0 != mult_down) && (price < fixed_mul(avg, mult_down)))) {
+      return FilterResult::PERCENT_PRICE;
+    }
+  }
+  return FilterResult::OK;
+}
+
+FilterResult ExchangeInfo::round(Order &order, dec::decimal<8> avg_price) const {
+  const SymbolFilters *f = find(order.symbol);
+  if (nullptr == f) {
+    return FilterResult::UNKNOWN_SYMBOL;
+  }
+  if ((0 != f->tick_size) && order_type_has_price(order.type)) {
+    int64_t price = order.price.getUnbiased();
+    int64_t rest = (price - f->min_price) % f->tick_size;
+    if (0 != rest) {
+      price -= rest;
+      if (Side::SELL == order.side) {
+        price += f->tick_size;
+      }
+      order.price.setUnbiased(price);
+    }
+  }
+  if ((0 != f->tick_size) && order_type_has_stop_price(order.type)) {
+    int64_t stop_price = order.stopPrice.getUnbiased();
+    order.stopPrice.setUnbiased(stop_price - (stop_price - f->min_price) % f->tick_size);
+  }
+  if ((0 != f->step_size) && (0 != order.origQty.getUnbiased())) {
+    int64_t qty = order.origQty.getUnbiased();
+    order.origQty.setUnbiased(qty - (qty - f->min_qty) % f->step_size);
+  }
+  return validate(order, avg_price);
+}
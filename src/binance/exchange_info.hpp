@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "./binance_type.hpp"
+
+/// @brief Результат проверки ордера фильтрами торговой пары
+enum class FilterResult {
+  OK = 0,
+  UNKNOWN_SYMBOL = 1,
+  PRICE_FILTER = 2,
+  LOT_SIZE = 3,
+  MIN_NOTIONAL = 4,
+  PERCENT_PRICE = 5
+};
+
+/// @brief Фильтры торговой пары (/api/v3/exchangeInfo).
+/// Все значения - целые в единицах 1e-8 (как dec::decimal<8>::getUnbiased), 0 - ограничения нет
+struct SymbolFilters {
+  std::string symbol{};
+  int64_t min_price{0}; // PRICE_FILTER
+  int64_t max_price{0};
+  int64_t tick_size{0};
+  int64_t min_qty{0}; // LOT_SIZE
+  int64_t max_qty{0};
+  int64_t step_size{0};
+  int64_t min_notional{0}; // MIN_NOTIONAL / NOTIONAL
+  int64_t max_notional{0};
+  int64_t bid_mult_up{0}; // PERCENT_PRICE / PERCENT_PRICE_BY_SIDE
+  int64_t bid_mult_down{0};
+  int64_t ask_mult_up{0};
+  int64_t ask_mult_down{0};
+};
+
+/// @brief Таблица фильтров торговых пар для локальной проверки и округления ордеров
+class ExchangeInfo {
+private:
+  std::vector<SymbolFilters> filters;
+  std::unordered_map<std::string, uint32_t> index;
+public:
+  /// @brief Добавить (заменить) фильтры торговой пары
+  void add(const SymbolFilters &symbol_filters);
+
+  /// @brief Фильтры торговой пары
+  /// @return - Указатель на фильтры (nullptr - пара не найдена)
+  const SymbolFilters* find(const std::string &symbol) const;
+
+  /// @brief Количество торговых пар
+  size_t size() const;
+
+  /// @brief Проверка ордера фильтрами PRICE_FILTER, LOT_SIZE, MIN_NOTIONAL/NOTIONAL, PERCENT_PRICE
+  /// @param order Ордер
+  /// @param avg_price Средняя цена пары для PERCENT_PRICE (0 - проверка не выполняется)
+  /// @return - Результат проверки
+  FilterResult validate(const Order &order, dec::decimal<8> avg_price = dec::decimal<8>{}) const;
+
+  /// @brief Округление цены до tickSize (BUY - вниз, SELL - вверх) и количества до stepSize (вниз)
+  /// с последующей проверкой фильтрами
+  /// @param order Ордер (изменяется)
+  /// @param avg_price Средняя цена пары для PERCENT_PRICE (0 - проверка не выполняется)
+  /// @return - Результат проверки округленного ордера
+  FilterResult round(Order &order, dec::decimal<8> avg_price = dec::decimal<8>{}) const;
+};
+
+inline constexpr auto filter_result_names = make_enum_table<FilterResult>({
+  {FilterResult::OK, "OK"},
+  {FilterResult::UNKNOWN_SYMBOL, "UNKNOWN_SYMBOL"},
+  {FilterResult::PRICE_FILTER, "PRICE_FILTER"},
+  {FilterResult::LOT_SIZE, "LOT_SIZE"},
+  {FilterResult::MIN_NOTIONAL, "MIN_NOTIONAL"},
+  {FilterResult::PERCENT_PRICE, "PERCENT_PRICE"}
+});
+
+static constexpr std::string_view filter_result_to_str(FilterResult result) {
+  return filter_result_names.to_str(result, "NONE");
+}
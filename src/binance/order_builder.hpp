@@ -0,0 +1,91 @@
+#pragma once
+
+#include <string>
+
+#include "./binance_type.hpp"
+#include "../utils/utils.hpp"
+
+/// @brief Построители ордеров по типу: каждая функция принимает ровно те поля, которые обязательны для типа,
+/// а timeInForce задается параметром шаблона только там, где Binance его принимает
+/// (limit_order<TimeInForce::IOC>(...)); неверное сочетание не компилируется.
+
+/// @brief Лимитный ордер (LIMIT)
+/// @tparam Tif GTC - до отмены; IOC - неисполненный остаток отменяется сразу; FOK - исполнить целиком или отменить
+template<TimeInForce Tif = TimeInForce::GTC>
+Order limit_order(const std::string &symbol, Side side, const dec::decimal<8> &price, const dec::decimal<8> &quantity) {
+  static_assert(TimeInForce::NONE != Tif, "LIMIT order requires timeInForce");
+  Order order{symbol, 0, price, quantity, side, OrderStatus::NONE, 0};
+  order.type = OrderType::LIMIT;
+  order.timeInForce = Tif;
+  return order;
+}
+
+/// @brief Лимитный ордер только на добавление ликвидности (LIMIT_MAKER): отклоняется, если исполнился бы сразу
+static Order limit_maker_order(const std::string &symbol, Side side, const dec::decimal<8> &price, const dec::decimal<8> &quantity) {
+  Order order{symbol, 0, price, quantity, side, OrderStatus::NONE, 0};
+  order.type = OrderType::LIMIT_MAKER;
+  order.timeInForce = TimeInForce::NONE;
+  return order;
+}
+
+/// @brief Рыночный ордер на количество базовой валюты (MARKET, quantity)
+static Order market_order(const std::string &symbol, Side side, const dec::decimal<8> &quantity) {
+  Order order{symbol, 0, dec::decimal<8>{}, quantity, side, OrderStatus::NONE, 0};
+  order.type = OrderType::MARKET;
+  order.timeInForce = TimeInForce::NONE;
+  return order;
+}
+
+/// @brief Рыночный ордер на сумму в котируемой валюте (MARKET, quoteOrderQty)
+static Order market_quote_order(const std::string &symbol, Side side, const dec::decimal<8> &quote_quantity) {
+  Order order{market_order(symbol, side, dec::decimal<8>{})};
+  order.quoteOrderQty = quote_quantity;
+  return order;
+}
+
+/// @brief Стоп-лимитный ордер (STOP_LOSS_LIMIT): лимитный ордер выставляется при достижении stop_price
+template<TimeInForce Tif = TimeInForce::GTC>
+Order stop_loss_limit_order(const std::string &symbol, Side side, const dec::decimal<8> &price, const dec::decimal<8> &quantity,
+                            const dec::decimal<8> &stop_price) {
+  static_assert(TimeInForce::NONE != Tif, "STOP_LOSS_LIMIT order requires timeInForce");
+  Order order{limit_order<Tif>(symbol, side, price, quantity)};
+  order.type = OrderType::STOP_LOSS_LIMIT;
+  order.stopPrice = stop_price;
+  return order;
+}
+
+/// @brief Тейк-профит лимитный ордер (TAKE_PROFIT_LIMIT): лимитный ордер выставляется при достижении stop_price
+template<TimeInForce Tif = TimeInForce::GTC>
+Order take_profit_limit_order(const std::string &symbol, Side side, const dec::decimal<8> &price, const dec::decimal<8> &quantity,
+                              const dec::decimal<8> &stop_price) {
+  static_assert(TimeInForce::NONE != Tif, "TAKE_PROFIT_LIMIT order requires timeInForce");
+  Order order{limit_order<Tif>(symbol, side, price, quantity)};
+  order.type = OrderType::TAKE_PROFIT_LIMIT;
+  order.stopPrice = stop_price;
+  return order;
+}
+
+/// @brief Параметры запроса создания ордера по его типу (type, timeInForce, quantity/quoteOrderQty, price, stopPrice)
+/// @param order Ордер
+/// @param add Функция добавления параметра (ключ, значение)
+template<typename Add>
+void order_params(const Order &order, Add &&add) {
+  add("symbol", order.symbol);
+  add("side", side_to_str(order.side));
+  add("type", order_type_to_str(order.type));
+  if (order_type_has_time_in_force(order.type)) {
+    add("timeInForce", time_in_force_to_str(order.timeInForce));
+  }
+  if ((OrderType::MARKET == order.type) && (0 == order.origQty.getUnbiased())) {
+    add("quoteOrderQty", val_to_str(order.quoteOrderQty));
+  }
+  else {
+    add("quantity", val_to_str(order.origQty));
+  }
+  if (order_type_has_price(order.type)) {
+    add("price", val_to_str(order.price));
+  }
+  if (order_type_has_stop_price(order.type)) {
+    add("stopPrice", val_to_str(order.stopPrice));
+  }
+}
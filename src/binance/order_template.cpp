@@ -0,0 +1,46 @@
+#include "order_template.hpp"
+
+#include <charconv>
+
+#include "../utils/fast_decimal.hpp"
+
+namespace {
+
+std::string template_prefix(const std::string &symbol, Side side, OrderType type, TimeInForce tif) {
+  if ((OrderType::LIMIT != type) && (OrderType::LIMIT_MAKER != type)) {
+    throw BinanceException{ExceptionType::Filter, 0, std::string{"OrderTemplate supports LIMIT and LIMIT_MAKER only"}};
+  }
+  std::string time_in_force{order_type_has_time_in_force(type) ? std::format("timeInForce={}&", time_in_force_to_str(tif)) : ""};
+  return std::format("symbol={}&side={}&type={}&{}newOrderRespType=RESULT&", symbol, side_to_str(side), order_type_to_str(type), time_in_force);
+}
+
+}
+
+OrderTemplate::OrderTemplate(const Auth &key, const std::string &symbol, Side side, OrderType type, TimeInForce tif, int recv_window)
+    : order_symbol(symbol), order_side(side), order_type(type), recv_window(recv_window),
+      prefix(template_prefix(symbol, side, type, tif)),
+      hmac(key.user_key, prefix) {
+  header_params.add("X-MBX-APIKEY", key.api_key);
+  query_buffer.reserve(prefix.size() + 256);
+  query_buffer.assign(prefix);
+}
+
+const std::string &OrderTemplate::query(const dec::decimal<8> &price, const dec::decimal<8> &quantity, uint64_t timestamp) {
+  // Буфер всегда начинается с неизменной части: дописывается и подписывается только окончание
+  // quantity=<q>&price=<p>&recvWindow=<w>&timestamp=<t>
+  char number[32];
+  query_buffer.resize(prefix.size());
+  query_buffer.append("quantity=");
+  query_buffer.append(number, fixed_to_chars<8>(number, quantity.getUnbiased()));
+  query_buffer.append("&price=");
+  query_buffer.append(number, fixed_to_chars<8>(number, price.getUnbiased()));
+  query_buffer.append("&recvWindow=");
+  query_buffer.append(number, std::to_chars(number, number + sizeof(number), recv_window).ptr);
+  query_buffer.append("&timestamp=");
+  query_buffer.append(number, std::to_chars(number, number + sizeof(number), timestamp).ptr);
+  char signature[64];
+  size_t signature_size = hmac.sign(std::string_view(query_buffer).substr(prefix.size()), signature);
+  query_buffer.append("&signature=");
+  query_buffer.append(signature, signature_size);
+  return query_buffer;
+}
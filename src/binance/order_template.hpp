@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "./binance.hpp"
+#include "../utils/hmac_prefix.hpp"
+
+/// @brief Шаблон лимитного ордера (LIMIT с timeInForce или LIMIT_MAKER, newOrderRespType=RESULT) для повторяющихся ордеров одной пары и стороны.
+/// Неизменная часть запроса (symbol, side, type, timeInForce, newOrderRespType) и заголовки собираются один раз,
+/// состояние HMAC после неизменной части сохраняется: на каждый ордер дописываются только
+/// quantity, price, recvWindow, timestamp и хешируются только они.
+/// Один шаблон - один поток (для нескольких потоков - по шаблону на поток).
+class OrderTemplate {
+private:
+  std::string order_symbol;
+  Side order_side;
+  OrderType order_type;
+  int recv_window;
+  BaseHeader header_params{};
+  std::string prefix;
+  HmacSha256Prefix hmac;
+  std::string query_buffer{};
+public:
+  /// @brief Конструктор шаблона
+  /// @param key Ключи доступа
+  /// @param symbol Торговая пара
+  /// @param side Сторона
+  /// @param type LIMIT или LIMIT_MAKER
+  /// @param tif timeInForce (только для LIMIT)
+  /// @param recv_window recvWindow запроса (мс)
+  /// @exception BinanceException (ExceptionType::Filter - тип ордера не лимитный)
+  OrderTemplate(const Auth &key, const std::string &symbol, Side side, OrderType type = OrderType::LIMIT,
+                TimeInForce tif = TimeInForce::GTC, int recv_window = 5000);
+  OrderTemplate(const OrderTemplate&) = delete;
+  OrderTemplate& operator=(const OrderTemplate&) = delete;
+
+  const std::string &symbol() const { return order_symbol; }
+  Side side() const { return order_side; }
+  OrderType type() const { return order_type; }
+
+  /// @brief Заголовки запроса (с X-MBX-APIKEY)
+  const headerparams &header() const { return header_params; }
+
+  /// @brief Подписанная строка параметров ордера
+  /// @param price Цена
+  /// @param quantity Количество
+  /// @param timestamp timestamp запроса (мс)
+  /// @return Строка параметров (действительна до следующего вызова)
+  const std::string &query(const dec::decimal<8> &price, const dec::decimal<8> &quantity, uint64_t timestamp);
+};
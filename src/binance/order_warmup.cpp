@@ -0,0 +1,59 @@
+#include "order_warmup.hpp"
+
+OrderWarmup::OrderWarmup(Binance &binance, const Order &order, WarmupConfig config)
+    : probe([&binance, order]() { binance.warmup(order); }), config(config) {}
+
+OrderWarmup::OrderWarmup(std::function<void()> probe, WarmupConfig config) : probe(probe), config(config) {}
+
+void OrderWarmup::start() {
+  if (running.exchange(true)) {
+    return;
+  }
+  run();
+  timer = std::thread(&OrderWarmup::timer_loop, this);
+}
+
+void OrderWarmup::stop() {
+  if (!running.exchange(false)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    cv.notify_all();
+  }
+  if (timer.joinable()) {
+    timer.join();
+  }
+}
+
+void OrderWarmup::run() {
+  auto start = std::chrono::steady_clock::now();
+  try {
+    probe();
+    n_runs++;
+  }
+  catch (BinanceException &) {
+    n_errors++;
+  }
+  last_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void OrderWarmup::timer_loop() {
+  std::unique_lock<std::mutex> lock(mtx);
+  while (running) {
+    if (cv.wait_for(lock, config.period, [this]() { return !running; })) {
+      break;
+    }
+    lock.unlock();
+    run();
+    lock.lock();
+  }
+}
+
+WarmupStats OrderWarmup::stats() const {
+  return WarmupStats{n_runs.load(), n_errors.load(), last_ns.load()};
+}
+
+OrderWarmup::~OrderWarmup() {
+  stop();
+}
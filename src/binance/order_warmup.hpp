@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <functional>
+
+#include "./binance.hpp"
+
+/// @brief Настройки периодического прогрева
+struct WarmupConfig {
+  std::chrono::milliseconds period{5000}; // Период прогона (меньше keep-alive таймаута сервера)
+};
+
+/// @brief Статистика прогрева
+struct WarmupStats {
+  uint64_t runs{0};
+  uint64_t errors{0};
+  uint64_t last_ns{0}; // Время последнего прогона
+};
+
+/// @brief Периодический прогрев пути создания ордера (Binance::warmup, /api/v3/order/test) в потоке таймера.
+/// Первый прогон выполняется в start(); далее - каждые config.period, пока соединение и кэши простаивают
+/// между всплесками торговли. Ошибки прогона учитываются в статистике и не останавливают прогрев.
+class OrderWarmup {
+private:
+  std::function<void()> probe;
+  WarmupConfig config;
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::atomic<bool> running{false};
+  std::thread timer{};
+  std::atomic<uint64_t> n_runs{0};
+  std::atomic<uint64_t> n_errors{0};
+  std::atomic<uint64_t> last_ns{0};
+
+  void run();
+  void timer_loop();
+public:
+  /// @brief Прогрев клиента Binance
+  /// @param binance Клиент Binance (должен жить дольше прогрева)
+  /// @param order Ордер, похожий на будущие реальные
+  /// @param config Настройки
+  OrderWarmup(Binance &binance, const Order &order, WarmupConfig config = WarmupConfig{});
+
+  /// @brief Прогрев произвольной операцией (исключение BinanceException - ошибка прогона)
+  /// @param probe Операция прогрева
+  /// @param config Настройки
+  OrderWarmup(std::function<void()> probe, WarmupConfig config = WarmupConfig{});
+  OrderWarmup(const OrderWarmup&) = delete;
+  OrderWarmup& operator=(const OrderWarmup&) = delete;
+
+  /// @brief Первый прогон и запуск потока таймера
+  void start();
+
+  /// @brief Остановка потока таймера
+  void stop();
+
+  WarmupStats stats() const;
+
+  ~OrderWarmup();
+};
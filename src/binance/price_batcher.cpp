@@ -0,0 +1,121 @@
+#include "price_batcher.hpp"
+
+PriceBatcher::PriceBatcher(Binance &binance, PriceBatcherConfig config)
+  : PriceBatcher([&binance](std::span<const std::string_view> symbols) { return binance.prices(symbols); }, config) {}
+
+PriceBatcher::PriceBatcher(Fetch fetch, PriceBatcherConfig config) : fetch(fetch), config(config) {
+  if (0 == this->config.max_batch) {
+    this->config.max_batch = 1;
+  }
+  worker = std::thread(&PriceBatcher::run, this);
+}
+
+dec::decimal<8> PriceBatcher::symbol_price(const std::string &symbol) {
+  n_calls++;
+  std::future<dec::decimal<8>> result;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    queue.push_back(Waiter{symbol, std::promise<dec::decimal<8>>()});
+    result = queue.back().promise.get_future();
+  }
+  cv.notify_one();
+  return result.get();
+}
+
+void PriceBatcher::run() {
+  std::unique_lock<std::mutex> lock(mtx);
+  while (true) {
+    cv.wait(lock, [this]() { return stopped || !queue.empty(); });
+    if (queue.empty()) {
+      lock.unlock();
+      for (auto &f : in_flight) {
+        f.wait();
+      }
+      return;
+    }
+    auto deadline = std::chrono::steady_clock::now() + config.window;
+    cv.wait_until(lock, deadline, [this]() { return stopped || (queue.size() >= config.max_batch); });
+    size_t count = std::min(queue.size(), config.max_batch);
+    std::vector<Waiter> batch{};
+    batch.reserve(count);
+    std::move(queue.begin(), queue.begin() + count, std::back_inserter(batch));
+    queue.erase(queue.begin(), queue.begin() + count);
+    std::erase_if(in_flight, [](std::future<void> &f) {
+      return std::future_status::ready == f.wait_for(std::chrono::seconds(0));
+    });
+    // Пакет выполняется асинхронно, сбор следующего пакета не ждет ответа сервера
+    in_flight.push_back(std::async(std::launch::async, [this](std::vector<Waiter> batch) { execute(batch); }, std::move(batch)));
+  }
+}
+
+void PriceBatcher::fetch_split(std::span<const std::string_view> symbols, PriceTable &found,
+                               std::map<std::string_view, std::exception_ptr> &failed) {
+  n_requests++;
+  n_weight += (1 == symbols.size()) ? price_weight_single : price_weight_multi;
+  std::exception_ptr error{};
+  try {
+    PriceTable prices{fetch(symbols)};
+    for (size_t i = 0; i < prices.symbols.size(); i++) {
+      found.add(prices.symbols[i], prices.prices[i]);
+    }
+    return;
+  }
+  catch (const BinanceException &e) {
+    // Binance отклоняет весь пакет из-за одной неверной пары (-1121): пакет делится пополам,
+    // ошибку получают только пары, на которых она повторяется. -1003 (лимит запросов) не делится
+    if ((ExceptionType::Binance == e.e_type) && (-1003 != e.e_code) && (1 < symbols.size())) {
+      size_t half = symbols.size() / 2;
+      fetch_split(symbols.first(half), found, failed);
+      fetch_split(symbols.subspan(half), found, failed);
+      return;
+    }
+    error = std::current_exception();
+  }
+  catch (...) {
+    error = std::current_exception();
+  }
+  for (auto symbol : symbols) {
+    failed[symbol] = error;
+  }
+}
+
+void PriceBatcher::execute(std::vector<Waiter> &batch) {
+  std::set<std::string> unique{};
+  for (auto &waiter : batch) {
+    unique.insert(waiter.symbol);
+  }
+  std::vector<std::string_view> symbols{unique.begin(), unique.end()};
+  PriceTable prices{};
+  std::map<std::string_view, std::exception_ptr> failed{};
+  fetch_split(symbols, prices, failed);
+  prices.build_index();
+  for (auto &waiter : batch) {
+    auto error = failed.find(waiter.symbol);
+    int64_t pos = prices.find(waiter.symbol);
+    if (error != failed.end()) {
+      waiter.promise.set_exception(error->second);
+    }
+    else if (0 <= pos) {
+      waiter.promise.set_value(prices.prices[pos]);
+    }
+    else {
+      waiter.promise.set_exception(std::make_exception_ptr(BinanceException{ExceptionType::Binance, -1121, std::string{"Invalid symbol."}}));
+    }
+  }
+}
+
+PriceBatcherStats PriceBatcher::stats() {
+  PriceBatcherStats result{n_calls.load(), n_requests.load(), n_weight.load(), 0};
+  uint64_t weight_unbatched = result.calls * price_weight_single;
+  result.weight_saved = (weight_unbatched > result.weight) ? (weight_unbatched - result.weight) : 0;
+  return result;
+}
+
+PriceBatcher::~PriceBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stopped = true;
+  }
+  cv.notify_all();
+  worker.join();
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <span>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+#include "./binance.hpp"
+
+/// @brief Вес запроса /api/v3/ticker/price для одной пары
+const uint64_t price_weight_single{2};
+/// @brief Вес запроса /api/v3/ticker/price для нескольких пар
+const uint64_t price_weight_multi{4};
+
+/// @brief Настройки планировщика запросов цены
+struct PriceBatcherConfig {
+  std::chrono::microseconds window{200}; // Окно сбора запросов в пакет
+  size_t max_batch{100}; // Максимальное количество запросов в пакете
+};
+
+/// @brief Статистика планировщика запросов цены
+struct PriceBatcherStats {
+  uint64_t calls{0}; // Вызовов symbol_price
+  uint64_t requests{0}; // HTTP запросов
+  uint64_t weight{0}; // Израсходованный вес
+  uint64_t weight_saved{0}; // Сэкономленный вес относительно запроса на каждый вызов
+};
+
+/// @brief Планировщик запросов цены.
+/// Собирает вызовы symbol_price, пришедшие в течение окна, и выполняет их
+/// одним запросом /api/v3/ticker/price?symbols=[...], раздавая цены ожидающим.
+/// Ошибка Binance по пакету (неверная пара) достается только ожидающим этой пары.
+class PriceBatcher {
+public:
+  /// @brief Функция получения цен по списку пар
+  using Fetch = std::function<PriceTable(std::span<const std::string_view>)>;
+private:
+  struct Waiter {
+    std::string symbol;
+    std::promise<dec::decimal<8>> promise;
+  };
+  Fetch fetch;
+  PriceBatcherConfig config;
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::vector<Waiter> queue;
+  std::vector<std::future<void>> in_flight;
+  bool stopped{false};
+  std::atomic<uint64_t> n_calls{0};
+  std::atomic<uint64_t> n_requests{0};
+  std::atomic<uint64_t> n_weight{0};
+  std::thread worker;
+  void run();
+  void execute(std::vector<Waiter> &batch);
+  /// @brief Запрос цен пакета; при ошибке Binance пакет делится пополам до пары с ошибкой
+  void fetch_split(std::span<const std::string_view> symbols, PriceTable &found, std::map<std::string_view, std::exception_ptr> &failed);
+public:
+  /// @brief Конструктор планировщика поверх клиента Binance
+  /// @param binance Клиент Binance (должен жить дольше планировщика)
+  /// @param config Настройки
+  PriceBatcher(Binance &binance, PriceBatcherConfig config = PriceBatcherConfig{});
+
+  /// @brief Конструктор планировщика с произвольной функцией получения цен
+  /// @param fetch Функция получения цен
+  /// @param config Настройки
+  PriceBatcher(Fetch fetch, PriceBatcherConfig config = PriceBatcherConfig{});
+
+  /// @brief Возврат цены за пару (запрос объединяется с соседними)
+  /// @param symbol Торговая пара
+  /// @return - Прайс
+  /// @exception BinanceException
+  dec::decimal<8> symbol_price(const std::string &symbol);
+
+  /// @brief Статистика планировщика
+  PriceBatcherStats stats();
+
+  /// @brief Деструктор планировщика (дожидается выполнения собранных запросов)
+  ~PriceBatcher();
+};
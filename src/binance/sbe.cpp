@@ -0,0 +1,281 @@
+#include "sbe.hpp"
+
+#include <format>
+
+namespace {
+
+const int64_t pow10[19]{1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL,
+                        10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL, 100000000000000LL,
+                        1000000000000000LL, 10000000000000000LL, 100000000000000000LL, 1000000000000000000LL};
+
+OrderStatus sbe_to_order_status(uint8_t status) {
+  switch (status) {
+    case 0: return OrderStatus::NEW;
+    case 1: return OrderStatus::PARTIALLY_FILLED;
+    case 2: return OrderStatus::FILLED;
+    case 3: return OrderStatus::CANCELED;
+    case 4: return OrderStatus::PENDING_CANCEL;
+    case 5: return OrderStatus::REJECTED;
+    case 6: return OrderStatus::EXPIRED;
+    case 7: return OrderStatus::EXPIRED_IN_MATCH;
+    default: return OrderStatus::NONE;
+  }
+}
+
+OrderType sbe_to_order_type(uint8_t type) {
+  switch (type) {
+    case 0: return OrderType::MARKET;
+    case 1: return OrderType::LIMIT;
+    case 2: return OrderType::STOP_LOSS;
+    case 3: return OrderType::STOP_LOSS_LIMIT;
+    case 4: return OrderType::TAKE_PROFIT;
+    case 5: return OrderType::TAKE_PROFIT_LIMIT;
+    case 6: return OrderType::LIMIT_MAKER;
+    default: return OrderType::NONE;
+  }
+}
+
+TimeInForce sbe_to_time_in_force(uint8_t tif) {
+  switch (tif) {
+    case 0: return TimeInForce::GTC;
+    case 1: return TimeInForce::IOC;
+    case 2: return TimeInForce::FOK;
+    default: return TimeInForce::NONE;
+  }
+}
+
+Side sbe_to_side(uint8_t side) {
+  switch (side) {
+    case 0: return Side::BUY;
+    case 1: return Side::SELL;
+    default: return Side::NONE;
+  }
+}
+
+/// @brief Ордер из блока OrderResponse (элемент группы или корневой блок)
+template<typename Get>
+void decode_order_block(Get &&get, Order &order) {
+  using L = SbeOrderLayout;
+  int8_t price_exponent = get(L::price_exponent{});
+  int8_t qty_exponent = get(L::qty_exponent{});
+  order.orderId = static_cast<uint64_t>(get(L::order_id{}));
+  order.price = sbe_to_decimal(get(L::price{}), price_exponent);
+  order.origQty = sbe_to_decimal(get(L::orig_qty{}), qty_exponent);
+  order.status = sbe_to_order_status(get(L::status{}));
+  order.side = sbe_to_side(get(L::side{}));
+  order.type = sbe_to_order_type(get(L::order_type{}));
+  order.timeInForce = sbe_to_time_in_force(get(L::time_in_force{}));
+  int64_t stop_price = get(L::stop_price{});
+  if (L::stop_price::null != stop_price) {
+    order.stopPrice = sbe_to_decimal(stop_price, price_exponent);
+  }
+  int64_t time = get(L::time{});
+  order.time = (L::time::null == time) ? 0 : static_cast<uint64_t>(time);
+}
+
+}
+
+std::string sbe_schema_header() {
+  return std::format("{}:{}", sbe_schema_id, sbe_schema_version);
+}
+
+bool sbe_supported(std::string_view data) {
+  SbeDecoder decoder{};
+  return decoder.wrap(data) && (sbe_schema_id == decoder.schema_id());
+}
+
+dec::decimal<8> sbe_to_decimal(int64_t mantissa, int8_t exponent) {
+  dec::decimal<8> result{};
+  int shift = 8 + exponent;
+  if ((std::numeric_limits<int64_t>::min() == mantissa) || (-18 > shift) || (18 < shift)) {
+    return result;
+  }
+  result.setUnbiased((0 <= shift) ? mantissa * pow10[shift] : mantissa / pow10[-shift]);
+  return result;
+}
+
+bool sbe_decode_error(std::string_view data, int &code, std::string &msg) {
+  SbeDecoder decoder{};
+  if (!decoder.wrap(data) || (SbeTemplate::ERROR != decoder.template_id())) {
+    return false;
+  }
+  code = decoder.get<SbeErrorLayout::code>();
+  std::string_view text{};
+  decoder.var16(text);
+  msg = text;
+  return true;
+}
+
+bool sbe_decode_server_time(std::string_view data, uint64_t &server_time) {
+  SbeDecoder decoder{};
+  if (!decoder.wrap(data) || (SbeTemplate::SERVER_TIME != decoder.template_id())) {
+    return false;
+  }
+  server_time = static_cast<uint64_t>(decoder.get<SbeServerTimeLayout::server_time>());
+  return true;
+}
+
+bool sbe_decode_price(std::string_view data, dec::decimal<8> &price) {
+  SbeDecoder decoder{};
+  if (!decoder.wrap(data) || (SbeTemplate::PRICE_TICKER_SYMBOL != decoder.template_id())) {
+    return false;
+  }
+  price = sbe_to_decimal(decoder.get<SbePriceLayout::price>(), decoder.get<SbePriceLayout::price_exponent>());
+  return true;
+}
+
+bool sbe_decode_price_table(std::string_view data, PriceTable &table) {
+  table.clear();
+  SbeDecoder decoder{};
+  if (!decoder.wrap(data)) {
+    return false;
+  }
+  std::string_view symbol{};
+  if (SbeTemplate::PRICE_TICKER_SYMBOL == decoder.template_id()) {
+    if (!decoder.var8(symbol)) {
+      return false;
+    }
+    table.add(symbol, sbe_to_decimal(decoder.get<SbePriceLayout::price>(), decoder.get<SbePriceLayout::price_exponent>()));
+    table.build_index();
+    return true;
+  }
+  uint16_t block_length{0};
+  uint32_t count{0};
+  if ((SbeTemplate::PRICE_TICKER != decoder.template_id()) || !decoder.group(block_length, count)) {
+    return false;
+  }
+  table.reserve(count);
+  for (uint32_t i = 0; i < count; i++) {
+    const char *entry = decoder.entry(block_length);
+    if ((nullptr == entry) || !decoder.var8(symbol)) {
+      table.clear();
+      return false;
+    }
+    table.add(symbol, sbe_to_decimal(SbeDecoder::get<SbePriceLayout::price>(entry, block_length),
+                                     SbeDecoder::get<SbePriceLayout::price_exponent>(entry, block_length)));
+  }
+  table.build_index();
+  return true;
+}
+
+bool sbe_decode_balance(std::string_view data, Balance &balance) {
+  balance.clear();
+  SbeDecoder decoder{};
+  uint16_t block_length{0};
+  uint32_t count{0};
+  if (!decoder.wrap(data) || (SbeTemplate::ACCOUNT != decoder.template_id()) || !decoder.group(block_length, count)) {
+    return false;
+  }
+  std::string_view asset{};
+  for (uint32_t i = 0; i < count; i++) {
+    const char *entry = decoder.entry(block_length);
+    if ((nullptr == entry) || !decoder.var8(asset)) {
+      balance.clear();
+      return false;
+    }
+    int8_t exponent = SbeDecoder::get<SbeBalanceLayout::exponent>(entry, block_length);
+    balance.balance[std::string(asset)] = BalanceData{sbe_to_decimal(SbeDecoder::get<SbeBalanceLayout::free>(entry, block_length), exponent),
+                                                      sbe_to_decimal(SbeDecoder::get<SbeBalanceLayout::locked>(entry, block_length), exponent)};
+  }
+  return true;
+}
+
+bool sbe_decode_order(std::string_view data, Order &order) {
+  SbeDecoder decoder{};
+  if (!decoder.wrap(data)) {
+    return false;
+  }
+  order = Order{};
+  std::string_view symbol{};
+  switch (decoder.template_id()) {
+    case SbeTemplate::NEW_ORDER_RESULT:
+    case SbeTemplate::CANCEL_ORDER: {
+      using L = SbeOrderResultLayout;
+      int8_t price_exponent = decoder.get<L::price_exponent>();
+      int8_t qty_exponent = decoder.get<L::qty_exponent>();
+      order.orderId = static_cast<uint64_t>(decoder.get<L::order_id>());
+      order.price = sbe_to_decimal(decoder.get<L::price>(), price_exponent);
+      order.origQty = sbe_to_decimal(decoder.get<L::orig_qty>(), qty_exponent);
+      order.status = sbe_to_order_status(decoder.get<L::status>());
+      order.side = sbe_to_side(decoder.get<L::side>());
+      order.type = sbe_to_order_type(decoder.get<L::order_type>());
+      order.timeInForce = sbe_to_time_in_force(decoder.get<L::time_in_force>());
+      int64_t time = decoder.get<L::transact_time>();
+      order.time = (L::transact_time::null == time) ? 0 : static_cast<uint64_t>(time);
+      break;
+    }
+    case SbeTemplate::ORDER:
+      decode_order_block([&decoder](auto field) { return decoder.get<decltype(field)>(); }, order);
+      break;
+    case SbeTemplate::CANCEL_REPLACE_ORDER: {
+      std::string_view cancel_response{};
+      std::string_view new_order_response{};
+      if (!decoder.var32(cancel_response) || !decoder.var32(new_order_response)) {
+        return false;
+      }
+      return sbe_decode_order(new_order_response, order);
+    }
+    default:
+      return false;
+  }
+  if (!decoder.var8(symbol)) {
+    return false;
+  }
+  order.symbol = symbol;
+  return true;
+}
+
+bool sbe_decode_order_ack(std::string_view data, OrderAck &ack) {
+  SbeDecoder decoder{};
+  if (!decoder.wrap(data) || (SbeTemplate::NEW_ORDER_ACK != decoder.template_id())) {
+    return false;
+  }
+  using L = SbeOrderAckLayout;
+  ack.orderId = static_cast<uint64_t>(decoder.get<L::order_id>());
+  int64_t time = decoder.get<L::transact_time>();
+  ack.transactTime = (L::transact_time::null == time) ? 0 : static_cast<uint64_t>(time);
+  std::string_view symbol{};
+  std::string_view client_order_id{};
+  if (!decoder.var8(symbol) || !decoder.var8(client_order_id)) {
+    return false;
+  }
+  ack.symbol = symbol;
+  ack.clientOrderId = client_order_id;
+  return true;
+}
+
+bool sbe_decode_orders(std::string_view data, std::vector<Order> &orders) {
+  orders.clear();
+  SbeDecoder decoder{};
+  uint16_t block_length{0};
+  uint32_t count{0};
+  if (!decoder.wrap(data) || (SbeTemplate::ORDERS != decoder.template_id()) || !decoder.group(block_length, count)) {
+    return false;
+  }
+  orders.resize(count);
+  std::string_view symbol{};
+  std::string_view client_order_id{};
+  for (auto &order : orders) {
+    const char *entry = decoder.entry(block_length);
+    if (nullptr == entry) {
+      orders.clear();
+      return false;
+    }
+    decode_order_block([entry, block_length](auto field) { return SbeDecoder::get<decltype(field)>(entry, block_length); }, order);
+    if (!decoder.var8(symbol) || !decoder.var8(client_order_id)) {
+      orders.clear();
+      return false;
+    }
+    order.symbol = symbol;
+  }
+  return true;
+}
+
+bool sbe_decode_ws_response(std::string_view data, SbeWsResponse &response) {
+  SbeDecoder decoder{};
+  if (!decoder.wrap(data) || (SbeTemplate::WEBSOCKET_RESPONSE != decoder.template_id())) {
+    return false;
+  }
+  response.status = decoder.get<SbeWsResponseLayout::status>();
+  return decoder.skip_group() && decoder.var8(response.id) && decoder.var32(response.result);
+}
@@ -0,0 +1,384 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <limits>
+#include <type_traits>
+
+#include "./binance_type.hpp"
+
+static_assert(std::endian::little == std::endian::native, "SBE codecs read little-endian fields in place");
+
+/// @brief Схема SBE спотового API Binance, запрашиваемая клиентом (X-MBX-SBE: <id>:<version>)
+const uint16_t sbe_schema_id{3};
+const uint16_t sbe_schema_version{1};
+const std::string_view sbe_content_type{"application/sbe"};
+
+/// @brief Сообщения схемы (templateId), которые декодирует клиент
+enum class SbeTemplate : uint16_t {
+  NONE = 0,
+  WEBSOCKET_RESPONSE = 50,
+  ERROR = 100,
+  SERVER_TIME = 102,
+  PRICE_TICKER = 209,
+  PRICE_TICKER_SYMBOL = 210,
+  NEW_ORDER_ACK = 300,
+  NEW_ORDER_RESULT = 301,
+  ORDER = 304,
+  CANCEL_ORDER = 305,
+  CANCEL_REPLACE_ORDER = 307,
+  ORDERS = 308,
+  ACCOUNT = 400
+};
+
+/// @brief Поле блока фиксированной длины: тип и смещение известны при компиляции,
+/// значение читается из буфера ответа на месте (без копирования сообщения)
+template<typename T, size_t Offset>
+struct SbeField {
+  using type = T;
+  static constexpr size_t offset{Offset};
+  static constexpr size_t end{Offset + sizeof(T)};
+  /// @brief Значение null необязательного поля (presence="optional")
+  static constexpr T null{std::is_signed_v<T> ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max()};
+
+  static T get(const char *block) {
+    T value;
+    std::memcpy(&value, block + Offset, sizeof(T));
+    return value;
+  }
+
+  static void put(char *block, T value) {
+    std::memcpy(block + Offset, &value, sizeof(T));
+  }
+};
+
+/// @brief Заголовок сообщения (messageHeader)
+struct SbeHeaderLayout {
+  using block_length = SbeField<uint16_t, 0>;
+  using template_id = SbeField<uint16_t, 2>;
+  using schema_id = SbeField<uint16_t, 4>;
+  using version = SbeField<uint16_t, 6>;
+  static constexpr uint16_t size{8};
+};
+
+/// @brief Заголовок повторяющейся группы (groupSizeEncoding)
+struct SbeGroupLayout {
+  using block_length = SbeField<uint16_t, 0>;
+  using num_in_group = SbeField<uint32_t, 2>;
+  static constexpr uint16_t size{6};
+};
+
+/// @brief ErrorResponse <100>; данные: msg (varString), data (varString)
+struct SbeErrorLayout {
+  using code = SbeField<int16_t, 0>;
+  using server_time = SbeField<int64_t, 2>;
+  using retry_after = SbeField<int64_t, 10>;
+  static constexpr uint16_t block_length{18};
+};
+
+/// @brief ServerTimeResponse <102>
+struct SbeServerTimeLayout {
+  using server_time = SbeField<int64_t, 0>;
+  static constexpr uint16_t block_length{8};
+};
+
+/// @brief PriceTickerSymbolResponse <210> и элемент группы tickers PriceTickerResponse <209>; данные: symbol (varString8)
+struct SbePriceLayout {
+  using price_exponent = SbeField<int8_t, 0>;
+  using price = SbeField<int64_t, 1>;
+  static constexpr uint16_t block_length{9};
+};
+
+/// @brief AccountResponse <400>; группы: balances, permissions
+struct SbeAccountLayout {
+  using commission_exponent = SbeField<int8_t, 0>;
+  using maker_commission = SbeField<int64_t, 1>;
+  using taker_commission = SbeField<int64_t, 9>;
+  using buyer_commission = SbeField<int64_t, 17>;
+  using seller_commission = SbeField<int64_t, 25>;
+  using can_trade = SbeField<uint8_t, 33>;
+  using can_withdraw = SbeField<uint8_t, 34>;
+  using can_deposit = SbeField<uint8_t, 35>;
+  using brokered = SbeField<uint8_t, 36>;
+  using require_self_trade_prevention = SbeField<uint8_t, 37>;
+  using prevent_sor = SbeField<uint8_t, 38>;
+  using update_time = SbeField<int64_t, 39>;
+  using account_type = SbeField<uint8_t, 47>;
+  using trade_group_id = SbeField<int64_t, 48>;
+  using uid = SbeField<int64_t, 56>;
+  static constexpr uint16_t block_length{64};
+};
+
+/// @brief Элемент группы balances AccountResponse; данные: asset (varString8)
+struct SbeBalanceLayout {
+  using exponent = SbeField<int8_t, 0>;
+  using free = SbeField<int64_t, 1>;
+  using locked = SbeField<int64_t, 9>;
+  static constexpr uint16_t block_length{17};
+};
+
+/// @brief NewOrderAckResponse <300>; данные: symbol, clientOrderId (varString8)
+struct SbeOrderAckLayout {
+  using order_id = SbeField<int64_t, 0>;
+  using order_list_id = SbeField<int64_t, 8>;
+  using transact_time = SbeField<int64_t, 16>;
+  static constexpr uint16_t block_length{24};
+};
+
+/// @brief NewOrderResultResponse <301> и CancelOrderResponse <305> (общее начало блока);
+/// данные: symbol, clientOrderId (varString8)
+struct SbeOrderResultLayout {
+  using price_exponent = SbeField<int8_t, 0>;
+  using qty_exponent = SbeField<int8_t, 1>;
+  using order_id = SbeField<int64_t, 2>;
+  using order_list_id = SbeField<int64_t, 10>;
+  using transact_time = SbeField<int64_t, 18>;
+  using price = SbeField<int64_t, 26>;
+  using orig_qty = SbeField<int64_t, 34>;
+  using executed_qty = SbeField<int64_t, 42>;
+  using cummulative_quote_qty = SbeField<int64_t, 50>;
+  using status = SbeField<uint8_t, 58>;
+  using time_in_force = SbeField<uint8_t, 59>;
+  using order_type = SbeField<uint8_t, 60>;
+  using side = SbeField<uint8_t, 61>;
+  static constexpr uint16_t block_length{62};
+};
+
+/// @brief OrderResponse <304> и элемент группы orders OrdersResponse <308>; данные: symbol, clientOrderId (varString8)
+struct SbeOrderLayout {
+  using price_exponent = SbeField<int8_t, 0>;
+  using qty_exponent = SbeField<int8_t, 1>;
+  using order_id = SbeField<int64_t, 2>;
+  using order_list_id = SbeField<int64_t, 10>;
+  using price = SbeField<int64_t, 18>;
+  using orig_qty = SbeField<int64_t, 26>;
+  using executed_qty = SbeField<int64_t, 34>;
+  using cummulative_quote_qty = SbeField<int64_t, 42>;
+  using status = SbeField<uint8_t, 50>;
+  using time_in_force = SbeField<uint8_t, 51>;
+  using order_type = SbeField<uint8_t, 52>;
+  using side = SbeField<uint8_t, 53>;
+  using stop_price = SbeField<int64_t, 54>;
+  using time = SbeField<int64_t, 62>;
+  using update_time = SbeField<int64_t, 70>;
+  using is_working = SbeField<uint8_t, 78>;
+  static constexpr uint16_t block_length{79};
+};
+
+/// @brief CancelReplaceOrderResponse <307>; данные: cancelResponse, newOrderResponse (varString32, вложенные сообщения)
+struct SbeCancelReplaceLayout {
+  using cancel_result = SbeField<uint8_t, 0>;
+  using new_order_result = SbeField<uint8_t, 1>;
+  static constexpr uint16_t block_length{2};
+};
+
+/// @brief WebSocketResponse <50> (конверт ответа WebSocket API); группа rateLimits, данные: id (varString8), result (varString32)
+struct SbeWsResponseLayout {
+  using deprecated = SbeField<uint8_t, 0>;
+  using status = SbeField<uint16_t, 1>;
+  static constexpr uint16_t block_length{3};
+};
+
+/// @brief Курсор декодера SBE (flyweight): проверяет границы, блоки и строки ссылаются на исходный буфер.
+/// Размер блока берется из заголовка, поэтому ответы более новой версии схемы (с полями в конце блока) читаются.
+class SbeDecoder {
+private:
+  std::string_view data{};
+  size_t pos{0};
+  const char *root{nullptr};
+  uint16_t root_length{0};
+  SbeTemplate id{SbeTemplate::NONE};
+  uint16_t schema{0};
+  uint16_t schema_version{0};
+
+  const char *take(size_t size) {
+    if (data.size() - pos < size) {
+      return nullptr;
+    }
+    const char *ptr = data.data() + pos;
+    pos += size;
+    return ptr;
+  }
+
+  template<typename L>
+  bool var(std::string_view &value) {
+    const char *length = take(sizeof(L));
+    if (nullptr == length) {
+      return false;
+    }
+    L size;
+    std::memcpy(&size, length, sizeof(L));
+    const char *ptr = take(size);
+    if (nullptr == ptr) {
+      return false;
+    }
+    value = std::string_view(ptr, size);
+    return true;
+  }
+public:
+  /// @brief Начало сообщения: заголовок и корневой блок
+  /// @param message Сообщение SBE
+  /// @return False - сообщение короче заголовка или блока
+  bool wrap(std::string_view message) {
+    data = message;
+    pos = 0;
+    const char *header = take(SbeHeaderLayout::size);
+    if (nullptr == header) {
+      return false;
+    }
+    root_length = SbeHeaderLayout::block_length::get(header);
+    id = static_cast<SbeTemplate>(SbeHeaderLayout::template_id::get(header));
+    schema = SbeHeaderLayout::schema_id::get(header);
+    schema_version = SbeHeaderLayout::version::get(header);
+    root = take(root_length);
+    return nullptr != root;
+  }
+
+  SbeTemplate template_id() const { return id; }
+  uint16_t schema_id() const { return schema; }
+  uint16_t version() const { return schema_version; }
+
+  /// @brief Поле корневого блока (null, если блок короче - сообщение старой версии схемы)
+  template<typename Field>
+  typename Field::type get() const {
+    return (Field::end <= root_length) ? Field::get(root) : Field::null;
+  }
+
+  /// @brief Поле элемента группы
+  template<typename Field>
+  static typename Field::type get(const char *entry, uint16_t block_length) {
+    return (Field::end <= block_length) ? Field::get(entry) : Field::null;
+  }
+
+  /// @brief Заголовок группы
+  /// @return False - данные закончились
+  bool group(uint16_t &block_length, uint32_t &count) {
+    const char *header = take(SbeGroupLayout::size);
+    if (nullptr == header) {
+      return false;
+    }
+    block_length = SbeGroupLayout::block_length::get(header);
+    count = SbeGroupLayout::num_in_group::get(header);
+    return true;
+  }
+
+  /// @brief Блок следующего элемента группы (nullptr - данные закончились)
+  const char *entry(uint16_t block_length) { return take(block_length); }
+
+  /// @brief Пропуск группы целиком (элементы без данных переменной длины)
+  bool skip_group() {
+    uint16_t block_length{0};
+    uint32_t count{0};
+    return group(block_length, count) && (nullptr != take(static_cast<size_t>(block_length) * count));
+  }
+
+  bool var8(std::string_view &value) { return var<uint8_t>(value); }
+  bool var16(std::string_view &value) { return var<uint16_t>(value); }
+  bool var32(std::string_view &value) { return var<uint32_t>(value); }
+};
+
+/// @brief Кодировщик сообщений SBE (ответы локальных заглушек и тестовые данные бенчмарков)
+class SbeEncoder {
+private:
+  std::string out{};
+  size_t block{0};
+
+  template<typename L>
+  void var(std::string_view value) {
+    L size = static_cast<L>(value.size());
+    out.append(reinterpret_cast<const char*>(&size), sizeof(L));
+    out.append(value);
+  }
+public:
+  /// @brief Начало сообщения: заголовок и пустой корневой блок
+  SbeEncoder &begin(SbeTemplate id, uint16_t block_length, uint16_t version = sbe_schema_version) {
+    out.assign(SbeHeaderLayout::size + block_length, '\0');
+    SbeHeaderLayout::block_length::put(out.data(), block_length);
+    SbeHeaderLayout::template_id::put(out.data(), static_cast<uint16_t>(id));
+    SbeHeaderLayout::schema_id::put(out.data(), sbe_schema_id);
+    SbeHeaderLayout::version::put(out.data(), version);
+    block = SbeHeaderLayout::size;
+    return *this;
+  }
+
+  /// @brief Поле текущего блока (корневого или последнего элемента группы)
+  template<typename Field>
+  SbeEncoder &set(typename Field::type value) {
+    Field::put(out.data() + block, value);
+    return *this;
+  }
+
+  /// @brief Заголовок группы
+  SbeEncoder &group(uint16_t block_length, uint32_t count) {
+    char header[SbeGroupLayout::size];
+    SbeGroupLayout::block_length::put(header, block_length);
+    SbeGroupLayout::num_in_group::put(header, count);
+    out.append(header, sizeof(header));
+    return *this;
+  }
+
+  /// @brief Пустой блок следующего элемента группы (становится текущим)
+  SbeEncoder &entry(uint16_t block_length) {
+    block = out.size();
+    out.append(block_length, '\0');
+    return *this;
+  }
+
+  SbeEncoder &var8(std::string_view value) { var<uint8_t>(value); return *this; }
+  SbeEncoder &var16(std::string_view value) { var<uint16_t>(value); return *this; }
+  SbeEncoder &var32(std::string_view value) { var<uint32_t>(value); return *this; }
+
+  /// @brief Сообщение целиком (действительно до следующего begin)
+  const std::string &data() const { return out; }
+};
+
+/// @brief Значение X-MBX-SBE (и параметры sbeSchemaId / sbeSchemaVersion WebSocket API)
+std::string sbe_schema_header();
+
+/// @brief Ответ в формате SBE поддерживаемой схемы
+/// @param data Тело ответа
+/// @return False - другая схема или не SBE
+bool sbe_supported(std::string_view data);
+
+/// @brief Мантисса и показатель SBE -> dec::decimal<8> (null - 0)
+dec::decimal<8> sbe_to_decimal(int64_t mantissa, int8_t exponent);
+
+/// @brief ErrorResponse <100>
+/// @return False - сообщение не ErrorResponse
+bool sbe_decode_error(std::string_view data, int &code, std::string &msg);
+
+/// @brief ServerTimeResponse <102>
+bool sbe_decode_server_time(std::string_view data, uint64_t &server_time);
+
+/// @brief PriceTickerSymbolResponse <210> -> цена
+bool sbe_decode_price(std::string_view data, dec::decimal<8> &price);
+
+/// @brief PriceTickerResponse <209> или PriceTickerSymbolResponse <210> -> таблица цен (индекс построен)
+bool sbe_decode_price_table(std::string_view data, PriceTable &table);
+
+/// @brief AccountResponse <400> -> баланс
+bool sbe_decode_balance(std::string_view data, Balance &balance);
+
+/// @brief NewOrderResultResponse <301>, OrderResponse <304>, CancelOrderResponse <305>
+/// или новый ордер из CancelReplaceOrderResponse <307> -> Order
+bool sbe_decode_order(std::string_view data, Order &order);
+
+/// @brief NewOrderAckResponse <300> -> подтверждение
+bool sbe_decode_order_ack(std::string_view data, OrderAck &ack);
+
+/// @brief OrdersResponse <308> -> ордера
+bool sbe_decode_orders(std::string_view data, std::vector<Order> &orders);
+
+/// @brief Конверт ответа WebSocket API
+struct SbeWsResponse {
+  uint16_t status{0}; // HTTP статус (200 - result содержит сообщение ответа, иначе ErrorResponse)
+  std::string_view id{}; // id запроса
+  std::string_view result{}; // Вложенное сообщение SBE
+};
+
+/// @brief WebSocketResponse <50>
+bool sbe_decode_ws_response(std::string_view data, SbeWsResponse &response);
@@ -0,0 +1,326 @@
+#include "fix_codec.hpp"
+
+#include <charconv>
+#include <format>
+#include <chrono>
+#include <ctime>
+
+#include "../utils/fast_decimal.hpp"
+
+namespace {
+
+const std::string_view fix_begin_string{"8=FIX.4.4\x01"};
+
+uint64_t to_u64(std::string_view value) {
+  uint64_t result{0};
+  std::from_chars(value.data(), value.data() + value.size(), result);
+  return result;
+}
+
+unsigned checksum(std::string_view data) {
+  unsigned sum{0};
+  for (unsigned char c : data) {
+    sum += c;
+  }
+  return sum & 0xFF;
+}
+
+}
+
+void FixWriter::tag(FixTag tag) {
+  char buffer[16];
+  auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<int>(tag));
+  body.append(buffer, end);
+  body.push_back('=');
+}
+
+void FixWriter::begin(FixMsgType type, std::string_view sender, std::string_view target, uint64_t seq, std::string_view sending_time) {
+  body.clear();
+  field(FixTag::MSG_TYPE, static_cast<char>(type));
+  field(FixTag::SENDER_COMP_ID, sender);
+  field(FixTag::TARGET_COMP_ID, target);
+  field(FixTag::MSG_SEQ_NUM, seq);
+  field(FixTag::SENDING_TIME, sending_time);
+}
+
+FixWriter &FixWriter::field(FixTag tag, std::string_view value) {
+  this->tag(tag);
+  body.append(value);
+  body.push_back(fix_soh);
+  return *this;
+}
+
+FixWriter &FixWriter::field(FixTag tag, uint64_t value) {
+  this->tag(tag);
+  char buffer[24];
+  auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  body.append(buffer, end);
+  body.push_back(fix_soh);
+  return *this;
+}
+
+FixWriter &FixWriter::field(FixTag tag, char value) {
+  this->tag(tag);
+  body.push_back(value);
+  body.push_back(fix_soh);
+  return *this;
+}
+
+FixWriter &FixWriter::field(FixTag tag, const dec::decimal<8> &value) {
+  this->tag(tag);
+  char buffer[32];
+  body.append(buffer, fixed_to_chars<8>(buffer, value.getUnbiased()));
+  body.push_back(fix_soh);
+  return *this;
+}
+
+std::string_view FixWriter::finish() {
+  out.clear();
+  out.append(fix_begin_string);
+  out.append("9=");
+  char buffer[24];
+  auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), body.size());
+  out.append(buffer, end);
+  out.push_back(fix_soh);
+  out.append(body);
+  unsigned sum = checksum(out);
+  out.append("10=");
+  out.push_back(static_cast<char>('0' + sum / 100));
+  out.push_back(static_cast<char>('0' + sum / 10 % 10));
+  out.push_back(static_cast<char>('0' + sum % 10));
+  out.push_back(fix_soh);
+  return out;
+}
+
+bool FixMessage::parse(std::string_view data) {
+  fields.clear();
+  size_t pos{0};
+  while (pos < data.size()) {
+    size_t eq = data.find('=', pos);
+    size_t end = data.find(fix_soh, pos);
+    if ((std::string_view::npos == eq) || (std::string_view::npos == end) || (eq > end)) {
+      return false;
+    }
+    int tag{0};
+    auto [ptr, ec] = std::from_chars(data.data() + pos, data.data() + eq, tag);
+    if ((std::errc() != ec) || (ptr != data.data() + eq)) {
+      return false;
+    }
+    fields.emplace_back(tag, data.substr(eq + 1, end - eq - 1));
+    pos = end + 1;
+  }
+  return !fields.empty();
+}
+
+std::string_view FixMessage::get(FixTag tag) const {
+  for (auto &[key, value] : fields) {
+    if (static_cast<int>(tag) == key) {
+      return value;
+    }
+  }
+  return std::string_view{};
+}
+
+uint64_t FixMessage::get_u64(FixTag tag) const {
+  return to_u64(get(tag));
+}
+
+FixMsgType FixMessage::type() const {
+  std::string_view value = get(FixTag::MSG_TYPE);
+  if (1 != value.size()) {
+    return FixMsgType::NONE;
+  }
+  switch (value[0]) {
+    case '0': case '1': case '2': case '3': case '4': case '5': case '8': case '9': case 'A': case 'D': case 'F':
+      return static_cast<FixMsgType>(value[0]);
+    default:
+      return FixMsgType::NONE;
+  }
+}
+
+int64_t fix_frame(std::string_view data) {
+  // 8=FIX.4.4<SOH>9=<длина><SOH><тело>10=<ccc><SOH>
+  if (data.size() < fix_begin_string.size() + 2) {
+    return 0;
+  }
+  if (!data.starts_with(fix_begin_string) || (0 != data.compare(fix_begin_string.size(), 2, "9="))) {
+    return -1;
+  }
+  size_t length_pos = fix_begin_string.size() + 2;
+  size_t length_end = data.find(fix_soh, length_pos);
+  if (std::string_view::npos == length_end) {
+    return (data.size() - length_pos > 10) ? -1 : 0;
+  }
+  size_t length{0};
+  auto [ptr, ec] = std::from_chars(data.data() + length_pos, data.data() + length_end, length);
+  if ((std::errc() != ec) || (ptr != data.data() + length_end)) {
+    return -1;
+  }
+  size_t trailer = length_end + 1 + length;
+  size_t total = trailer + 7;
+  if (data.size() < total) {
+    return 0;
+  }
+  std::string_view tail = data.substr(trailer, 7);
+  if (!tail.starts_with("10=") || (fix_soh != tail[6])) {
+    return -1;
+  }
+  if (to_u64(tail.substr(3, 3)) != checksum(data.substr(0, trailer))) {
+    return -1;
+  }
+  return static_cast<int64_t>(total);
+}
+
+std::string fix_time(uint64_t us_epoch) {
+  time_t sec = static_cast<time_t>(us_epoch / 1000000);
+  tm utc{};
+  gmtime_r(&sec, &utc);
+  return std::format("{:04}{:02}{:02}-{:02}:{:02}:{:02}.{:06}", utc.tm_year + 1900, utc.tm_mon + 1, utc.tm_mday,
+                     utc.tm_hour, utc.tm_min, utc.tm_sec, us_epoch % 1000000);
+}
+
+uint64_t fix_time_to_ms(std::string_view value) {
+  // YYYYMMDD-HH:MM:SS[.sss[sss]]
+  if ((value.size() < 17) || ('-' != value[8]) || (':' != value[11]) || (':' != value[14])) {
+    return 0;
+  }
+  auto number = [&value](size_t pos, size_t size) { return static_cast<unsigned>(to_u64(value.substr(pos, size))); };
+  std::chrono::year_month_day date{std::chrono::year(static_cast<int>(number(0, 4))), std::chrono::month(number(4, 2)), std::chrono::day(number(6, 2))};
+  if (!date.ok()) {
+    return 0;
+  }
+  uint64_t days = std::chrono::sys_days(date).time_since_epoch().count();
+  uint64_t ms = ((days * 24 + number(9, 2)) * 60 + number(12, 2)) * 60000 + number(15, 2) * 1000;
+  if ((value.size() >= 21) && ('.' == value[17])) {
+    ms += number(18, 3);
+  }
+  return ms;
+}
+
+void encode_new_order(FixWriter &writer, const Order &order, std::string_view cl_ord_id) {
+  bool quote_qty = (OrderType::MARKET == order.type) && (0 == order.origQty.getUnbiased());
+  writer.field(FixTag::CL_ORD_ID, cl_ord_id);
+  if (OrderType::LIMIT_MAKER == order.type) {
+    writer.field(FixTag::EXEC_INST, '6'); // Participate don't initiate
+  }
+  if (!quote_qty) {
+    writer.field(FixTag::ORDER_QTY, order.origQty);
+  }
+  writer.field(FixTag::ORD_TYPE, fix_ord_type(order.type));
+  if (order_type_has_price(order.type)) {
+    writer.field(FixTag::PRICE, order.price);
+  }
+  writer.field(FixTag::SIDE, (Side::SELL == order.side) ? '2' : '1')
+        .field(FixTag::SYMBOL, order.symbol);
+  if (order_type_has_time_in_force(order.type)) {
+    writer.field(FixTag::TIME_IN_FORCE, fix_time_in_force(order.timeInForce));
+  }
+  if (quote_qty) {
+    writer.field(FixTag::CASH_ORDER_QTY, order.quoteOrderQty);
+  }
+  if (order_type_has_stop_price(order.type)) {
+    // Стоп-лосс срабатывает при движении цены против позиции, тейк-профит - в ее сторону
+    bool stop_loss = (OrderType::STOP_LOSS == order.type) || (OrderType::STOP_LOSS_LIMIT == order.type);
+    bool up = stop_loss == (Side::BUY == order.side);
+    writer.field(FixTag::TRIGGER_TYPE, '4')
+          .field(FixTag::TRIGGER_ACTION, '1')
+          .field(FixTag::TRIGGER_PRICE, order.stopPrice)
+          .field(FixTag::TRIGGER_PRICE_TYPE, '2')
+          .field(FixTag::TRIGGER_PRICE_DIRECTION, up ? 'U' : 'D');
+  }
+}
+
+void encode_cancel_order(FixWriter &writer, const std::string &symbol, uint64_t order_id, std::string_view cl_ord_id) {
+  writer.field(FixTag::CL_ORD_ID, cl_ord_id)
+        .field(FixTag::ORDER_ID, order_id)
+        .field(FixTag::SYMBOL, symbol);
+}
+
+OrderStatus fix_to_order_status(char status) {
+  switch (status) {
+    case '0': return OrderStatus::NEW;
+    case '1': return OrderStatus::PARTIALLY_FILLED;
+    case '2': return OrderStatus::FILLED;
+    case '4': return OrderStatus::CANCELED;
+    case '6': return OrderStatus::PENDING_CANCEL;
+    case '8': return OrderStatus::REJECTED;
+    case 'A': return OrderStatus::PENDING_NEW;
+    case 'C': return OrderStatus::EXPIRED;
+    default: return OrderStatus::NONE;
+  }
+}
+
+char fix_ord_type(OrderType type) {
+  switch (type) {
+    case OrderType::MARKET: return '1';
+    case OrderType::STOP_LOSS: case OrderType::TAKE_PROFIT: return '3';
+    case OrderType::STOP_LOSS_LIMIT: case OrderType::TAKE_PROFIT_LIMIT: return '4';
+    default: return '2'; // LIMIT, LIMIT_MAKER
+  }
+}
+
+char fix_time_in_force(TimeInForce tif) {
+  switch (tif) {
+    case TimeInForce::IOC: return '3';
+    case TimeInForce::FOK: return '4';
+    default: return '1'; // GTC
+  }
+}
+
+OrderType fix_to_order_type(char ord_type, char exec_inst, char direction, Side side) {
+  switch (ord_type) {
+    case '1': return OrderType::MARKET;
+    case '2': return ('6' == exec_inst) ? OrderType::LIMIT_MAKER : OrderType::LIMIT;
+    case '3': return (('U' == direction) == (Side::BUY == side)) ? OrderType::STOP_LOSS : OrderType::TAKE_PROFIT;
+    case '4': return (('U' == direction) == (Side::BUY == side)) ? OrderType::STOP_LOSS_LIMIT : OrderType::TAKE_PROFIT_LIMIT;
+    default: return OrderType::NONE;
+  }
+}
+
+TimeInForce fix_to_time_in_force(char tif) {
+  switch (tif) {
+    case '1': return TimeInForce::GTC;
+    case '3': return TimeInForce::IOC;
+    case '4': return TimeInForce::FOK;
+    default: return TimeInForce::NONE;
+  }
+}
+
+bool decode_execution_report(const FixMessage &message, FixExecutionReport &report) {
+  if (FixMsgType::EXECUTION_REPORT != message.type()) {
+    return false;
+  }
+  report = FixExecutionReport{};
+  report.order.symbol = message.get(FixTag::SYMBOL);
+  report.order.orderId = message.get_u64(FixTag::ORDER_ID);
+  report.order.price = str_to_decimal<8>(message.get(FixTag::PRICE));
+  report.order.origQty = str_to_decimal<8>(message.get(FixTag::ORDER_QTY));
+  std::string_view side = message.get(FixTag::SIDE);
+  report.order.side = side.empty() ? Side::NONE : (('2' == side[0]) ? Side::SELL : Side::BUY);
+  std::string_view status = message.get(FixTag::ORD_STATUS);
+  report.order.status = status.empty() ? OrderStatus::NONE : fix_to_order_status(status[0]);
+  auto first = [](std::string_view value) { return value.empty() ? '\0' : value[0]; };
+  std::string_view ord_type = message.get(FixTag::ORD_TYPE);
+  if (!ord_type.empty()) {
+    report.order.type = fix_to_order_type(ord_type[0], first(message.get(FixTag::EXEC_INST)),
+                                          first(message.get(FixTag::TRIGGER_PRICE_DIRECTION)), report.order.side);
+  }
+  std::string_view tif = message.get(FixTag::TIME_IN_FORCE);
+  if (!tif.empty()) {
+    report.order.timeInForce = fix_to_time_in_force(tif[0]);
+  }
+  report.order.stopPrice = str_to_decimal<8>(message.get(FixTag::TRIGGER_PRICE));
+  report.order.time = fix_time_to_ms(message.get(FixTag::TRANSACT_TIME));
+  report.cl_ord_id = message.get(FixTag::CL_ORD_ID);
+  report.orig_cl_ord_id = message.get(FixTag::ORIG_CL_ORD_ID);
+  std::string_view exec_type = message.get(FixTag::EXEC_TYPE);
+  report.exec_type = exec_type.empty() ? 0 : exec_type[0];
+  report.cum_qty = str_to_decimal<8>(message.get(FixTag::CUM_QTY));
+  report.last_qty = str_to_decimal<8>(message.get(FixTag::LAST_QTY));
+  report.last_price = str_to_decimal<8>(message.get(FixTag::LAST_PX));
+  report.cum_quote_qty = str_to_decimal<8>(message.get(FixTag::CUM_QUOTE_QTY));
+  std::string_view code = message.get(FixTag::ERROR_CODE);
+  std::from_chars(code.data(), code.data() + code.size(), report.error_code);
+  report.text = message.get(FixTag::TEXT);
+  return true;
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "../binance/binance_type.hpp"
+
+/// @brief Разделитель полей FIX
+const char fix_soh{'\x01'};
+
+/// @brief Теги полей FIX 4.4 (и расширения Binance), используемые сессией
+enum class FixTag : int {
+  BEGIN_SEQ_NO = 7,
+  BEGIN_STRING = 8,
+  BODY_LENGTH = 9,
+  CHECK_SUM = 10,
+  CL_ORD_ID = 11,
+  CUM_QTY = 14,
+  END_SEQ_NO = 16,
+  EXEC_ID = 17,
+  EXEC_INST = 18,
+  LAST_PX = 31,
+  LAST_QTY = 32,
+  MSG_SEQ_NUM = 34,
+  MSG_TYPE = 35,
+  NEW_SEQ_NO = 36,
+  ORDER_ID = 37,
+  ORDER_QTY = 38,
+  ORD_STATUS = 39,
+  ORD_TYPE = 40,
+  ORIG_CL_ORD_ID = 41,
+  POSS_DUP_FLAG = 43,
+  PRICE = 44,
+  REF_SEQ_NUM = 45,
+  SENDER_COMP_ID = 49,
+  SENDING_TIME = 52,
+  SIDE = 54,
+  SYMBOL = 55,
+  TARGET_COMP_ID = 56,
+  TEXT = 58,
+  TIME_IN_FORCE = 59,
+  TRANSACT_TIME = 60,
+  RAW_DATA_LENGTH = 95,
+  RAW_DATA = 96,
+  ENCRYPT_METHOD = 98,
+  STOP_PX = 99,
+  HEART_BT_INT = 108,
+  TEST_REQ_ID = 112,
+  ORIG_SENDING_TIME = 122,
+  GAP_FILL_FLAG = 123,
+  RESET_SEQ_NUM_FLAG = 141,
+  EXEC_TYPE = 150,
+  LEAVES_QTY = 151,
+  CASH_ORDER_QTY = 152,
+  USERNAME = 553,
+  TRIGGER_TYPE = 1100,
+  TRIGGER_ACTION = 1101,
+  TRIGGER_PRICE = 1102,
+  TRIGGER_PRICE_TYPE = 1107,
+  TRIGGER_PRICE_DIRECTION = 1109,
+  ERROR_CODE = 25016,
+  CUM_QUOTE_QTY = 25017,
+  MESSAGE_HANDLING = 25035
+};
+
+/// @brief Типы сообщений FIX (MsgType)
+enum class FixMsgType : char {
+  NONE = 0,
+  HEARTBEAT = '0',
+  TEST_REQUEST = '1',
+  RESEND_REQUEST = '2',
+  REJECT = '3',
+  SEQUENCE_RESET = '4',
+  LOGOUT = '5',
+  EXECUTION_REPORT = '8',
+  ORDER_CANCEL_REJECT = '9',
+  LOGON = 'A',
+  NEW_ORDER_SINGLE = 'D',
+  ORDER_CANCEL_REQUEST = 'F'
+};
+
+/// @brief Сборка сообщения FIX: тело пишется в буфер, BodyLength и CheckSum вычисляются в finish().
+/// Буферы переиспользуются между сообщениями.
+class FixWriter {
+private:
+  std::string body{};
+  std::string out{};
+  void tag(FixTag tag);
+public:
+  /// @brief Начало сообщения (стандартный заголовок)
+  /// @param type MsgType
+  /// @param sender SenderCompID
+  /// @param target TargetCompID
+  /// @param seq MsgSeqNum
+  /// @param sending_time SendingTime (fix_time)
+  void begin(FixMsgType type, std::string_view sender, std::string_view target, uint64_t seq, std::string_view sending_time);
+
+  FixWriter &field(FixTag tag, std::string_view value);
+  FixWriter &field(FixTag tag, uint64_t value);
+  FixWriter &field(FixTag tag, char value);
+  FixWriter &field(FixTag tag, const dec::decimal<8> &value);
+
+  /// @brief Завершение сообщения
+  /// @return Сообщение целиком (действительно до следующего begin)
+  std::string_view finish();
+};
+
+/// @brief Разобранное сообщение FIX: поля ссылаются на исходный буфер без копирования
+class FixMessage {
+private:
+  std::vector<std::pair<int, std::string_view>> fields{};
+public:
+  FixMessage() { fields.reserve(64); }
+
+  /// @brief Разбор полного сообщения (fix_frame > 0)
+  /// @return False - ошибка формата
+  bool parse(std::string_view data);
+
+  /// @brief Значение поля (пустое - поля нет)
+  std::string_view get(FixTag tag) const;
+
+  /// @brief Целое значение поля (0 - поля нет)
+  uint64_t get_u64(FixTag tag) const;
+
+  /// @brief MsgType (NONE - неизвестный тип)
+  FixMsgType type() const;
+
+  /// @brief MsgSeqNum
+  uint64_t seq() const { return get_u64(FixTag::MSG_SEQ_NUM); }
+};
+
+/// @brief Размер полного сообщения FIX в начале данных (с проверкой CheckSum)
+/// @param data Принятые данные
+/// @return Размер сообщения; 0 - сообщение принято не полностью; -1 - ошибка формата
+int64_t fix_frame(std::string_view data);
+
+/// @brief Время в формате FIX UTCTimestamp с микросекундами (YYYYMMDD-HH:MM:SS.ffffff)
+std::string fix_time(uint64_t us_epoch);
+
+/// @brief UTCTimestamp FIX -> мс от эпохи (0 - ошибка)
+uint64_t fix_time_to_ms(std::string_view value);
+
+/// @brief Отчет об исполнении (ExecutionReport <8>)
+struct FixExecutionReport {
+  Order order{}; // Ордер: цена и количество заявки, статус после события, time - TransactTime
+  std::string cl_ord_id{};
+  std::string orig_cl_ord_id{}; // ClOrdID отменяемого ордера (для отмены)
+  char exec_type{0}; // 0 - NEW, 4 - CANCELED, 8 - REJECTED, F - TRADE, C - EXPIRED
+  dec::decimal<8> cum_qty{};
+  dec::decimal<8> last_qty{};
+  dec::decimal<8> last_price{};
+  dec::decimal<8> cum_quote_qty{};
+  int error_code{0}; // ErrorCode Binance (для REJECTED)
+  std::string text{};
+};
+
+/// @brief Тело NewOrderSingle <D> из Order: тип (OrdType, ExecInst для LIMIT_MAKER, Trigger* для стоп-ордеров),
+/// TimeInForce, OrderQty или CashOrderQty (MARKET на сумму)
+void encode_new_order(FixWriter &writer, const Order &order, std::string_view cl_ord_id);
+
+/// @brief Тело OrderCancelRequest <F> по OrderID
+void encode_cancel_order(FixWriter &writer, const std::string &symbol, uint64_t order_id, std::string_view cl_ord_id);
+
+/// @brief ExecutionReport <8> -> FixExecutionReport
+/// @return False - сообщение не ExecutionReport
+bool decode_execution_report(const FixMessage &message, FixExecutionReport &report);
+
+/// @brief OrdStatus FIX -> OrderStatus
+OrderStatus fix_to_order_status(char status);
+
+/// @brief OrderType -> OrdType FIX
+char fix_ord_type(OrderType type);
+
+/// @brief TimeInForce -> TimeInForce FIX
+char fix_time_in_force(TimeInForce tif);
+
+/// @brief OrdType FIX (с ExecInst и TriggerPriceDirection) -> OrderType
+OrderType fix_to_order_type(char ord_type, char exec_inst, char direction, Side side);
+
+/// @brief TimeInForce FIX -> TimeInForce
+TimeInForce fix_to_time_in_force(char tif);
@@ -0,0 +1,370 @@
+#include "fix_session.hpp"
+
+#include <charconv>
+#include <format>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "../utils/utils.hpp"
+
+FixSession::FixSession(Auth key, const std::string &ed25519_pem, FixSessionConfig config)
+    : auth(key), signer(ed25519_pem), config(config), ring(config.buffer_size), pending(config.max_pending) {
+  seq = seq_memory;
+  if (!this->config.seq_store.empty()) {
+    open_seq_store();
+  }
+}
+
+bool FixSession::open_seq_store() {
+  seq_fd = ::open(config.seq_store.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  if (seq_fd < 0) {
+    return false;
+  }
+  bool created = (0 == lseek(seq_fd, 0, SEEK_END));
+  if (0 != ftruncate(seq_fd, sizeof(seq_memory))) {
+    ::close(seq_fd);
+    seq_fd = -1;
+    return false;
+  }
+  void *addr = mmap(nullptr, sizeof(seq_memory), PROT_READ | PROT_WRITE, MAP_SHARED, seq_fd, 0);
+  if (MAP_FAILED == addr) {
+    ::close(seq_fd);
+    seq_fd = -1;
+    return false;
+  }
+  seq = static_cast<uint64_t*>(addr);
+  if (created) {
+    seq[OUT] = 1;
+    seq[IN] = 1;
+  }
+  return true;
+}
+
+Status FixSession::logon() {
+  if (logged_on) {
+    return Status(0, std::string("OK"));
+  }
+  if (!signer.valid()) {
+    return Status(-1, std::string("Ed25519 key is not valid"));
+  }
+  logout();
+  Status status = conn.connect(config.host, config.port, config.tls, config.timeout_ms);
+  if (0 != status.code) {
+    return status;
+  }
+  conn.set_nonblocking();
+  ring.clear();
+  if (config.reset_on_logon) {
+    seq[OUT] = 1;
+    seq[IN] = 1;
+  }
+  gap_begin = 0;
+  gap_end = 0;
+  test_request_pending = false;
+  last_received = std::chrono::steady_clock::now();
+  last_sent = last_received.time_since_epoch().count();
+  session_tag = std::format("{:x}", current_ms_epoch());
+  connected = true;
+  reader = std::thread(&FixSession::read_loop, this);
+  uint64_t id = send(FixMsgType::LOGON, [this](FixWriter &w, uint64_t msg_seq) {
+    // Подписываются MsgType, SenderCompID, TargetCompID, MsgSeqNum и SendingTime, разделенные SOH
+    std::string payload{std::format("A{}{}{}{}{}{}{}{}", fix_soh, config.sender_comp_id, fix_soh, config.target_comp_id, fix_soh,
+                                    msg_seq, fix_soh, sending_time)};
+    std::string signature{signer.sign(payload)};
+    logon_seq = msg_seq;
+    w.field(FixTag::ENCRYPT_METHOD, '0')
+     .field(FixTag::HEART_BT_INT, static_cast<uint64_t>(config.heartbeat_sec))
+     .field(FixTag::RAW_DATA_LENGTH, static_cast<uint64_t>(signature.size()))
+     .field(FixTag::RAW_DATA, signature)
+     .field(FixTag::RESET_SEQ_NUM_FLAG, config.reset_on_logon ? 'Y' : 'N')
+     .field(FixTag::USERNAME, auth.api_key)
+     .field(FixTag::MESSAGE_HANDLING, static_cast<uint64_t>(config.message_handling));
+  }, true);
+  if (0 == id) {
+    logout();
+    return Status(-1, std::string("Logon send failed"));
+  }
+  std::string response{};
+  PendingResult result = pending.wait(id, response, config.spin);
+  FixMessage reply{};
+  if ((PendingResult::DONE == result) && reply.parse(response) && (FixMsgType::LOGON == reply.type())) {
+    return Status(0, std::string("OK"));
+  }
+  std::string text{"Connection closed"};
+  if (PendingResult::DONE == result) {
+    text = reply.get(FixTag::TEXT);
+  }
+  else if (PendingResult::TIMEOUT == result) {
+    text = "Logon timeout";
+  }
+  logout();
+  return Status(-1, text.empty() ? std::string("Logon rejected") : text);
+}
+
+void FixSession::logout() {
+  if (logged_on) {
+    logged_on = false;
+    send(FixMsgType::LOGOUT, [](FixWriter &, uint64_t) {});
+    // Ответный Logout завершает поток чтения
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(config.timeout_ms);
+    while (connected && (std::chrono::steady_clock::now() < deadline)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  connected = false;
+  if (reader.joinable()) {
+    reader.join();
+  }
+  std::lock_guard<std::mutex> lock(send_mtx);
+  conn.close();
+  logged_on = false;
+  pending.fail_all();
+}
+
+Order FixSession::create_order(Order &order) {
+  uint64_t id = send(FixMsgType::NEW_ORDER_SINGLE, [this, &order](FixWriter &w, uint64_t msg_seq) {
+    char buffer[64];
+    encode_new_order(w, order, cl_ord_id(buffer, msg_seq));
+  }, true);
+  return wait_order(id);
+}
+
+Order FixSession::cancel_order(const std::string &symbol, const uint64_t &order_id) {
+  uint64_t id = send(FixMsgType::ORDER_CANCEL_REQUEST, [this, &symbol, order_id](FixWriter &w, uint64_t msg_seq) {
+    char buffer[64];
+    encode_cancel_order(w, symbol, order_id, cl_ord_id(buffer, msg_seq));
+  }, true);
+  return wait_order(id);
+}
+
+Order FixSession::wait_order(uint64_t id) {
+  if (0 == id) {
+    throw BinanceException{ExceptionType::Transport, -1, std::string{logged_on ? "Too many pending requests" : "Not logged on"}};
+  }
+  std::string response{};
+  PendingResult result = pending.wait(id, response, config.spin);
+  if (PendingResult::FAILED == result) {
+    throw BinanceException{ExceptionType::Transport, -1, std::string{"Connection closed"}};
+  }
+  if (PendingResult::TIMEOUT == result) {
+    throw BinanceException{ExceptionType::Transport, -1, std::string{"Request timeout"}};
+  }
+  FixMessage reply{};
+  FixExecutionReport execution{};
+  if (!reply.parse(response)) {
+    throw BinanceException{ExceptionType::Server, -1, std::string{"Response is not valid"}};
+  }
+  if (decode_execution_report(reply, execution) && ('8' != execution.exec_type)) {
+    return execution.order;
+  }
+  int code{0};
+  std::string_view value = reply.get(FixTag::ERROR_CODE);
+  std::from_chars(value.data(), value.data() + value.size(), code);
+  throw BinanceException{ExceptionType::Binance, code, std::string(reply.get(FixTag::TEXT))};
+}
+
+FixSessionStats FixSession::stats() const {
+  return FixSessionStats{n_sent.load(), n_received.load(), n_heartbeats.load(), n_test_requests.load(), n_resend_requests.load(),
+                         n_gap_fills.load(), n_rejects.load(), n_timeouts.load(), n_errors.load()};
+}
+
+void FixSession::read_loop() {
+  auto next_check = std::chrono::steady_clock::now();
+  while (connected) {
+    if (conn.wait_read(100)) {
+      int n{0};
+      while ((0 < ring.writable()) && (0 < (n = conn.read(ring.write_ptr(), ring.writable())))) {
+        ring.commit(n);
+      }
+      int64_t size{0};
+      while (0 < (size = fix_frame(std::string_view(ring.read_ptr(), ring.readable())))) {
+        dispatch(std::string_view(ring.read_ptr(), size));
+        ring.consume(size);
+      }
+      if ((0 > n) || (0 > size) || (0 == ring.writable())) {
+        if (0 > size) {
+          n_errors++;
+        }
+        break;
+      }
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now >= next_check) {
+      check_heartbeat(now);
+      n_timeouts += pending.expire(now);
+      next_check = now + std::chrono::milliseconds(100);
+    }
+  }
+  connected = false;
+  logged_on = false;
+  pending.fail_all();
+}
+
+void FixSession::dispatch(std::string_view raw) {
+  n_received++;
+  last_received = std::chrono::steady_clock::now();
+  test_request_pending = false;
+  if (!message.parse(raw)) {
+    n_errors++;
+    return;
+  }
+  FixMsgType type = message.type();
+  uint64_t msg_seq = message.seq();
+  if (FixMsgType::SEQUENCE_RESET == type) {
+    // GapFill или сброс: следующий ожидаемый номер - NewSeqNo
+    uint64_t new_seq = message.get_u64(FixTag::NEW_SEQ_NO);
+    if (new_seq > seq[IN]) {
+      seq[IN] = new_seq;
+    }
+    if (new_seq >= gap_end) {
+      gap_begin = gap_end = 0;
+    }
+    return;
+  }
+  if (msg_seq > seq[IN]) {
+    // Разрыв: пропущенные сообщения запрашиваются, текущее обрабатывается
+    uint64_t begin = seq[IN];
+    gap_begin = begin;
+    gap_end = msg_seq;
+    n_resend_requests++;
+    send(FixMsgType::RESEND_REQUEST, [begin](FixWriter &w, uint64_t) {
+      w.field(FixTag::BEGIN_SEQ_NO, begin).field(FixTag::END_SEQ_NO, uint64_t{0});
+    });
+    seq[IN] = msg_seq + 1;
+  }
+  else if (msg_seq < seq[IN]) {
+    bool poss_dup = ("Y" == message.get(FixTag::POSS_DUP_FLAG));
+    if (poss_dup && (msg_seq >= gap_begin) && (msg_seq < gap_end)) {
+      // Повтор пропущенного сообщения по ResendRequest
+      process(type, raw);
+      return;
+    }
+    if (!poss_dup) {
+      n_errors++;
+      send(FixMsgType::LOGOUT, [](FixWriter &w, uint64_t) { w.field(FixTag::TEXT, std::string_view("MsgSeqNum too low")); });
+      connected = false;
+    }
+    return;
+  }
+  else {
+    seq[IN]++;
+  }
+  process(type, raw);
+}
+
+void FixSession::process(FixMsgType type, std::string_view raw) {
+  switch (type) {
+    case FixMsgType::TEST_REQUEST: {
+      std::string_view test_id = message.get(FixTag::TEST_REQ_ID);
+      n_heartbeats++;
+      send(FixMsgType::HEARTBEAT, [test_id](FixWriter &w, uint64_t) { w.field(FixTag::TEST_REQ_ID, test_id); });
+      break;
+    }
+    case FixMsgType::RESEND_REQUEST: {
+      // Ордера повторно не отправляются: весь запрошенный диапазон закрывается GapFill
+      uint64_t begin = message.get_u64(FixTag::BEGIN_SEQ_NO);
+      n_gap_fills++;
+      std::lock_guard<std::mutex> lock(send_mtx);
+      uint64_t next = seq[OUT];
+      uint64_t now_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+      std::string sending_time{fix_time(now_us)};
+      writer.begin(FixMsgType::SEQUENCE_RESET, config.sender_comp_id, config.target_comp_id, begin, sending_time);
+      // PossDupFlag=Y требует OrigSendingTime: исходных сообщений нет, поэтому - текущее SendingTime
+      writer.field(FixTag::POSS_DUP_FLAG, 'Y').field(FixTag::ORIG_SENDING_TIME, std::string_view(sending_time));
+      writer.field(FixTag::GAP_FILL_FLAG, 'Y').field(FixTag::NEW_SEQ_NO, next);
+      std::string_view data = writer.finish();
+      n_sent++;
+      if (!conn.write(data.data(), data.size())) {
+        connected = false;
+      }
+      break;
+    }
+    case FixMsgType::LOGON:
+      logged_on = true;
+      pending.complete(logon_seq, raw);
+      break;
+    case FixMsgType::LOGOUT:
+      if (!logged_on) {
+        pending.complete(logon_seq, raw);
+      }
+      else {
+        send(FixMsgType::LOGOUT, [](FixWriter &, uint64_t) {});
+      }
+      logged_on = false;
+      connected = false;
+      break;
+    case FixMsgType::EXECUTION_REPORT:
+      if (decode_execution_report(message, report)) {
+        if ('8' == report.exec_type) {
+          n_rejects++;
+        }
+        pending.complete(request_id(report.cl_ord_id), raw);
+        if (execution_cb) {
+          execution_cb(report);
+        }
+      }
+      break;
+    case FixMsgType::ORDER_CANCEL_REJECT:
+      n_rejects++;
+      pending.complete(request_id(message.get(FixTag::CL_ORD_ID)), raw);
+      break;
+    case FixMsgType::REJECT:
+      n_rejects++;
+      pending.complete(message.get_u64(FixTag::REF_SEQ_NUM), raw);
+      break;
+    default:
+      break;
+  }
+}
+
+void FixSession::check_heartbeat(std::chrono::steady_clock::time_point now) {
+  auto interval = std::chrono::seconds(config.heartbeat_sec);
+  auto sent = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(last_sent.load()));
+  if (now - sent >= interval) {
+    n_heartbeats++;
+    send(FixMsgType::HEARTBEAT, [](FixWriter &, uint64_t) {});
+  }
+  if (test_request_pending) {
+    if (now - test_request_sent >= interval) {
+      // Сервер не ответил на TestRequest
+      connected = false;
+    }
+  }
+  else if (now - last_received >= interval + interval / 5) {
+    n_test_requests++;
+    test_request_pending = true;
+    test_request_sent = now;
+    send(FixMsgType::TEST_REQUEST, [](FixWriter &w, uint64_t msg_seq) {
+      w.field(FixTag::TEST_REQ_ID, msg_seq);
+    });
+  }
+}
+
+std::string_view FixSession::cl_ord_id(char *buffer, uint64_t msg_seq) const {
+  size_t size = session_tag.copy(buffer, 32);
+  buffer[size++] = '-';
+  auto [end, ec] = std::to_chars(buffer + size, buffer + size + 24, msg_seq);
+  return std::string_view(buffer, end - buffer);
+}
+
+uint64_t FixSession::request_id(std::string_view cl_ord_id) const {
+  // ClOrdID = "<сессия>-<MsgSeqNum>"
+  size_t pos = cl_ord_id.rfind('-');
+  if ((std::string_view::npos == pos) || (cl_ord_id.substr(0, pos) != session_tag)) {
+    return 0;
+  }
+  uint64_t id{0};
+  std::from_chars(cl_ord_id.data() + pos + 1, cl_ord_id.data() + cl_ord_id.size(), id);
+  return id;
+}
+
+FixSession::~FixSession() {
+  logout();
+  if (seq != seq_memory) {
+    munmap(seq, sizeof(seq_memory));
+  }
+  if (0 <= seq_fd) {
+    ::close(seq_fd);
+  }
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <functional>
+
+#include "../binance/binance_type.hpp"
+#include "../stream/tcp_connection.hpp"
+#include "../utils/ring_buffer.hpp"
+#include "../utils/ed25519.hpp"
+#include "../utils/pending_table.hpp"
+#include "./fix_codec.hpp"
+
+/// @brief Настройки FIX сессии
+struct FixSessionConfig {
+  std::string host{"fix-oe.binance.com"};
+  int port{9000};
+  bool tls{true};
+  std::string sender_comp_id{"BNCPP"}; // SenderCompID (произвольный, уникальный среди сессий ключа)
+  std::string target_comp_id{"SPOT"};
+  int heartbeat_sec{30}; // HeartBtInt
+  bool reset_on_logon{true}; // ResetSeqNumFlag=Y в Logon (Binance требует Y)
+  std::string seq_store{}; // Файл номеров последовательности (пусто - только в памяти)
+  int message_handling{2}; // MessageHandling: 1 - UNORDERED, 2 - SEQUENTIAL
+  int timeout_ms{def_timeout_ms}; // Ожидание ответа на запрос
+  size_t max_pending{1024}; // Одновременных запросов (округляется вверх до степени двойки)
+  int spin{2000}; // Итераций активного ожидания ответа до засыпания потока
+  size_t buffer_size{1 << 16};
+};
+
+/// @brief Статистика FIX сессии
+struct FixSessionStats {
+  uint64_t sent{0};
+  uint64_t received{0};
+  uint64_t heartbeats{0}; // Отправлено Heartbeat
+  uint64_t test_requests{0}; // Отправлено TestRequest
+  uint64_t resend_requests{0}; // Отправлено ResendRequest (обнаружен разрыв входящих MsgSeqNum)
+  uint64_t gap_fills{0}; // Ответов SequenceReset-GapFill на ResendRequest сервера
+  uint64_t rejects{0}; // Reject / OrderCancelReject / ExecutionReport REJECTED
+  uint64_t timeouts{0};
+  uint64_t errors{0}; // Сообщений с ошибкой формата или CheckSum
+};
+
+/// @brief FIX 4.4 сессия размещения ордеров Binance (FIX API, TLS).
+/// Logon подписывается ключом Ed25519 (RawData), дальше сообщения не подписываются.
+/// Поток чтения отвечает на TestRequest, отправляет Heartbeat в паузах и TestRequest при молчании
+/// сервера, при разрыве входящих MsgSeqNum запрашивает ResendRequest, на ResendRequest сервера
+/// отвечает SequenceReset-GapFill (ордера повторно не отправляются). Номера последовательности
+/// хранятся в отображенном в память файле seq_store и переживают перезапуск процесса.
+/// create_order / cancel_order повторяют Binance::create_order / cancel_order: ответ (первый
+/// ExecutionReport, OrderCancelReject или Reject) сопоставляется с запросом по ClOrdID (= "<сессия>-<MsgSeqNum>")
+/// через таблицу ожидающих запросов без блокировок. Все ExecutionReport (в т.ч. последующие сделки)
+/// передаются обработчику on_execution из потока чтения.
+class FixSession {
+private:
+  enum SeqIndex {
+    OUT = 0, // Следующий исходящий MsgSeqNum
+    IN = 1 // Ожидаемый входящий MsgSeqNum
+  };
+
+  Auth auth;
+  Ed25519Signer signer;
+  FixSessionConfig config;
+  TcpConnection conn;
+  RingBuffer ring;
+  std::mutex send_mtx; // conn (запись), writer, sending_time, seq[OUT]
+  FixWriter writer{};
+  std::string sending_time{}; // SendingTime отправляемого сообщения
+  PendingTable pending;
+  uint64_t *seq{nullptr};
+  uint64_t seq_memory[2]{1, 1};
+  int seq_fd{-1};
+  std::string session_tag{};
+  std::atomic<bool> connected{false};
+  std::atomic<bool> logged_on{false};
+  std::atomic<uint64_t> logon_seq{0};
+  std::thread reader{};
+  std::function<void(const FixExecutionReport&)> execution_cb{};
+  // Только поток чтения
+  FixMessage message{};
+  FixExecutionReport report{};
+  uint64_t gap_begin{0};
+  uint64_t gap_end{0};
+  std::chrono::steady_clock::time_point last_received{};
+  std::chrono::steady_clock::time_point test_request_sent{};
+  bool test_request_pending{false};
+  std::atomic<int64_t> last_sent{0}; // steady_clock, тики
+  std::atomic<uint64_t> n_sent{0};
+  std::atomic<uint64_t> n_received{0};
+  std::atomic<uint64_t> n_heartbeats{0};
+  std::atomic<uint64_t> n_test_requests{0};
+  std::atomic<uint64_t> n_resend_requests{0};
+  std::atomic<uint64_t> n_gap_fills{0};
+  std::atomic<uint64_t> n_rejects{0};
+  std::atomic<uint64_t> n_timeouts{0};
+  std::atomic<uint64_t> n_errors{0};
+
+  bool open_seq_store();
+  void read_loop();
+  void dispatch(std::string_view raw);
+  void process(FixMsgType type, std::string_view raw);
+  void check_heartbeat(std::chrono::steady_clock::time_point now);
+  std::string_view cl_ord_id(char *buffer, uint64_t msg_seq) const;
+  uint64_t request_id(std::string_view cl_ord_id) const;
+  Order wait_order(uint64_t id);
+
+  /// @brief Отправка сообщения со следующим MsgSeqNum
+  /// @param body Заполнение тела: body(FixWriter&, MsgSeqNum); SendingTime заголовка - sending_time
+  /// @param claim Занять ячейку ожидания ответа с id = MsgSeqNum
+  /// @return MsgSeqNum; 0 - ошибка отправки или нет свободной ячейки
+  template<typename F>
+  uint64_t send(FixMsgType type, F &&body, bool claim = false) {
+    std::lock_guard<std::mutex> lock(send_mtx);
+    if (!conn.valid()) {
+      return 0;
+    }
+    uint64_t msg_seq = seq[OUT];
+    if (claim && !pending.claim(msg_seq, std::chrono::milliseconds(config.timeout_ms))) {
+      return 0;
+    }
+    uint64_t now_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    sending_time = fix_time(now_us);
+    writer.begin(type, config.sender_comp_id, config.target_comp_id, msg_seq, sending_time);
+    body(writer, msg_seq);
+    std::string_view data = writer.finish();
+    seq[OUT]++;
+    last_sent = std::chrono::steady_clock::now().time_since_epoch().count();
+    n_sent++;
+    if (!conn.write(data.data(), data.size())) {
+      if (claim) {
+        pending.fail(msg_seq);
+      }
+      connected = false;
+    }
+    return msg_seq;
+  }
+public:
+  /// @brief Конструктор сессии
+  /// @param key Ключи доступа (api_key - Username в Logon)
+  /// @param ed25519_pem Закрытый ключ Ed25519 (PEM) для подписи Logon
+  /// @param config Настройки
+  FixSession(Auth key, const std::string &ed25519_pem, FixSessionConfig config = FixSessionConfig{});
+  FixSession(const FixSession&) = delete;
+  FixSession& operator=(const FixSession&) = delete;
+
+  /// @brief Обработчик всех ExecutionReport (устанавливается до logon)
+  void on_execution(std::function<void(const FixExecutionReport&)> callback) { execution_cb = callback; }
+
+  /// @brief Подключение и Logon
+  /// @return Status (code 0 - успех)
+  Status logon();
+
+  /// @brief Logout и закрытие соединения
+  void logout();
+
+  /// @brief Сессия авторизована
+  bool is_logged_on() const { return logged_on; }
+
+  /// @brief Создать лимитный ордер (NewOrderSingle)
+  /// @param order Ордер для создания
+  /// @return - Новый ордер (по первому ExecutionReport)
+  /// @exception BinanceException
+  Order create_order(Order &order);
+
+  /// @brief Отмена ордера (OrderCancelRequest)
+  /// @param symbol Торговая пара
+  /// @param order_id Id ордера
+  /// @return - Отмененный Ордер
+  /// @exception BinanceException
+  Order cancel_order(const std::string &symbol, const uint64_t &order_id);
+
+  /// @brief Следующий исходящий и ожидаемый входящий MsgSeqNum
+  std::pair<uint64_t, uint64_t> sequence() const { return {seq[OUT], seq[IN]}; }
+
+  /// @brief Статистика сессии
+  FixSessionStats stats() const;
+
+  ~FixSession();
+};
@@ -1,26 +1,76 @@
 #include "request.hpp"
 
 Request::Request(std::string host, int port) : _host(host), _port(port) {
-  CURLcode res = curl_global_init(CURL_GLOBAL_DEFAULT);
+  CURLcode res = global_init();
   assertm(CURLcode::CURLE_OK == res, "CURLE_FAILED_INIT");
 }
 
-RequestResult Request::request(RequestType r_type, std::string path, headerparams h_params, urlparams u_params) {
+CURLcode Request::global_init() {
+  // curl_global_init не потокобезопасна и дорога: один вызов на процесс (инициализация static потокобезопасна).
+  // curl_global_cleanup не вызывается: кэш соединений и easy handle потоков живут до конца процесса
+  static const CURLcode code = curl_global_init(CURL_GLOBAL_DEFAULT);
+  return code;
+}
+
+CURLSH *Request::share() {
+  static CURLSH *handle = []() {
+    global_init();
+    CURLSH *sh = curl_share_init();
+    curl_share_setopt(sh, CURLSHOPT_LOCKFUNC, Request::share_lock);
+    curl_share_setopt(sh, CURLSHOPT_UNLOCKFUNC, Request::share_unlock);
+    curl_share_setopt(sh, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    curl_share_setopt(sh, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(sh, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    return sh;
+  }();
+  return handle;
+}
+
+namespace {
+
+std::mutex share_mutex[CURL_LOCK_DATA_LAST];
+
+/// @brief Easy handle потока: создается первым запросом потока и сбрасывается (curl_easy_reset) перед каждым следующим,
+/// поэтому запрос не выделяет и не освобождает handle, а handle не используется двумя потоками одновременно
+struct ThreadSession {
+  CURL *session{curl_easy_init()};
+  ThreadSession() = default;
+  ThreadSession(const ThreadSession&) = delete;
+  ThreadSession& operator=(const ThreadSession&) = delete;
+  ~ThreadSession() {
+    if (nullptr != session) {
+      curl_easy_cleanup(session);
+    }
+  }
+};
+
+}
+
+void Request::share_lock(CURL *, curl_lock_data data, curl_lock_access, void *) {
+  share_mutex[data].lock();
+}
+
+void Request::share_unlock(CURL *, curl_lock_data data, void *) {
+  share_mutex[data].unlock();
+}
+
+RequestResult Request::request(RequestType r_type, const std::string &path, const headerparams &h_params, const urlparams &u_params) {
   RequestResult result;
-  CURL *session{nullptr};
-  session = curl_easy_init();
+  thread_local ThreadSession thread_session{};
+  CURL *session{thread_session.session};
   if (session) {
+    curl_easy_reset(session);
     struct curl_slist *header{nullptr};
     CURLcode res;
     std::string header_buffer{};
     std::string body_buffer{};
     std::string url_prm{};
-    curl_easy_setopt(session, CURLOPT_CUSTOMREQUEST, req_type_to_str(r_type).c_str());
+    curl_easy_setopt(session, CURLOPT_CUSTOMREQUEST, req_type_to_str(r_type).data());
     if (RequestType::GET == r_type) { //GET
       url_prm = u_params.empty() ? "" : std::format("?{}", u_params.url_params);
       curl_easy_setopt(session, CURLOPT_URL, std::string(_host + path + url_prm).c_str());
     }
-    else { //POST or DELETE
+    else { //POST, PUT or DELETE
       url_prm = u_params.empty() ? "" : std::format("{}", u_params.url_params);
       curl_easy_setopt(session, CURLOPT_URL, std::string(_host+path).c_str());
       curl_easy_setopt(session, CURLOPT_POSTFIELDS, url_prm.c_str());
@@ -43,11 +93,17 @@ RequestResult Request::request(RequestType r_type, std::string path, headerparam
     #endif
 */
       curl_easy_setopt(session, CURLOPT_CA_CACHE_TIMEOUT, 604800L);
+      curl_easy_setopt(session, CURLOPT_SHARE, share());
+      curl_easy_setopt(session, CURLOPT_MAXCONNECTS, max_connections);
       res = curl_easy_perform(session);
       if (res == CURLE_OK) {
         result.header = parse_header(header_buffer);
         result.transport = Status(static_cast<int>(res), std::string(curl_easy_strerror(res)));
-        result.body = body_buffer;
+        result.body = std::move(body_buffer);
+        char *content_type{nullptr};
+        if ((CURLE_OK == curl_easy_getinfo(session, CURLINFO_CONTENT_TYPE, &content_type)) && (nullptr != content_type)) {
+          result.content_type = content_type;
+        }
       }
       else {
         result.transport = Status(static_cast<int>(res), std::string(curl_easy_strerror(res)));
@@ -57,7 +113,6 @@ RequestResult Request::request(RequestType r_type, std::string path, headerparam
   else {
     result.transport = Status(2, std::string("CURL INIT FAILED"));
   }
-  curl_easy_cleanup(session);
   return result;
 }
 
@@ -77,7 +132,8 @@ Status Request::parse_header(const std::string header_raw) {
   if (header_raw.empty()) {
     return Status(-1, std::string("No header data"));
   } 
-  std::regex status_regex("^(HTTP/\\d.\\d) (\\d{3}) (.+)");
+  // Регулярное выражение компилируется один раз; поиск по const regex потокобезопасен
+  static const std::regex status_regex("^(HTTP/\\d.\\d) (\\d{3}) (.+)");
   std::smatch status_match;
   std::istringstream stream(header_raw);
   std::string line;
@@ -91,36 +147,13 @@ Status Request::parse_header(const std::string header_raw) {
   return Status(-1, std::string("Header data is not valid"));
 }
 
-  std::string Request::req_type_to_str(RequestType r_type) {
-    std::map<RequestType, std::string> req_map {
-      {RequestType::NONE, std::string{"NONE"}},
-      {RequestType::GET, std::string{"GET"}},
-      {RequestType::POST, std::string{"POST"}},
-      {RequestType::DELETE, std::string{"DELETE"}}
-    };
-    if (req_map.find(r_type) != req_map.end()) {
-      return req_map[r_type];
-    }
-    else {
-      return std::string{"NONE"};
-    }
-  }
+std::string_view Request::req_type_to_str(RequestType r_type) {
+  // Имена таблицы - строковые литералы, data() оканчивается нулем
+  return request_type_names.to_str(r_type, "NONE");
+}
 
-  RequestType Request::str_to_req_type(std::string r_type) {
-    std::map<std::string, RequestType> req_map {
-      {std::string{"NONE"}, RequestType::NONE},
-      {std::string{"GET"}, RequestType::GET},
-      {std::string{"POST"}, RequestType::POST},
-      {std::string{"DELETE"}, RequestType::DELETE}
-    };
-    if (req_map.find(r_type) != req_map.end()) {
-      return req_map[r_type];
-    }
-    else {
-      return RequestType::NONE;
-    }
-  };
+RequestType Request::str_to_req_type(std::string_view r_type) {
+  return request_type_names.from_str(r_type, RequestType::NONE);
+}
 
-Request::~Request() {
-  curl_global_cleanup();
-}
\ No newline at end of file
+Request::~Request() {}
\ No newline at end of file
@@ -3,31 +3,55 @@
 #include <string>
 #include <format>
 #include <vector>
+#include <string_view>
 #include <regex>
+#include <mutex>
 #include <curl/curl.h>
 #include <cassert>
 
+#include "../utils/enum_table.hpp"
+
 #define assertm(exp, msg) assert(((void)msg, exp))
 
 /// @brief Ожидание ответа от сервера
 const int def_timeout_ms = 5000;
+/// @brief Keep-alive соединений в общем кэше (не меньше параллельных запросов create_orders/cancel_all)
+const long max_connections = 64;
 
 
 enum class RequestType {
     NONE = 0,
     GET = 1,
     POST = 2,
-    DELETE = 3
+    DELETE = 3,
+    PUT = 4
 };
 
+inline constexpr auto request_type_names = make_enum_table<RequestType>({
+  {RequestType::NONE, "NONE"},
+  {RequestType::GET, "GET"},
+  {RequestType::POST, "POST"},
+  {RequestType::DELETE, "DELETE"},
+  {RequestType::PUT, "PUT"}
+});
+
 template<typename v>
 static std::string type_to_str(v val) {
   if constexpr (std::is_same_v<v, bool>) {
     return std::format("{}", val);
   }
-  std::ostringstream strm_v;
-  strm_v << val;
-  return strm_v.str();
+  else if constexpr (std::is_convertible_v<v, std::string_view>) {
+    // Строки копируются без потока
+    return std::string{std::string_view{val}};
+  }
+  else if constexpr (std::is_integral_v<v> && !std::is_same_v<v, char>) {
+    return std::to_string(val);
+  }
+  else {
+    std::ostringstream strm_v;
+    strm_v << val;
+    return strm_v.str();
+  }
 };
 
 /// @brief Структура(IN) для добавление параметров Header
@@ -38,7 +62,10 @@ struct headerparams {
   /// @param val Значение, переменная шаблона(конвертируется в std::string)
   template<typename k, typename v>
   void add(k key, v val) {
-    header_params.push_back(std::string(std::format("{}: {}", type_to_str(key), type_to_str(val))));
+    std::string line{type_to_str(key)};
+    line += ": ";
+    line += type_to_str(val);
+    header_params.push_back(std::move(line));
   };
 };
 /// @brief Структура(IN) для добавление параметров параметров URL
@@ -54,11 +81,13 @@ struct urlparams {
     if (!url_params.empty()) {
       url_params += "&";
     }
-    url_params += std::string(std::format("{}={}", type_to_str(key), type_to_str(val)));
+    url_params += type_to_str(key);
+    url_params += '=';
+    url_params += type_to_str(val);
   }
   /// @brief Проверка на наличие параметров URL
   /// @return bool True - данных нет; False - Данные есть
-  bool empty() {
+  bool empty() const {
     return url_params.empty();
   }
 };
@@ -75,10 +104,15 @@ struct RequestResult {
   Status header{}; // Код и расшифровка статуса запроса HTTPS запроса(Берется из Header)
   Status transport{}; // Код и расшифровка статуса транспорта(CURL)
   std::string body{""}; // "Тело ответа" сервера
+  std::string content_type{}; // Content-Type ответа (application/json, application/sbe)
 };
 
 
-/// @brief Класс-обёртка(CURL) реализующие HTTPS запросы GET, POST, DELETE
+/// @brief Класс-обёртка(CURL) реализующие HTTPS запросы GET, POST, DELETE.
+/// Все объекты Request разделяют кэш соединений, DNS и TLS сессий (CURLSH): новый Request на каждый вызов
+/// переиспользует уже открытое keep-alive соединение с тем же host:port вместо нового TCP и TLS рукопожатия.
+/// libcurl инициализируется один раз на процесс, easy handle - один на поток (запросы разных потоков не делят handle),
+/// поэтому Request можно создавать в любом потоке на каждый вызов.
 class Request {
 private:
   std::string _host;
@@ -86,8 +120,12 @@ private:
   static size_t data_callback(char *contents, size_t size, size_t nmemb, void *userp);
   curl_slist* header_generate(const headerparams& r_params, curl_slist *h_struct);
   Status parse_header(const std::string header_raw);
-  std::string req_type_to_str(RequestType r_type);
-  RequestType str_to_req_type(std::string r_type);
+  std::string_view req_type_to_str(RequestType r_type);
+  RequestType str_to_req_type(std::string_view r_type);
+  static CURLcode global_init();
+  static CURLSH *share();
+  static void share_lock(CURL *handle, curl_lock_data data, curl_lock_access access, void *userp);
+  static void share_unlock(CURL *handle, curl_lock_data data, void *userp);
 public:
   /// @brief Конструктор класса Request
   /// @param host Адресс ресурса
@@ -98,6 +136,6 @@ public:
   /// @param h_params Параметры хедера
   /// @param u_params параметры URL
   /// @return RequestResult структура с ответом и статусами
-  RequestResult request(RequestType r_type, std::string path, headerparams h_params, urlparams u_params);
+  RequestResult request(RequestType r_type, const std::string &path, const headerparams &h_params, const urlparams &u_params);
   ~Request();
 };
@@ -0,0 +1,167 @@
+#include "depth_decoder.hpp"
+
+#include <bit>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "./json_scan.hpp"
+#include "../utils/fast_decimal.hpp"
+
+namespace {
+
+int64_t scale_value(int64_t value, int64_t unit) {
+  return (1 == unit) ? value : value / unit;
+}
+
+#if defined(__SSE2__)
+/// @brief Маски выравнивания: 16 байт из keep_mask + len отмечают последние len байт
+alignas(16) const int8_t keep_mask[32]{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                       -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+
+/// @brief Число фиксированного формата "IIIIIII.FFFFFFFF" (1-7 цифр целой части, 8 дробной) в единицах 1e-8.
+/// Читаются 16 байт, заканчивающиеся на последней цифре (begin - граница допустимого чтения),
+/// байты перед числом заменяются на '0', поэтому точка всегда в байте 7.
+bool parse_fixed8_sse2(const char *str, size_t len, const char *begin, int64_t &value) {
+  if ((len < 10) || (len > 16) || ('.' != str[len - 9])) {
+    return false;
+  }
+  __m128i chars{};
+  if (str + len >= begin + 16) {
+    chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + len - 16));
+  }
+  else {
+    alignas(16) char buffer[16]{};
+    std::memcpy(buffer + 16 - len, str, len);
+    chars = _mm_load_si128(reinterpret_cast<const __m128i*>(buffer));
+  }
+  __m128i keep = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keep_mask + len));
+  chars = _mm_or_si128(_mm_and_si128(keep, chars), _mm_andnot_si128(keep, _mm_set1_epi8('0')));
+  __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+  __m128i bad = _mm_or_si128(_mm_cmplt_epi8(digits, _mm_setzero_si128()), _mm_cmpgt_epi8(digits, _mm_set1_epi8(9)));
+  if (0x0080 != _mm_movemask_epi8(bad)) {
+    return false;
+  }
+  digits = _mm_and_si128(digits, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, 0, -1, -1, -1, -1, -1, -1, -1, -1));
+  // Цифры -> пары -> четверки: 4 x int32 (целая часть * 10 в первых двух, дробная - в последних)
+  __m128i pairs_lo = _mm_madd_epi16(_mm_unpacklo_epi8(digits, _mm_setzero_si128()), _mm_setr_epi16(10, 1, 10, 1, 10, 1, 10, 1));
+  __m128i pairs_hi = _mm_madd_epi16(_mm_unpackhi_epi8(digits, _mm_setzero_si128()), _mm_setr_epi16(10, 1, 10, 1, 10, 1, 10, 1));
+  __m128i quads = _mm_madd_epi16(_mm_packs_epi32(pairs_lo, pairs_hi), _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+  int64_t integer = (int64_t{_mm_cvtsi128_si32(quads)} * 10000 + _mm_cvtsi128_si32(_mm_shuffle_epi32(quads, 1))) / 10;
+  int64_t fraction = int64_t{_mm_cvtsi128_si32(_mm_shuffle_epi32(quads, 2))} * 10000 + _mm_cvtsi128_si32(_mm_shuffle_epi32(quads, 3));
+  value = integer * 100000000 + fraction;
+  return true;
+}
+#endif
+
+bool parse_number(const char *str, size_t len, const char *begin, int64_t &value) {
+#if defined(__SSE2__)
+  if (parse_fixed8_sse2(str, len, begin, value)) {
+    return true;
+  }
+#endif
+  return str_to_fixed<8>(std::string_view(str, len), value);
+}
+
+}
+
+bool decode_levels(std::string_view raw, DepthLevels &levels, DepthScale scale) {
+  levels.clear();
+  levels.reserve(raw.size() / 20);
+  const char *data = raw.data();
+  size_t size = raw.size();
+  size_t open{std::string_view::npos};
+  int64_t values[2]{0, 0};
+  int field{0};
+  auto on_quote = [&](size_t quote) {
+    if (std::string_view::npos == open) {
+      open = quote;
+      return true;
+    }
+    if (!parse_number(data + open + 1, quote - open - 1, data, values[field])) {
+      return false;
+    }
+    open = std::string_view::npos;
+    if (1 == field) {
+      levels.price.push_back(scale_value(values[0], scale.tick));
+      levels.qty.push_back(scale_value(values[1], scale.lot));
+    }
+    field ^= 1;
+    return true;
+  };
+  size_t pos{0};
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('"');
+  for (; pos + 16 <= size; pos += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, quote)));
+    while (0 != mask) {
+      if (!on_quote(pos + std::countr_zero(mask))) {
+        return false;
+      }
+      mask &= mask - 1;
+    }
+  }
+#endif
+  for (; pos < size; pos++) {
+    if (('"' == data[pos]) && !on_quote(pos)) {
+      return false;
+    }
+  }
+  return (0 == field) && (std::string_view::npos == open);
+}
+
+bool decode_levels_scalar(std::string_view raw, DepthLevels &levels, DepthScale scale) {
+  levels.clear();
+  size_t pos{0};
+  size_t end = raw.size();
+  int64_t values[2]{0, 0};
+  int field{0};
+  while (pos < end) {
+    if ('"' != raw[pos]) {
+      pos++;
+      continue;
+    }
+    size_t close = raw.find('"', pos + 1);
+    if (std::string_view::npos == close) {
+      return false;
+    }
+    if (!str_to_fixed<8>(raw.substr(pos + 1, close - pos - 1), values[field])) {
+      return false;
+    }
+    if (1 == field) {
+      levels.price.push_back(scale_value(values[0], scale.tick));
+      levels.qty.push_back(scale_value(values[1], scale.lot));
+    }
+    field ^= 1;
+    pos = close + 1;
+  }
+  return 0 == field;
+}
+
+bool decode_depth_snapshot(std::string_view body, DepthSnapshot &snapshot) {
+  JsonScanner scanner{body};
+  std::string_view key{};
+  std::string_view value{};
+  int fields{0};
+  while (scanner.next(key, value)) {
+    if ("lastUpdateId" == key) {
+      snapshot.last_update_id = json_to_u64(value);
+      fields++;
+    }
+    else if ("bids" == key) {
+      if (!decode_levels(value, snapshot.bids)) {
+        return false;
+      }
+      fields++;
+    }
+    else if ("asks" == key) {
+      if (!decode_levels(value, snapshot.asks)) {
+        return false;
+      }
+      fields++;
+    }
+  }
+  return 3 == fields;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+/// @brief Уровни стакана (SoA): цены и количества целыми в единицах 1e-8
+/// (представление dec::decimal<8>::getUnbiased)
+struct DepthLevels {
+  std::vector<int64_t> price{};
+  std::vector<int64_t> qty{};
+
+  void reserve(size_t count) {
+    this->price.reserve(count);
+    this->qty.reserve(count);
+  }
+
+  void clear() {
+    this->price.clear();
+    this->qty.clear();
+  }
+
+  size_t size() const {
+    return this->price.size();
+  }
+};
+
+/// @brief Снимок стакана (/api/v3/depth)
+struct DepthSnapshot {
+  uint64_t last_update_id{0};
+  DepthLevels bids{};
+  DepthLevels asks{};
+};
+
+/// @brief Масштаб уровней стакана: цена делится на tick, количество на lot
+/// (tick и lot в единицах 1e-8; 1 - значения остаются в единицах 1e-8)
+struct DepthScale {
+  int64_t tick{1};
+  int64_t lot{1};
+};
+
+/// @brief Разбор массива уровней стакана [["price","qty"],...] в DepthLevels.
+/// Кавычки ищутся блоками по 16 байт (SSE2), числа фиксированного формата
+/// (до 7 знаков целой части и ровно 8 дробной, как в ответах Binance) преобразуются
+/// в целое векторно, остальные - скалярным разбором.
+/// Буферы levels очищаются, но их память переиспользуется.
+/// @param raw Массив уровней (JSON)
+/// @param levels Результат
+/// @param scale Масштаб (цены в тиках, количества в лотах)
+/// @return True - успех; False - массив некорректен
+bool decode_levels(std::string_view raw, DepthLevels &levels, DepthScale scale = DepthScale{});
+
+/// @brief Скалярный разбор массива уровней стакана (без SIMD), результат совпадает с decode_levels
+bool decode_levels_scalar(std::string_view raw, DepthLevels &levels, DepthScale scale = DepthScale{});
+
+/// @brief Разбор ответа /api/v3/depth в снимок стакана (без построения JSON DOM)
+/// @param body Тело ответа сервера
+/// @param snapshot Результат
+/// @return True - успех; False - ответ некорректен
+bool decode_depth_snapshot(std::string_view body, DepthSnapshot &snapshot);
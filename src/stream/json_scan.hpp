@@ -0,0 +1,156 @@
+#pragma once
+
+#include <string_view>
+#include <cstdint>
+#include <charconv>
+
+/// @brief Последовательный разбор полей JSON объекта (или элементов массива) без построения DOM и без копирования.
+/// Выдает пары ключ/значение верхнего уровня объекта: для строк - содержимое без кавычек
+/// (escape-последовательности не раскрываются), для чисел/true/false/null - сам токен,
+/// для вложенных объектов и массивов - весь фрагмент вместе со скобками.
+class JsonScanner {
+private:
+  std::string_view src;
+  size_t pos{0};
+
+  void skip_ws() {
+    while ((pos < src.size()) && ((' ' == src[pos]) || ('\n' == src[pos]) || ('\r' == src[pos]) || ('\t' == src[pos]))) {
+      pos++;
+    }
+  }
+
+  bool read_string(std::string_view &value) {
+    if ((pos >= src.size()) || ('"' != src[pos])) {
+      return false;
+    }
+    size_t start = ++pos;
+    while (pos < src.size()) {
+      if ('\\' == src[pos]) {
+        pos += 2;
+        continue;
+      }
+      if ('"' == src[pos]) {
+        value = src.substr(start, pos - start);
+        pos++;
+        return true;
+      }
+      pos++;
+    }
+    return false;
+  }
+
+  bool skip_nested(std::string_view &value) {
+    size_t start = pos;
+    int depth{0};
+    while (pos < src.size()) {
+      char c = src[pos];
+      if ('"' == c) {
+        std::string_view tmp{};
+        if (!read_string(tmp)) {
+          return false;
+        }
+        continue;
+      }
+      if (('{' == c) || ('[' == c)) {
+        depth++;
+      }
+      else if (('}' == c) || (']' == c)) {
+        depth--;
+        if (0 == depth) {
+          pos++;
+          value = src.substr(start, pos - start);
+          return true;
+        }
+      }
+      pos++;
+    }
+    return false;
+  }
+
+  bool skip_separator() {
+    skip_ws();
+    if ((pos < src.size()) && (',' == src[pos])) {
+      pos++;
+      skip_ws();
+    }
+    return (pos < src.size()) && ('}' != src[pos]) && (']' != src[pos]);
+  }
+
+  bool read_value(std::string_view &value) {
+    if (pos >= src.size()) {
+      return false;
+    }
+    char c = src[pos];
+    if ('"' == c) {
+      return read_string(value);
+    }
+    if (('{' == c) || ('[' == c)) {
+      return skip_nested(value);
+    }
+    size_t start = pos;
+    while ((pos < src.size()) && (',' != src[pos]) && ('}' != src[pos]) && (']' != src[pos]) && (' ' != src[pos]) && ('\n' != src[pos])) {
+      pos++;
+    }
+    value = src.substr(start, pos - start);
+    return !value.empty();
+  }
+public:
+  /// @brief Конструктор
+  /// @param object JSON объект ("{...}") или массив ("[...]")
+  explicit JsonScanner(std::string_view object) : src(object) {
+    skip_ws();
+    if ((pos < src.size()) && (('{' == src[pos]) || ('[' == src[pos]))) {
+      pos++;
+    }
+    else {
+      pos = src.size();
+    }
+  }
+
+  /// @brief Следующее поле объекта
+  /// @param key Ключ
+  /// @param value Значение
+  /// @return True - поле получено; False - конец объекта или ошибка
+  bool next(std::string_view &key, std::string_view &value) {
+    if (!skip_separator() || !read_string(key)) {
+      return false;
+    }
+    skip_ws();
+    if ((pos >= src.size()) || (':' != src[pos])) {
+      return false;
+    }
+    pos++;
+    skip_ws();
+    return read_value(value);
+  }
+
+  /// @brief Следующий элемент массива
+  /// @param value Значение
+  /// @return True - элемент получен; False - конец массива или ошибка
+  bool next(std::string_view &value) {
+    return skip_separator() && read_value(value);
+  }
+
+  /// @brief Найти поле верхнего уровня
+  /// @param object JSON объект
+  /// @param name Ключ
+  /// @param value Значение
+  /// @return True - поле найдено
+  static bool find(std::string_view object, std::string_view name, std::string_view &value) {
+    JsonScanner scanner{object};
+    std::string_view key{};
+    while (scanner.next(key, value)) {
+      if (key == name) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+/// @brief Целое без знака из токена JSON (0 - ошибка)
+static uint64_t json_to_u64(std::string_view token) {
+  uint64_t value{0};
+  std::from_chars(token.data(), token.data() + token.size(), value);
+  return value;
+}
@@ -0,0 +1,235 @@
+#include "market_stream.hpp"
+
+#include "../utils/fast_decimal.hpp"
+
+MarketStream::MarketStream(MarketStreamConfig config) : config(config), ws(config.buffer_size) {}
+
+Status MarketStream::connect(const std::vector<std::string> &streams) {
+  std::string path{"/stream"};
+  for (size_t i = 0; i < streams.size(); i++) {
+    path += (0 == i) ? "?streams=" : "/";
+    path += streams[i];
+  }
+  return ws.connect(config.host, config.port, path, config.tls);
+}
+
+bool MarketStream::subscribe(const std::vector<std::string> &streams) {
+  return send_method("SUBSCRIBE", streams);
+}
+
+bool MarketStream::unsubscribe(const std::vector<std::string> &streams) {
+  return send_method("UNSUBSCRIBE", streams);
+}
+
+bool MarketStream::send_method(const std::string &method, const std::vector<std::string> &streams) {
+  std::string params{};
+  for (auto &stream : streams) {
+    params += std::format("{}\"{}\"", params.empty() ? "" : ",", stream);
+  }
+  return ws.send_text(std::format("{{\"method\":\"{}\",\"params\":[{}],\"id\":{}}}", method, params, ++request_id));
+}
+
+int MarketStream::poll(int timeout_ms, int max_messages) {
+  return ws.poll([this](WsOpcode, std::string_view message) { dispatch(message); }, timeout_ms, max_messages);
+}
+
+void MarketStream::run() {
+  running = true;
+  while (running && (0 <= poll(100))) {}
+  running = false;
+}
+
+void MarketStream::stop() {
+  running = false;
+}
+
+void MarketStream::close() {
+  ws.close();
+}
+
+MarketStreamStats MarketStream::stats() const {
+  return MarketStreamStats{n_messages.load(), n_bytes.load(), n_events.load(), n_errors.load()};
+}
+
+void MarketStream::dispatch(std::string_view message) {
+  n_messages++;
+  n_bytes += message.size();
+  std::string_view stream{};
+  std::string_view data{message};
+  JsonScanner scanner{message};
+  std::string_view key{};
+  std::string_view value{};
+  while (scanner.next(key, value)) {
+    if ("stream" == key) {
+      stream = value;
+    }
+    else if ("data" == key) {
+      data = value;
+    }
+    else if (("result" == key) || ("id" == key)) {
+      return; // Ответ на SUBSCRIBE/UNSUBSCRIBE
+    }
+  }
+  if (message_cb) {
+    message_cb(stream);
+  }
+  // Тип события: по имени потока, иначе по полю "e"
+  std::string_view type{};
+  size_t at = stream.find('@');
+  if (std::string_view::npos != at) {
+    type = stream.substr(at + 1);
+  }
+  else if (!JsonScanner::find(data, "e", type)) {
+    type = JsonScanner::find(data, "b", value) ? std::string_view("bookTicker") : std::string_view();
+  }
+  bool ok{true};
+  if (type.starts_with("trade")) {
+    ok = decode_trade(data);
+  }
+  else if (type.starts_with("bookTicker")) {
+    ok = decode_book_ticker(data);
+  }
+  else if (type.starts_with("depth")) {
+    ok = decode_depth(data);
+  }
+  else if (type.starts_with("kline")) {
+    ok = decode_kline(data);
+  }
+  if (!ok) {
+    n_errors++;
+  }
+}
+
+bool MarketStream::decode_trade(std::string_view data) {
+  TradeEvent &ev = trade_event;
+  JsonScanner scanner{data};
+  std::string_view key{};
+  std::string_view value{};
+  int fields{0};
+  while (scanner.next(key, value)) {
+    if (1 != key.size()) {
+      continue;
+    }
+    switch (key[0]) {
+      case 'E': ev.event_time = json_to_u64(value); break;
+      case 's': ev.symbol = value; fields++; break;
+      case 't': ev.trade_id = json_to_u64(value); break;
+      case 'p': ev.price = str_to_decimal<8>(value); fields++; break;
+      case 'q': ev.qty = str_to_decimal<8>(value); fields++; break;
+      case 'T': ev.trade_time = json_to_u64(value); break;
+      case 'm': ev.buyer_maker = ("true" == value); break;
+      default: break;
+    }
+  }
+  if (3 != fields) {
+    return false;
+  }
+  if (trade_cb) {
+    n_events++;
+    trade_cb(ev);
+  }
+  return true;
+}
+
+bool MarketStream::decode_book_ticker(std::string_view data) {
+  BookTickerEvent &ev = book_ticker_event;
+  JsonScanner scanner{data};
+  std::string_view key{};
+  std::string_view value{};
+  int fields{0};
+  while (scanner.next(key, value)) {
+    if (1 != key.size()) {
+      continue;
+    }
+    switch (key[0]) {
+      case 'u': ev.update_id = json_to_u64(value); break;
+      case 's': ev.symbol = value; fields++; break;
+      case 'b': ev.bid_price = str_to_decimal<8>(value); fields++; break;
+      case 'B': ev.bid_qty = str_to_decimal<8>(value); break;
+      case 'a': ev.ask_price = str_to_decimal<8>(value); fields++; break;
+      case 'A': ev.ask_qty = str_to_decimal<8>(value); break;
+      default: break;
+    }
+  }
+  if (3 != fields) {
+    return false;
+  }
+  if (book_ticker_cb) {
+    n_events++;
+    book_ticker_cb(ev);
+  }
+  return true;
+}
+
+bool MarketStream::decode_depth(std::string_view data) {
+  DepthEvent &ev = depth_event;
+  JsonScanner scanner{data};
+  std::string_view key{};
+  std::string_view value{};
+  bool ok{true};
+  int fields{0};
+  while (scanner.next(key, value)) {
+    if (1 != key.size()) {
+      continue;
+    }
+    switch (key[0]) {
+      case 'E': ev.event_time = json_to_u64(value); break;
+      case 's': ev.symbol = value; break;
+      case 'U': ev.first_update_id = json_to_u64(value); break;
+      case 'u': ev.final_update_id = json_to_u64(value); fields++; break;
+      case 'b': ok = ok && decode_levels(value, ev.bids); fields++; break;
+      case 'a': ok = ok && decode_levels(value, ev.asks); fields++; break;
+      default: break;
+    }
+  }
+  if (!ok || (3 != fields)) {
+    return false;
+  }
+  if (depth_cb) {
+    n_events++;
+    depth_cb(ev);
+  }
+  return true;
+}
+
+bool MarketStream::decode_kline(std::string_view data) {
+  KlineEvent &ev = kline_event;
+  std::string_view value{};
+  if (JsonScanner::find(data, "E", value)) {
+    ev.event_time = json_to_u64(value);
+  }
+  std::string_view kline{};
+  if (!JsonScanner::find(data, "k", kline)) {
+    return false;
+  }
+  JsonScanner scanner{kline};
+  std::string_view key{};
+  int fields{0};
+  while (scanner.next(key, value)) {
+    if (1 != key.size()) {
+      continue;
+    }
+    switch (key[0]) {
+      case 't': ev.start_time = json_to_u64(value); break;
+      case 'T': ev.close_time = json_to_u64(value); break;
+      case 's': ev.symbol = value; fields++; break;
+      case 'i': ev.interval = value; break;
+      case 'o': ev.open = str_to_decimal<8>(value); break;
+      case 'c': ev.close = str_to_decimal<8>(value); fields++; break;
+      case 'h': ev.high = str_to_decimal<8>(value); break;
+      case 'l': ev.low = str_to_decimal<8>(value); break;
+      case 'v': ev.volume = str_to_decimal<8>(value); break;
+      case 'n': ev.trades = json_to_u64(value); break;
+      case 'x': ev.closed = ("true" == value); break;
+      default: break;
+    }
+  }
+  if (2 != fields) {
+    return false;
+  }
+  if (kline_cb) {
+    n_events++;
+    kline_cb(ev);
+  }
+  return true;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <functional>
+
+#include "./websocket.hpp"
+#include "./stream_type.hpp"
+#include "./json_scan.hpp"
+
+/// @brief Настройки подключения к потокам рыночных данных
+struct MarketStreamConfig {
+  std::string host{"stream.binance.com"};
+  int port{9443};
+  bool tls{true};
+  size_t buffer_size{def_ws_buffer_size};
+};
+
+/// @brief Статистика потока рыночных данных
+struct MarketStreamStats {
+  uint64_t messages{0}; // Принятых сообщений
+  uint64_t bytes{0}; // Принятых байт (данные сообщений)
+  uint64_t events{0}; // Переданных обработчикам событий
+  uint64_t errors{0}; // Сообщений, которые не удалось разобрать
+};
+
+/// @brief Клиент потоков рыночных данных Binance (trade, bookTicker, depth, kline) через WebSocket.
+/// Сообщения разбираются на месте в буфере приема без построения JSON DOM,
+/// типизированные события передаются обработчикам в потоке, вызывающем poll/run.
+class MarketStream {
+private:
+  MarketStreamConfig config;
+  WebSocket ws;
+  std::function<void(const TradeEvent&)> trade_cb{};
+  std::function<void(const BookTickerEvent&)> book_ticker_cb{};
+  std::function<void(const DepthEvent&)> depth_cb{};
+  std::function<void(const KlineEvent&)> kline_cb{};
+  std::function<void(std::string_view)> message_cb{};
+  TradeEvent trade_event{};
+  BookTickerEvent book_ticker_event{};
+  DepthEvent depth_event{};
+  KlineEvent kline_event{};
+  std::atomic<bool> running{false};
+  std::atomic<uint64_t> request_id{0};
+  std::atomic<uint64_t> n_messages{0};
+  std::atomic<uint64_t> n_bytes{0};
+  std::atomic<uint64_t> n_events{0};
+  std::atomic<uint64_t> n_errors{0};
+  void dispatch(std::string_view message);
+  bool decode_trade(std::string_view data);
+  bool decode_book_ticker(std::string_view data);
+  bool decode_depth(std::string_view data);
+  bool decode_kline(std::string_view data);
+  bool send_method(const std::string &method, const std::vector<std::string> &streams);
+public:
+  /// @brief Конструктор клиента потоков
+  /// @param config Настройки подключения
+  MarketStream(MarketStreamConfig config = MarketStreamConfig{});
+
+  /// @brief Обработчик сделок
+  void on_trade(std::function<void(const TradeEvent&)> callback) { trade_cb = callback; }
+  /// @brief Обработчик лучших цен
+  void on_book_ticker(std::function<void(const BookTickerEvent&)> callback) { book_ticker_cb = callback; }
+  /// @brief Обработчик изменений стакана
+  void on_depth(std::function<void(const DepthEvent&)> callback) { depth_cb = callback; }
+  /// @brief Обработчик свечей
+  void on_kline(std::function<void(const KlineEvent&)> callback) { kline_cb = callback; }
+  /// @brief Обработчик имени потока каждого сообщения (до разбора события, для статистики)
+  void on_message(std::function<void(std::string_view)> callback) { message_cb = callback; }
+
+  /// @brief Подключение к объединенному потоку (/stream?streams=...)
+  /// @param streams Имена потоков (stream_name)
+  /// @return Status (code 0 - успех)
+  Status connect(const std::vector<std::string> &streams);
+
+  /// @brief Подписка на потоки в открытом соединении (SUBSCRIBE)
+  /// @param streams Имена потоков
+  /// @return True - запрос отправлен
+  bool subscribe(const std::vector<std::string> &streams);
+
+  /// @brief Отписка от потоков в открытом соединении (UNSUBSCRIBE)
+  /// @param streams Имена потоков
+  /// @return True - запрос отправлен
+  bool unsubscribe(const std::vector<std::string> &streams);
+
+  /// @brief Прием и обработка доступных сообщений
+  /// @param timeout_ms Ожидание данных (0 - не ждать)
+  /// @param max_messages Не более сообщений за вызов (-1 - без ограничения)
+  /// @return Количество обработанных сообщений; -1 - соединение закрыто
+  int poll(int timeout_ms, int max_messages = -1);
+
+  /// @brief Обработка сообщений до вызова stop() или закрытия соединения
+  void run();
+
+  /// @brief Остановить run()
+  void stop();
+
+  /// @brief Закрыть соединение
+  void close();
+
+  /// @brief Соединение открыто
+  bool is_open() const { return ws.is_open(); }
+
+  /// @brief Дескриптор сокета
+  int fd() const { return ws.fd(); }
+
+  /// @brief Количество принятых, но еще не обработанных байт
+  size_t buffered() const { return ws.buffered(); }
+
+  /// @brief Статистика потока
+  MarketStreamStats stats() const;
+};
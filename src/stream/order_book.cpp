@@ -0,0 +1,203 @@
+#include "order_book.hpp"
+
+#include <algorithm>
+
+size_t BookSide::find(int64_t key) const {
+  size_t n = keys.size();
+  if ((0 == n) || (key > keys.back())) {
+    return n;
+  }
+  // Ключи - возрастающие целые, поэтому keys[n - 1 - j] <= keys.back() - j и позиция не меньше оценки.
+  // Для плотного стакана у вершины оценка точна, иначе - короткий проход и двоичный поиск.
+  uint64_t dist = static_cast<uint64_t>(keys.back() - key);
+  size_t pos = (dist < n) ? n - 1 - dist : 0;
+  for (size_t end = std::min(n, pos + 8); pos < end; pos++) {
+    if (keys[pos] >= key) {
+      return pos;
+    }
+  }
+  return std::lower_bound(keys.begin() + pos, keys.end(), key) - keys.begin();
+}
+
+void BookSide::set(int64_t tick, int64_t qty) {
+  int64_t key = bid ? tick : -tick;
+  size_t pos = find(key);
+  if ((pos < keys.size()) && (key == keys[pos])) {
+    if (0 == qty) {
+      keys.erase(keys.begin() + pos);
+      qtys.erase(qtys.begin() + pos);
+    }
+    else {
+      qtys[pos] = qty;
+    }
+    return;
+  }
+  if (0 == qty) {
+    return;
+  }
+  keys.insert(keys.begin() + pos, key);
+  qtys.insert(qtys.begin() + pos, qty);
+}
+
+size_t BookSide::top(size_t n, BookLevel *levels) const {
+  size_t count = std::min(n, keys.size());
+  size_t last = keys.size() - 1;
+  for (size_t i = 0; i < count; i++) {
+    levels[i] = BookLevel{bid ? keys[last - i] : -keys[last - i], qtys[last - i]};
+  }
+  return count;
+}
+
+int64_t BookSide::qty(int64_t tick) const {
+  int64_t key = bid ? tick : -tick;
+  size_t pos = find(key);
+  return ((pos < keys.size()) && (key == keys[pos])) ? qtys[pos] : 0;
+}
+
+LocalOrderBook::LocalOrderBook(const std::string &symbol, SnapshotFetch fetch, OrderBookConfig config)
+    : book_symbol(symbol), fetch(fetch), config(config) {
+  if (this->config.tick_size <= 0) {
+    this->config.tick_size = 1;
+  }
+}
+
+BookUpdate LocalOrderBook::apply(const DepthEvent &ev) {
+  if (live) {
+    if (ev.final_update_id <= last_id) {
+      book_stats.stale++;
+      return BookUpdate::STALE;
+    }
+    if (ev.first_update_id == last_id + 1) {
+      apply_levels(bids, ev.bids);
+      apply_levels(asks, ev.asks);
+      last_id = ev.final_update_id;
+      book_stats.updates++;
+      return BookUpdate::APPLIED;
+    }
+    book_stats.gaps++;
+    reset();
+    buffer_update(ev);
+    resync();
+    return BookUpdate::RESYNC;
+  }
+  buffer_update(ev);
+  if (has_snapshot) {
+    drain();
+  }
+  if (!has_snapshot) {
+    resync();
+  }
+  return live ? BookUpdate::APPLIED : BookUpdate::BUFFERED;
+}
+
+void LocalOrderBook::load(const DepthSnapshot &snapshot) {
+  bids.clear();
+  asks.clear();
+  bids.reserve(snapshot.bids.size());
+  asks.reserve(snapshot.asks.size());
+  apply_levels(bids, snapshot.bids);
+  apply_levels(asks, snapshot.asks);
+  last_id = snapshot.last_update_id;
+  has_snapshot = true;
+  live = false;
+  book_stats.snapshots++;
+  drain();
+}
+
+bool LocalOrderBook::resync() {
+  if (std::chrono::steady_clock::now() < next_snapshot) {
+    book_stats.snapshot_skipped++;
+    return false;
+  }
+  DepthSnapshot snapshot{};
+  try {
+    snapshot = fetch(book_symbol, config.snapshot_limit);
+  }
+  catch (BinanceException &) {
+    book_stats.snapshot_errors++;
+    backoff();
+    return false;
+  }
+  load(snapshot);
+  if (has_snapshot) {
+    snapshot_failures = 0;
+  }
+  else {
+    // Снимок старше буферизованных изменений: следующий запрашивается после паузы
+    backoff();
+  }
+  return live;
+}
+
+void LocalOrderBook::backoff() {
+  uint32_t shift = std::min<uint32_t>(snapshot_failures++, 16);
+  int64_t delay_ms = std::min<int64_t>(static_cast<int64_t>(config.snapshot_backoff_ms) << shift, config.snapshot_backoff_max_ms);
+  next_snapshot = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms);
+}
+
+void LocalOrderBook::drain() {
+  size_t i{0};
+  for (; i < buffered; i++) {
+    BufferedUpdate &update = buffer[i];
+    if (update.final_update_id <= last_id) {
+      book_stats.stale++;
+      continue;
+    }
+    // Первое изменение должно содержать lastUpdateId + 1, следующие - идти без разрывов
+    bool bridged = live ? (update.first_update_id == last_id + 1) : (update.first_update_id <= last_id + 1);
+    if (!bridged) {
+      break;
+    }
+    apply_levels(bids, update.bids);
+    apply_levels(asks, update.asks);
+    last_id = update.final_update_id;
+    live = true;
+    book_stats.updates++;
+  }
+  if (i < buffered) {
+    // Снимок старше буферизованных изменений: изменения сохраняются, снимок загружается заново
+    if (live) {
+      book_stats.gaps++;
+    }
+    for (size_t k = i; k < buffered; k++) {
+      std::swap(buffer[k - i], buffer[k]);
+    }
+    buffered -= i;
+    bids.clear();
+    asks.clear();
+    has_snapshot = false;
+    live = false;
+    return;
+  }
+  buffered = 0;
+}
+
+void LocalOrderBook::buffer_update(const DepthEvent &ev) {
+  if (buffered >= config.max_buffered) {
+    buffered = 0;
+  }
+  if (buffer.size() <= buffered) {
+    buffer.emplace_back();
+  }
+  BufferedUpdate &update = buffer[buffered++];
+  update.first_update_id = ev.first_update_id;
+  update.final_update_id = ev.final_update_id;
+  update.bids.price.assign(ev.bids.price.begin(), ev.bids.price.end());
+  update.bids.qty.assign(ev.bids.qty.begin(), ev.bids.qty.end());
+  update.asks.price.assign(ev.asks.price.begin(), ev.asks.price.end());
+  update.asks.qty.assign(ev.asks.qty.begin(), ev.asks.qty.end());
+}
+
+void LocalOrderBook::apply_levels(BookSide &side, const DepthLevels &levels) {
+  for (size_t i = 0; i < levels.size(); i++) {
+    side.set(levels.price[i] / config.tick_size, levels.qty[i]);
+  }
+}
+
+void LocalOrderBook::reset() {
+  bids.clear();
+  asks.clear();
+  has_snapshot = false;
+  live = false;
+  buffered = 0;
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+#include "../binance/binance_type.hpp"
+#include "./stream_type.hpp"
+
+/// @brief Уровень стакана: цена в тиках, количество в единицах 1e-8
+struct BookLevel {
+  int64_t tick{0};
+  int64_t qty{0};
+};
+
+/// @brief Результат применения изменения стакана
+enum class BookUpdate {
+  APPLIED = 0, // Изменение применено
+  BUFFERED = 1, // Стакан синхронизируется, изменение сохранено для применения после снимка
+  STALE = 2, // Изменение уже входит в стакан (u <= lastUpdateId), пропущено
+  RESYNC = 3 // Обнаружен разрыв последовательности, стакан загружен заново
+};
+
+/// @brief Настройки локального стакана
+struct OrderBookConfig {
+  int64_t tick_size{1}; // Шаг цены в единицах 1e-8 (tickSize из PRICE_FILTER)
+  size_t snapshot_limit{5000}; // Уровней в снимке /api/v3/depth
+  size_t max_buffered{10000}; // Изменений в буфере на время синхронизации
+  int snapshot_backoff_ms{250}; // Пауза после неудачной загрузки снимка (ошибка или устаревший снимок), удваивается
+  int snapshot_backoff_max_ms{10000}; // Предел паузы между загрузками снимка
+};
+
+/// @brief Статистика локального стакана
+struct OrderBookStats {
+  uint64_t updates{0}; // Применено изменений
+  uint64_t stale{0}; // Пропущено устаревших изменений
+  uint64_t gaps{0}; // Обнаружено разрывов последовательности
+  uint64_t snapshots{0}; // Загружено снимков
+  uint64_t snapshot_errors{0}; // Ошибок загрузки снимка
+  uint64_t snapshot_skipped{0}; // Загрузок снимка отложено до конца паузы
+};
+
+/// @brief Сторона стакана: уровни в непрерывных массивах (SoA), отсортированные от худшей цены к лучшей.
+/// Лучшая цена - последний элемент (O(1)), изменения у вершины стакана сдвигают лишь хвост массива.
+/// Для asks хранится ключ -tick, поэтому обе стороны упорядочены по возрастанию ключа.
+class BookSide {
+private:
+  std::vector<int64_t> keys{};
+  std::vector<int64_t> qtys{};
+  bool bid{true};
+  size_t find(int64_t key) const;
+public:
+  explicit BookSide(bool bid) : bid(bid) {}
+
+  /// @brief Установить количество на уровне (0 - удалить уровень)
+  void set(int64_t tick, int64_t qty);
+
+  /// @brief Лучший уровень ({0, 0} - сторона пуста)
+  BookLevel best() const {
+    if (keys.empty()) {
+      return BookLevel{};
+    }
+    return BookLevel{bid ? keys.back() : -keys.back(), qtys.back()};
+  }
+
+  /// @brief Первые n уровней от лучшей цены
+  /// @param levels Результат (не более n уровней)
+  /// @return Количество уровней
+  size_t top(size_t n, BookLevel *levels) const;
+
+  /// @brief Количество на уровне (0 - уровня нет)
+  int64_t qty(int64_t tick) const;
+
+  size_t size() const { return keys.size(); }
+  void reserve(size_t count) {
+    keys.reserve(count);
+    qtys.reserve(count);
+  }
+  void clear() {
+    keys.clear();
+    qtys.clear();
+  }
+};
+
+/// @brief Локальный стакан торговой пары.
+/// Загружается снимком /api/v3/depth и поддерживается изменениями потока <symbol>@depth(@100ms)
+/// по правилам Binance: изменения с u <= lastUpdateId пропускаются, первое применяемое
+/// изменение должно содержать lastUpdateId + 1 (U <= lastUpdateId + 1 <= u), каждое следующее
+/// начинаться с U = предыдущий u + 1. При разрыве стакан загружается заново автоматически:
+/// функция загрузки снимка вызывается внутри apply(), изменения на время загрузки буферизуются.
+/// После ошибки загрузки или снимка старше буфера следующая загрузка откладывается (пауза удваивается
+/// до snapshot_backoff_max_ms), чтобы поток изменений не превращался в поток запросов /api/v3/depth.
+/// Цены хранятся целыми тиками (цена / tick_size), количества - в единицах 1e-8.
+class LocalOrderBook {
+public:
+  /// @brief Функция загрузки снимка (symbol, limit); может бросать BinanceException
+  using SnapshotFetch = std::function<DepthSnapshot(const std::string&, size_t)>;
+private:
+  struct BufferedUpdate {
+    uint64_t first_update_id{0};
+    uint64_t final_update_id{0};
+    DepthLevels bids{};
+    DepthLevels asks{};
+  };
+
+  std::string book_symbol;
+  SnapshotFetch fetch;
+  OrderBookConfig config;
+  BookSide bids{true};
+  BookSide asks{false};
+  uint64_t last_id{0};
+  bool has_snapshot{false}; // Снимок загружен
+  bool live{false}; // Снимок связан с потоком изменений
+  uint32_t snapshot_failures{0}; // Неудачных загрузок снимка подряд
+  std::chrono::steady_clock::time_point next_snapshot{}; // Раньше этого времени снимок не загружается
+  std::vector<BufferedUpdate> buffer{};
+  size_t buffered{0};
+  OrderBookStats book_stats{};
+
+  bool resync();
+  void buffer_update(const DepthEvent &ev);
+  void drain();
+  void apply_levels(BookSide &side, const DepthLevels &levels);
+  void reset();
+  void backoff();
+public:
+  /// @brief Конструктор стакана
+  /// @param symbol Торговая пара ("BTCUSDT")
+  /// @param fetch Функция загрузки снимка (например, Binance::depth)
+  /// @param config Настройки
+  LocalOrderBook(const std::string &symbol, SnapshotFetch fetch, OrderBookConfig config = OrderBookConfig{});
+
+  /// @brief Применить изменение потока <symbol>@depth(@100ms)
+  /// @param ev Событие изменения стакана
+  /// @return Результат применения
+  BookUpdate apply(const DepthEvent &ev);
+
+  /// @brief Загрузить снимок (без вызова функции загрузки) и применить подходящие буферизованные изменения
+  /// @param snapshot Снимок стакана
+  void load(const DepthSnapshot &snapshot);
+
+  /// @brief Стакан связан с потоком изменений и актуален
+  bool is_live() const { return live; }
+
+  /// @brief Торговая пара
+  const std::string &symbol() const { return book_symbol; }
+
+  /// @brief Последний примененный updateId
+  uint64_t last_update_id() const { return last_id; }
+
+  /// @brief Лучшая цена покупки ({0, 0} - нет уровней)
+  BookLevel best_bid() const { return bids.best(); }
+
+  /// @brief Лучшая цена продажи ({0, 0} - нет уровней)
+  BookLevel best_ask() const { return asks.best(); }
+
+  /// @brief Первые n уровней bids (по убыванию цены)
+  size_t top_bids(size_t n, BookLevel *levels) const { return bids.top(n, levels); }
+
+  /// @brief Первые n уровней asks (по возрастанию цены)
+  size_t top_asks(size_t n, BookLevel *levels) const { return asks.top(n, levels); }
+
+  /// @brief Количество уровней bids / asks
+  size_t bid_levels() const { return bids.size(); }
+  size_t ask_levels() const { return asks.size(); }
+
+  /// @brief Цена в тиках -> цена
+  dec::decimal<8> price(int64_t tick) const {
+    dec::decimal<8> result{};
+    result.setUnbiased(tick * config.tick_size);
+    return result;
+  }
+
+  /// @brief Количество в единицах 1e-8 -> количество
+  static dec::decimal<8> quantity(int64_t qty) {
+    dec::decimal<8> result{};
+    result.setUnbiased(qty);
+    return result;
+  }
+
+  /// @brief Статистика стакана
+  OrderBookStats stats() const { return book_stats; }
+};
@@ -0,0 +1,403 @@
+#include "order_session.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+#include "./json_scan.hpp"
+#include "../binance/decoder.hpp"
+#include "../binance/order_builder.hpp"
+#include "../utils/utils.hpp"
+#include "../utils/fast_decimal.hpp"
+
+OrderSession::OrderSession(Auth key, const std::string &ed25519_pem, OrderSessionConfig config)
+    : auth(key), signer(ed25519_pem), config(config), ws(config.buffer_size), pending(config.max_pending),
+      order_budget(config.order_limit, order_burst_window_ms) {}
+
+Status OrderSession::connect() {
+  if (connected) {
+    return Status(0, std::string("OK"));
+  }
+  if (reader.joinable()) {
+    reader.join();
+  }
+  std::string path{config.path};
+  if (config.sbe) {
+    path += std::format("?responseFormat=sbe&sbeSchemaId={}&sbeSchemaVersion={}", sbe_schema_id, sbe_schema_version);
+  }
+  Status status = ws.connect(config.host, config.port, path, config.tls);
+  if (0 != status.code) {
+    return status;
+  }
+  connected = true;
+  reader = std::thread(&OrderSession::read_loop, this);
+  if (signer.valid()) {
+    try {
+      // apiKey добавляет message() при подписи
+      Params params{};
+      std::string response{call("session.logon", params, true)};
+      result(response);
+      logged_on = true;
+    }
+    catch (BinanceException &e) {
+      close();
+      return Status(e.e_code, e.e_msg);
+    }
+  }
+  return status;
+}
+
+void OrderSession::close() {
+  connected = false;
+  if (reader.joinable()) {
+    reader.join();
+  }
+  ws.close();
+  logged_on = false;
+  pending.fail_all();
+}
+
+Order OrderSession::create_order(Order &order, OrderRespType resp_type) {
+  if (OrderRespType::ACK == resp_type) {
+    OrderAck ack{create_order_ack(order)};
+    Order new_order{order.symbol, ack.orderId, order.price, order.origQty, order.side, OrderStatus::NONE, ack.transactTime};
+    return new_order;
+  }
+  if (config.sbe && (OrderRespType::FULL == resp_type)) {
+    resp_type = OrderRespType::RESULT;
+  }
+  std::string response{place_order(order, resp_type)};
+  std::string_view object{result(response)};
+  Order new_order{decode_order(object)};
+  std::string_view fills{};
+  if ((OrderRespType::FULL == resp_type) && JsonScanner::find(object, "fills", fills)) {
+    decode_fills(fills, new_order.fills);
+  }
+  return new_order;
+}
+
+OrderAck OrderSession::create_order_ack(Order &order) {
+  std::string response{place_order(order, OrderRespType::ACK)};
+  std::string_view object{result(response)};
+  OrderAck ack{};
+  bool decoded = config.sbe ? sbe_decode_order_ack(object, ack) : decode_order_ack(object, ack);
+  if (!decoded) {
+    throw BinanceException{ExceptionType::Server, 200, std::string{"Order ack is not valid"}};
+  }
+  return ack;
+}
+
+std::vector<BinanceResult<Order>> OrderSession::create_orders(std::span<Order> orders) {
+  std::vector<BinanceResult<Order>> results(orders.size());
+  std::vector<uint64_t> ids(orders.size(), 0);
+  for (size_t i = 0; i < orders.size(); i++) {
+    try {
+      Params params{order_request(orders[i], OrderRespType::RESULT)};
+      if (!admit_order()) {
+        results[i] = std::unexpected(BinanceError{ExceptionType::Filter, -1015, ErrorMessage::TOO_MANY_ORDERS});
+        continue;
+      }
+      ids[i] = send("order.place", params, !logged_on);
+    }
+    catch (BinanceException &e) {
+      results[i] = std::unexpected(make_error(e));
+    }
+  }
+  for (size_t i = 0; i < orders.size(); i++) {
+    if (0 == ids[i]) {
+      continue;
+    }
+    try {
+      std::string response{wait(ids[i])};
+      results[i] = decode_order(result(response));
+    }
+    catch (BinanceException &e) {
+      results[i] = std::unexpected(make_error(e));
+    }
+  }
+  return results;
+}
+
+std::string OrderSession::place_order(Order &order, OrderRespType resp_type) {
+  Params params{order_request(order, resp_type)};
+  if (!admit_order()) {
+    throw BinanceError{ExceptionType::Filter, -1015, ErrorMessage::TOO_MANY_ORDERS}.exception();
+  }
+  return call("order.place", params, !logged_on);
+}
+
+bool OrderSession::admit_order() {
+  return order_budget.acquire(1, current_ms_epoch());
+}
+
+OrderSession::Params OrderSession::order_request(Order &order, OrderRespType resp_type) {
+  std::shared_ptr<const ExchangeInfo> filters = order_filters.load();
+  if (filters) {
+    FilterResult f_result = filters->round(order);
+    if (FilterResult::OK != f_result) {
+      throw BinanceException{ExceptionType::Filter, static_cast<int>(f_result), std::string{filter_result_to_str(f_result)}};
+    }
+  }
+  Params params{};
+  order_params(order, [&params](const char *key, std::string_view value) { params.emplace_back(key, value); });
+  params.emplace_back("newOrderRespType", order_resp_type_to_str(resp_type));
+  return params;
+}
+
+Order OrderSession::cancel_order(const std::string &symbol, const uint64_t &order_id) {
+  Params params{{"symbol", symbol}, {"orderId", std::to_string(order_id)}};
+  std::string response{call("order.cancel", params, !logged_on)};
+  return decode_order(result(response));
+}
+
+Order OrderSession::cancel_replace(const uint64_t &order_id, Order &order) {
+  std::shared_ptr<const ExchangeInfo> filters = order_filters.load();
+  if (filters) {
+    FilterResult f_result = filters->round(order);
+    if (FilterResult::OK != f_result) {
+      throw BinanceException{ExceptionType::Filter, static_cast<int>(f_result), std::string{filter_result_to_str(f_result)}};
+    }
+  }
+  Params params{};
+  order_params(order, [&params](const char *key, std::string_view value) { params.emplace_back(key, value); });
+  params.emplace_back("cancelReplaceMode", std::string{"STOP_ON_FAILURE"});
+  params.emplace_back("cancelOrderId", std::to_string(order_id));
+  params.emplace_back("newOrderRespType", std::string{"RESULT"});
+  if (!admit_order()) {
+    throw BinanceError{ExceptionType::Filter, -1015, ErrorMessage::TOO_MANY_ORDERS}.exception();
+  }
+  std::string response{call("order.cancelReplace", params, !logged_on)};
+  if (config.sbe) {
+    return decode_order(result(response));
+  }
+  std::string_view new_order{};
+  if (!JsonScanner::find(result(response), "newOrderResponse", new_order)) {
+    throw BinanceException{ExceptionType::Server, 200, std::string{"newOrderResponse not found"}};
+  }
+  return decode_order(new_order);
+}
+
+OrderSessionStats OrderSession::stats() const {
+  return OrderSessionStats{n_requests.load(), n_responses.load(), n_timeouts.load(), n_unmatched.load(), n_errors.load()};
+}
+
+std::string OrderSession::call(std::string_view method, Params &params, bool sign) {
+  return wait(send(method, params, sign));
+}
+
+uint64_t OrderSession::send(std::string_view method, Params &params, bool sign) {
+  if (!connected) {
+    throw BinanceException{ExceptionType::Transport, -1, std::string{"Not connected"}};
+  }
+  uint64_t id = next_id.fetch_add(1);
+  if (!pending.claim(id, std::chrono::milliseconds(config.timeout_ms))) {
+    throw BinanceException{ExceptionType::Transport, -1, std::string{"Too many pending requests"}};
+  }
+  std::string text{message(id, method, params, sign)};
+  n_requests++;
+  // Поток чтения мог завершиться до захвата ячейки: тогда запрос завершает вызывающий поток
+  if (!connected || !ws.send_text(text)) {
+    pending.fail(id);
+  }
+  return id;
+}
+
+std::string OrderSession::wait(uint64_t id) {
+  std::string response{};
+  PendingResult state = pending.wait(id, response, config.spin);
+  if (PendingResult::FAILED == state) {
+    throw BinanceException{ExceptionType::Transport, -1, std::string{"Connection closed"}};
+  }
+  if (PendingResult::TIMEOUT == state) {
+    throw BinanceException{ExceptionType::Transport, -1, std::string{"Request timeout"}};
+  }
+  return response;
+}
+
+std::string OrderSession::message(uint64_t id, std::string_view method, Params &params, bool sign) {
+  params.emplace_back("recvWindow", std::to_string(config.recv_window));
+  params.emplace_back("timestamp", std::to_string(current_ms_epoch()));
+  if (sign) {
+    if (std::none_of(params.begin(), params.end(), [](const auto &param) { return "apiKey" == param.first; })) {
+      params.emplace_back("apiKey", auth.api_key);
+    }
+    // Подписывается строка параметров, отсортированных по ключу
+    std::sort(params.begin(), params.end());
+    std::string query{};
+    for (auto &[key, value] : params) {
+      query += std::format("{}{}={}", query.empty() ? "" : "&", key, value);
+    }
+    std::string signature{signer.valid() ? signer.sign(query) : hmac_sha256(auth.user_key.c_str(), query.c_str())};
+    params.emplace_back("signature", signature);
+  }
+  std::string text{std::format("{{\"id\":{},\"method\":\"{}\",\"params\":{{", id, method)};
+  for (size_t i = 0; i < params.size(); i++) {
+    auto &[key, value] = params[i];
+    // Целые (orderId, timestamp) передаются числами, остальные значения - строками
+    bool number = !value.empty() && std::all_of(value.begin(), value.end(), [](char c) { return ('0' <= c) && ('9' >= c); });
+    text += std::format("{}\"{}\":{}{}{}", (0 == i) ? "" : ",", key, number ? "" : "\"", value, number ? "" : "\"");
+  }
+  text += "}}";
+  return text;
+}
+
+std::string_view OrderSession::result(const std::string &response) {
+  if (config.sbe) {
+    SbeWsResponse envelope{};
+    if (!sbe_decode_ws_response(response, envelope)) {
+      throw BinanceException{ExceptionType::Server, -1, std::string{"Response is not valid"}};
+    }
+    if (200 == envelope.status) {
+      return envelope.result;
+    }
+    n_errors++;
+    int code{0};
+    std::string msg{};
+    if (!sbe_decode_error(envelope.result, code, msg)) {
+      throw BinanceException{ExceptionType::Server, envelope.status, std::string{"Response is not valid"}};
+    }
+    throw BinanceException{ExceptionType::Binance, code, msg};
+  }
+  JsonScanner scanner{response};
+  std::string_view key{};
+  std::string_view value{};
+  std::string_view object{};
+  std::string_view error{};
+  int status{0};
+  while (scanner.next(key, value)) {
+    if ("status" == key) {
+      std::from_chars(value.data(), value.data() + value.size(), status);
+    }
+    else if ("result" == key) {
+      object = value;
+    }
+    else if ("error" == key) {
+      error = value;
+    }
+  }
+  if ((200 == status) && !object.empty()) {
+    return object;
+  }
+  if (!error.empty()) {
+    n_errors++;
+    int code{0};
+    std::string_view msg{};
+    if (JsonScanner::find(error, "code", value)) {
+      std::from_chars(value.data(), value.data() + value.size(), code);
+    }
+    JsonScanner::find(error, "msg", msg);
+    throw BinanceException{ExceptionType::Binance, code, std::string(msg)};
+  }
+  throw BinanceException{ExceptionType::Server, status, std::string{"Response is not valid"}};
+}
+
+Order OrderSession::decode_order(std::string_view object) {
+  Order order{};
+  if (config.sbe) {
+    if (!sbe_decode_order(object, order)) {
+      throw BinanceException{ExceptionType::Server, 200, std::string{"Order is not valid"}};
+    }
+    return order;
+  }
+  uint64_t transact_time{0};
+  JsonScanner scanner{object};
+  std::string_view key{};
+  std::string_view value{};
+  while (scanner.next(key, value)) {
+    if ("symbol" == key) {
+      order.symbol = value;
+    }
+    else if ("orderId" == key) {
+      order.orderId = json_to_u64(value);
+    }
+    else if ("price" == key) {
+      order.price = str_to_decimal<8>(value);
+    }
+    else if ("origQty" == key) {
+      order.origQty = str_to_decimal<8>(value);
+    }
+    else if ("side" == key) {
+      order.side = str_to_side(value);
+    }
+    else if ("status" == key) {
+      order.status = str_to_order_status(value);
+    }
+    else if ("type" == key) {
+      order.type = str_to_order_type(value);
+    }
+    else if ("timeInForce" == key) {
+      order.timeInForce = str_to_time_in_force(value);
+    }
+    else if ("stopPrice" == key) {
+      order.stopPrice = str_to_decimal<8>(value);
+    }
+    else if ("time" == key) {
+      order.time = json_to_u64(value);
+    }
+    else if ("transactTime" == key) {
+      transact_time = json_to_u64(value);
+    }
+  }
+  if (0 == order.time) {
+    order.time = transact_time;
+  }
+  return order;
+}
+
+void OrderSession::read_loop() {
+  auto next_check = std::chrono::steady_clock::now();
+  while (connected) {
+    int r = ws.poll([this](WsOpcode opcode, std::string_view message) {
+      if (WsOpcode::TEXT == opcode) {
+        dispatch(message);
+      }
+      else if (WsOpcode::BINARY == opcode) {
+        dispatch_sbe(message);
+      }
+    }, 50);
+    if (0 > r) {
+      break;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now >= next_check) {
+      n_timeouts += pending.expire(now);
+      next_check = now + std::chrono::milliseconds(50);
+    }
+  }
+  connected = false;
+  logged_on = false;
+  pending.fail_all();
+}
+
+void OrderSession::dispatch(std::string_view message) {
+  std::string_view value{};
+  if (!JsonScanner::find(message, "id", value)) {
+    n_unmatched++;
+    return;
+  }
+  if (pending.complete(json_to_u64(value), message)) {
+    n_responses++;
+  }
+  else {
+    n_unmatched++;
+  }
+}
+
+void OrderSession::dispatch_sbe(std::string_view message) {
+  SbeWsResponse envelope{};
+  uint64_t id{0};
+  if (!sbe_decode_ws_response(message, envelope)) {
+    n_unmatched++;
+    return;
+  }
+  std::from_chars(envelope.id.data(), envelope.id.data() + envelope.id.size(), id);
+  if (pending.complete(id, message)) {
+    n_responses++;
+  }
+  else {
+    n_unmatched++;
+  }
+}
+
+OrderSession::~OrderSession() {
+  close();
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <span>
+
+#include "../binance/binance_type.hpp"
+#include "../binance/binance_error.hpp"
+#include "../binance/endpoint.hpp"
+#include "../binance/exchange_info.hpp"
+#include "../binance/sbe.hpp"
+#include "../utils/ed25519.hpp"
+#include "../utils/pending_table.hpp"
+#include "./websocket.hpp"
+
+/// @brief Настройки сессии WebSocket API
+struct OrderSessionConfig {
+  std::string host{"ws-api.binance.com"};
+  int port{443};
+  std::string path{"/ws-api/v3"};
+  bool tls{true};
+  int timeout_ms{def_timeout_ms}; // Ожидание ответа на запрос
+  int recv_window{5000};
+  size_t max_pending{256}; // Одновременных запросов (округляется вверх до степени двойки)
+  int spin{2000}; // Итераций активного ожидания ответа до засыпания потока
+  size_t buffer_size{1 << 16};
+  bool sbe{false}; // Ответы в SBE (responseFormat=sbe, схема sbe_schema_id:sbe_schema_version)
+  uint64_t order_limit{order_burst_limit}; // Новых ордеров за 10 секунд (лимит ORDERS), сверх него - ошибка -1015 без отправки
+};
+
+/// @brief Статистика сессии WebSocket API
+struct OrderSessionStats {
+  uint64_t requests{0};
+  uint64_t responses{0};
+  uint64_t timeouts{0};
+  uint64_t unmatched{0}; // Ответы без ожидающего запроса (после таймаута)
+  uint64_t errors{0}; // Ответы с ошибкой Binance
+};
+
+/// @brief Сессия размещения ордеров через WebSocket API Binance (order.place, order.cancel, order.cancelReplace).
+/// Постоянное соединение вместо HTTP запроса на каждый ордер. С ключом Ed25519 сессия авторизуется
+/// один раз (session.logon) и запросы не подписываются; без него каждый запрос подписывается HMAC,
+/// как в REST. Ответы сопоставляются с запросами по id через таблицу ожидающих запросов без блокировок (PendingTable).
+/// Методы потокобезопасны и повторяют Binance::create_order / cancel_order.
+/// При разрыве соединения ожидающие запросы завершаются ошибкой Transport, повторное подключение - connect().
+/// С config.sbe ответы приходят бинарными кадрами SBE и декодируются без разбора JSON.
+class OrderSession {
+private:
+  using Params = std::vector<std::pair<std::string_view, std::string>>;
+
+  Auth auth;
+  Ed25519Signer signer;
+  OrderSessionConfig config;
+  WebSocket ws;
+  PendingTable pending;
+  std::atomic<uint64_t> next_id{1};
+  std::atomic<bool> connected{false};
+  std::atomic<bool> logged_on{false};
+  std::thread reader{};
+  std::atomic<std::shared_ptr<const ExchangeInfo>> order_filters{};
+  WeightBudget order_budget;
+  std::atomic<uint64_t> n_requests{0};
+  std::atomic<uint64_t> n_responses{0};
+  std::atomic<uint64_t> n_timeouts{0};
+  std::atomic<uint64_t> n_unmatched{0};
+  std::atomic<uint64_t> n_errors{0};
+
+  void read_loop();
+  void dispatch(std::string_view message);
+  void dispatch_sbe(std::string_view message);
+  std::string call(std::string_view method, Params &params, bool sign);
+  uint64_t send(std::string_view method, Params &params, bool sign);
+  std::string wait(uint64_t id);
+  std::string message(uint64_t id, std::string_view method, Params &params, bool sign);
+  std::string_view result(const std::string &response);
+  Order decode_order(std::string_view object);
+  std::string place_order(Order &order, OrderRespType resp_type);
+  Params order_request(Order &order, OrderRespType resp_type);
+  bool admit_order();
+public:
+  /// @brief Конструктор сессии
+  /// @param key Ключи доступа (api_key; user_key - секрет HMAC, если нет ключа Ed25519)
+  /// @param ed25519_pem Закрытый ключ Ed25519 (PEM) для session.logon; пустая строка - подпись HMAC каждого запроса
+  /// @param config Настройки
+  OrderSession(Auth key, const std::string &ed25519_pem = std::string{}, OrderSessionConfig config = OrderSessionConfig{});
+  OrderSession(const OrderSession&) = delete;
+  OrderSession& operator=(const OrderSession&) = delete;
+
+  /// @brief Подключение и авторизация сессии (session.logon при наличии ключа Ed25519)
+  /// @return Status (code 0 - успех)
+  Status connect();
+
+  /// @brief Закрытие соединения (ожидающие запросы завершаются ошибкой)
+  void close();
+
+  /// @brief Соединение открыто
+  bool is_connected() const { return connected; }
+
+  /// @brief Сессия авторизована session.logon
+  bool is_logged_on() const { return logged_on; }
+
+  /// @brief Фильтры торговых пар для округления и проверки ордеров (как в Binance::create_order)
+  /// @param info Таблица фильтров (nullptr - без проверки)
+  void exchange_info(std::shared_ptr<const ExchangeInfo> info) { order_filters.store(info); }
+
+  /// @brief Создать лимитный ордер (order.place)
+  /// @param order Ордер для создания (при заданных фильтрах цена и количество округляются)
+  /// @param resp_type Состав ответа (как в Binance::create_order; в SBE сессии FULL заменяется на RESULT)
+  /// @return - Новый ордер
+  /// @exception BinanceException
+  Order create_order(Order &order, OrderRespType resp_type = OrderRespType::RESULT);
+
+  /// @brief Создать лимитный ордер с минимальным ответом (order.place, newOrderRespType=ACK)
+  /// @param order Ордер для создания (при заданных фильтрах цена и количество округляются)
+  /// @return - Подтверждение приема ордера
+  /// @exception BinanceException
+  OrderAck create_order_ack(Order &order);
+
+  /// @brief Создать несколько ордеров (лесенку): все запросы order.place отправляются без ожидания ответов,
+  /// затем ответы собираются по id, поэтому пакет занимает примерно один RTT.
+  /// Ордера сверх бюджета ORDERS сессии (config.order_limit за 10 секунд, общий для всех методов создания ордера)
+  /// не подписываются и не отправляются (ошибка -1015)
+  /// @param orders Ордера (при заданных фильтрах цена и количество округляются)
+  /// @return - Новый ордер или ошибка для каждого ордера в порядке orders
+  std::vector<BinanceResult<Order>> create_orders(std::span<Order> orders);
+
+  /// @brief Отмена ордера (order.cancel)
+  /// @param symbol Торговая пара
+  /// @param order_id Id ордера
+  /// @return - Отмененный Ордер
+  /// @exception BinanceException
+  Order cancel_order(const std::string &symbol, const uint64_t &order_id);
+
+  /// @brief Отмена ордера и создание нового одним запросом (order.cancelReplace, STOP_ON_FAILURE)
+  /// @param order_id Id отменяемого ордера
+  /// @param order Новый ордер (той же пары)
+  /// @return - Новый ордер
+  /// @exception BinanceException
+  Order cancel_replace(const uint64_t &order_id, Order &order);
+
+  /// @brief Статистика сессии
+  OrderSessionStats stats() const;
+
+  ~OrderSession();
+};
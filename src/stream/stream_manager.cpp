@@ -0,0 +1,449 @@
+#include "stream_manager.hpp"
+
+#include <algorithm>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+
+StreamManager::StreamManager(StreamManagerConfig config) : config(config) {
+  size_t count = std::max<size_t>(1, config.shards);
+  int cpus = std::max<int>(1, static_cast<int>(std::thread::hardware_concurrency()));
+  for (size_t i = 0; i < count; i++) {
+    auto shard = std::make_unique<Shard>();
+    shard->index = i;
+    shard->cpu = config.pin_threads ? (config.first_cpu + static_cast<int>(i)) % cpus : -1;
+    shards.push_back(std::move(shard));
+  }
+}
+
+void StreamManager::start() {
+  if (running.exchange(true)) {
+    return;
+  }
+  for (auto &shard : shards) {
+    shard->changed = true;
+    shard->thread = std::thread(&StreamManager::worker, this, std::ref(*shard));
+  }
+}
+
+void StreamManager::stop() {
+  running = false;
+  for (auto &shard : shards) {
+    if (shard->thread.joinable()) {
+      shard->thread.join();
+    }
+  }
+  std::lock_guard<std::mutex> lock(mtx);
+  for (auto &conn : connections) {
+    conn->stream->close();
+  }
+  for (auto &shard : shards) {
+    std::lock_guard<std::mutex> shard_lock(shard->mtx);
+    for (auto &conn : shard->retired) {
+      conn->stream->close();
+    }
+    shard->retired.clear();
+  }
+}
+
+Status StreamManager::subscribe(const std::vector<std::string> &streams) {
+  std::lock_guard<std::mutex> lock(mtx);
+  std::vector<std::shared_ptr<Connection>> created{};
+  std::map<std::shared_ptr<Connection>, std::vector<std::string>> batches{};
+  for (auto &stream : streams) {
+    if (assigned.contains(stream)) {
+      continue;
+    }
+    std::shared_ptr<Connection> conn = pick_connection();
+    if (!conn) {
+      conn = make_connection();
+      connections.push_back(conn);
+      created.push_back(conn);
+    }
+    {
+      std::lock_guard<std::mutex> conn_lock(conn->mtx);
+      conn->streams.push_back(stream);
+    }
+    assigned.emplace(stream, conn);
+    if (created.end() == std::find(created.begin(), created.end(), conn)) {
+      batches[conn].push_back(stream);
+    }
+  }
+  Status status(0, std::string("OK"));
+  for (auto &conn : created) {
+    Status res = open_connection(*conn);
+    if (0 != res.code) {
+      // Откат назначений соединения, которое не удалось открыть
+      for (auto &stream : conn->streams) {
+        assigned.erase(stream);
+      }
+      std::erase(connections, conn);
+      status = res;
+      continue;
+    }
+    attach(conn);
+  }
+  for (auto &[conn, batch] : batches) {
+    enqueue(*conn, true, batch);
+  }
+  return status;
+}
+
+size_t StreamManager::unsubscribe(const std::vector<std::string> &streams) {
+  std::lock_guard<std::mutex> lock(mtx);
+  std::map<std::shared_ptr<Connection>, std::vector<std::string>> batches{};
+  for (auto &stream : streams) {
+    auto it = assigned.find(stream);
+    if (assigned.end() == it) {
+      continue;
+    }
+    std::shared_ptr<Connection> conn = it->second;
+    assigned.erase(it);
+    {
+      std::lock_guard<std::mutex> conn_lock(conn->mtx);
+      std::erase(conn->streams, stream);
+    }
+    batches[conn].push_back(stream);
+  }
+  size_t count{0};
+  for (auto &[conn, batch] : batches) {
+    count += batch.size();
+    if (conn->streams.empty()) {
+      detach(conn);
+    }
+    else {
+      enqueue(*conn, false, batch);
+    }
+  }
+  return count;
+}
+
+size_t StreamManager::rebalance() {
+  std::lock_guard<std::mutex> lock(mtx);
+  size_t n = connections.size();
+  if (n < 2) {
+    return 0;
+  }
+  std::vector<std::unordered_map<std::string, double>> rates(n);
+  std::vector<double> loads(n, 0.0);
+  double total{0.0};
+  for (size_t i = 0; i < n; i++) {
+    std::lock_guard<std::mutex> conn_lock(connections[i]->mtx);
+    for (auto &stream : connections[i]->streams) {
+      auto it = connections[i]->rates.find(stream);
+      double rate = (connections[i]->rates.end() == it) ? 0.0 : it->second;
+      rates[i][stream] = rate;
+      loads[i] += rate;
+    }
+    total += loads[i];
+  }
+  double limit = (total / n) * (1.0 + config.rebalance_tolerance);
+  std::map<std::shared_ptr<Connection>, std::vector<std::string>> subscribes{};
+  std::map<std::shared_ptr<Connection>, std::vector<std::string>> unsubscribes{};
+  size_t moves{0};
+  while (moves < config.rebalance_max_moves) {
+    size_t src{0};
+    size_t dst{n};
+    for (size_t i = 0; i < n; i++) {
+      if (loads[i] > loads[src]) {
+        src = i;
+      }
+      if ((connections[i]->streams.size() < config.max_streams_per_connection) && ((n == dst) || (loads[i] < loads[dst]))) {
+        dst = i;
+      }
+    }
+    if ((n == dst) || (src == dst) || (loads[src] <= limit) || (connections[src]->streams.size() < 2)) {
+      break;
+    }
+    // Самый активный поток, перенос которого уменьшает разрыв между соединениями
+    double gap = loads[src] - loads[dst];
+    std::string best{};
+    double best_rate{0.0};
+    for (auto &[stream, rate] : rates[src]) {
+      if ((rate > best_rate) && (rate < gap)) {
+        best = stream;
+        best_rate = rate;
+      }
+    }
+    if (best.empty()) {
+      break;
+    }
+    std::shared_ptr<Connection> from = connections[src];
+    std::shared_ptr<Connection> to = connections[dst];
+    {
+      std::scoped_lock conn_lock(from->mtx, to->mtx);
+      std::erase(from->streams, best);
+      to->streams.push_back(best);
+    }
+    assigned[best] = to;
+    rates[src].erase(best);
+    rates[dst][best] = best_rate;
+    loads[src] -= best_rate;
+    loads[dst] += best_rate;
+    subscribes[to].push_back(best);
+    unsubscribes[from].push_back(best);
+    moves++;
+  }
+  for (auto &[conn, batch] : subscribes) {
+    enqueue(*conn, true, batch);
+  }
+  for (auto &[conn, batch] : unsubscribes) {
+    enqueue(*conn, false, batch);
+  }
+  return moves;
+}
+
+size_t StreamManager::stream_count() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  return assigned.size();
+}
+
+size_t StreamManager::connection_count() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  return connections.size();
+}
+
+std::vector<StreamShardStats> StreamManager::stats() const {
+  std::vector<StreamShardStats> result{};
+  for (auto &shard : shards) {
+    StreamShardStats st{};
+    st.shard = shard->index;
+    st.cpu = shard->cpu;
+    {
+      std::lock_guard<std::mutex> lock(shard->mtx);
+      for (auto &conn : shard->connections) {
+        std::lock_guard<std::mutex> conn_lock(conn->mtx);
+        st.connections++;
+        st.streams += conn->streams.size();
+        st.pending_requests += conn->requests.size();
+      }
+    }
+    st.messages = shard->messages.load();
+    st.errors = shard->errors.load();
+    st.reconnects = shard->reconnects.load();
+    st.messages_per_sec = shard->rate.load();
+    st.queue_bytes = shard->queue_bytes.load();
+    st.max_queue_bytes = shard->max_queue_bytes.load();
+    result.push_back(st);
+  }
+  return result;
+}
+
+std::shared_ptr<StreamManager::Connection> StreamManager::make_connection() {
+  // Новое соединение - в шард с наименьшим числом соединений
+  std::vector<size_t> counts(shards.size(), 0);
+  for (auto &conn : connections) {
+    counts[conn->shard]++;
+  }
+  auto conn = std::make_shared<Connection>();
+  conn->shard = std::min_element(counts.begin(), counts.end()) - counts.begin();
+  conn->stream = std::make_unique<MarketStream>(config.stream);
+  conn->stream->on_trade(trade_cb);
+  conn->stream->on_book_ticker(book_ticker_cb);
+  conn->stream->on_depth(depth_cb);
+  conn->stream->on_kline(kline_cb);
+  Connection *raw = conn.get();
+  conn->stream->on_message([raw](std::string_view stream) {
+    auto it = raw->counts.find(stream);
+    if (raw->counts.end() == it) {
+      raw->counts.emplace(std::string(stream), 1);
+    }
+    else {
+      it->second++;
+    }
+  });
+  return conn;
+}
+
+std::shared_ptr<StreamManager::Connection> StreamManager::pick_connection() {
+  // Пока соединений меньше, чем шардов, каждый поток получает новое соединение
+  if (connections.size() < shards.size()) {
+    return nullptr;
+  }
+  std::shared_ptr<Connection> result{};
+  for (auto &conn : connections) {
+    if ((conn->streams.size() < config.max_streams_per_connection) && (!result || (conn->streams.size() < result->streams.size()))) {
+      result = conn;
+    }
+  }
+  return result;
+}
+
+Status StreamManager::open_connection(Connection &conn) {
+  std::vector<std::string> initial{};
+  {
+    std::lock_guard<std::mutex> lock(conn.mtx);
+    conn.requests.clear();
+    size_t first = std::min(conn.streams.size(), config.max_streams_per_request);
+    initial.assign(conn.streams.begin(), conn.streams.begin() + first);
+    for (size_t i = first; i < conn.streams.size(); i += config.max_streams_per_request) {
+      size_t end = std::min(conn.streams.size(), i + config.max_streams_per_request);
+      conn.requests.push_back(Request{true, std::vector<std::string>(conn.streams.begin() + i, conn.streams.begin() + end)});
+    }
+  }
+  conn.last_connect = std::chrono::steady_clock::now();
+  return conn.stream->connect(initial);
+}
+
+void StreamManager::enqueue(Connection &conn, bool subscribe, const std::vector<std::string> &streams) {
+  std::lock_guard<std::mutex> lock(conn.mtx);
+  for (size_t i = 0; i < streams.size(); i += config.max_streams_per_request) {
+    size_t end = std::min(streams.size(), i + config.max_streams_per_request);
+    conn.requests.push_back(Request{subscribe, std::vector<std::string>(streams.begin() + i, streams.begin() + end)});
+  }
+}
+
+void StreamManager::attach(const std::shared_ptr<Connection> &conn) {
+  Shard &shard = *shards[conn->shard];
+  std::lock_guard<std::mutex> lock(shard.mtx);
+  shard.connections.push_back(conn);
+  shard.changed = true;
+}
+
+void StreamManager::detach(const std::shared_ptr<Connection> &conn) {
+  std::erase(connections, conn);
+  conn->retired = true;
+  Shard &shard = *shards[conn->shard];
+  std::lock_guard<std::mutex> lock(shard.mtx);
+  std::erase(shard.connections, conn);
+  if (running) {
+    // Соединение закрывает рабочий поток шарда, который может его опрашивать
+    shard.retired.push_back(conn);
+    shard.changed = true;
+  }
+  else {
+    conn->stream->close();
+  }
+}
+
+void StreamManager::send_requests(Connection &conn) {
+  auto now = std::chrono::steady_clock::now();
+  if (now - conn.window_start >= std::chrono::seconds(1)) {
+    conn.window_start = now;
+    conn.window_requests = 0;
+  }
+  while (conn.window_requests < config.max_requests_per_sec) {
+    Request req{};
+    {
+      std::lock_guard<std::mutex> lock(conn.mtx);
+      if (conn.requests.empty()) {
+        return;
+      }
+      req = std::move(conn.requests.front());
+      conn.requests.pop_front();
+    }
+    conn.window_requests++;
+    bool ok = req.subscribe ? conn.stream->subscribe(req.streams) : conn.stream->unsubscribe(req.streams);
+    if (!ok) {
+      return;
+    }
+  }
+}
+
+void StreamManager::publish_stats(Shard &shard, std::vector<std::shared_ptr<Connection>> &local, double sec) {
+  size_t queue{0};
+  uint64_t errors{0};
+  for (auto &conn : local) {
+    std::unordered_map<std::string, double> rates{};
+    for (auto it = conn->counts.begin(); it != conn->counts.end();) {
+      if (0 == it->second) {
+        it = conn->counts.erase(it);
+        continue;
+      }
+      rates[it->first] = it->second / sec;
+      it->second = 0;
+      ++it;
+    }
+    {
+      std::lock_guard<std::mutex> lock(conn->mtx);
+      conn->rates.swap(rates);
+    }
+    queue += conn->stream->buffered();
+    int pending{0};
+    if (conn->stream->is_open() && (0 == ioctl(conn->stream->fd(), FIONREAD, &pending))) {
+      queue += pending;
+    }
+    MarketStreamStats st{conn->stream->stats()};
+    errors += st.errors - conn->errors_seen;
+    conn->errors_seen = st.errors;
+  }
+  shard.errors += errors;
+  shard.queue_bytes = queue;
+  if (queue > shard.max_queue_bytes) {
+    shard.max_queue_bytes = queue;
+  }
+}
+
+void StreamManager::worker(Shard &shard) {
+  if (0 <= shard.cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(shard.cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+  std::vector<std::shared_ptr<Connection>> local{};
+  std::vector<pollfd> fds{};
+  size_t offset{0};
+  uint64_t last_messages{shard.messages.load()};
+  auto stats_start = std::chrono::steady_clock::now();
+  while (running) {
+    if (shard.changed.exchange(false)) {
+      std::vector<std::shared_ptr<Connection>> retired{};
+      {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        local = shard.connections;
+        retired.swap(shard.retired);
+      }
+      for (auto &conn : retired) {
+        conn->stream->close();
+      }
+    }
+    auto now = std::chrono::steady_clock::now();
+    bool pending{false};
+    size_t buffered{0};
+    fds.clear();
+    for (auto &conn : local) {
+      if (!conn->stream->is_open() && (now - conn->last_connect >= std::chrono::seconds(1))) {
+        if (0 == open_connection(*conn).code) {
+          shard.reconnects++;
+        }
+      }
+      if (conn->stream->is_open()) {
+        send_requests(*conn);
+      }
+      buffered += conn->stream->buffered();
+      pending = pending || (0 < conn->stream->buffered());
+      fds.push_back(pollfd{conn->stream->is_open() ? conn->stream->fd() : -1, POLLIN, 0});
+    }
+    if (buffered > shard.max_queue_bytes) {
+      shard.max_queue_bytes = buffered;
+    }
+    ::poll(fds.data(), fds.size(), pending ? 0 : 50);
+    // Обход по кругу с ограничением сообщений на соединение за проход
+    for (size_t i = 0; i < local.size(); i++) {
+      size_t k = (offset + i) % local.size();
+      Connection &conn = *local[k];
+      if (!conn.stream->is_open() || ((0 == fds[k].revents) && (0 == conn.stream->buffered()))) {
+        continue;
+      }
+      int n = conn.stream->poll(0, config.poll_budget);
+      if (0 < n) {
+        shard.messages += n;
+      }
+    }
+    offset++;
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - stats_start).count();
+    if (sec >= 1.0) {
+      uint64_t messages = shard.messages.load();
+      shard.rate = (messages - last_messages) / sec;
+      last_messages = messages;
+      publish_stats(shard, local, sec);
+      stats_start = std::chrono::steady_clock::now();
+    }
+  }
+}
+
+StreamManager::~StreamManager() {
+  stop();
+}
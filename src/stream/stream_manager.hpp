@@ -0,0 +1,168 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+#include "./market_stream.hpp"
+
+/// @brief Настройки менеджера подписок
+struct StreamManagerConfig {
+  MarketStreamConfig stream{}; // Подключение к потокам
+  size_t shards{1}; // Рабочих потоков (шардов)
+  size_t max_streams_per_connection{1024}; // Лимит Binance на потоки в одном соединении
+  size_t max_streams_per_request{200}; // Потоков в одном SUBSCRIBE/UNSUBSCRIBE (и в URL подключения)
+  size_t max_requests_per_sec{4}; // Управляющих сообщений в секунду на соединение (лимит Binance 5, включая PONG)
+  int poll_budget{64}; // Сообщений одного соединения за проход цикла шарда
+  bool pin_threads{true}; // Привязка рабочих потоков к ядрам
+  int first_cpu{0}; // Ядро первого шарда (шард i -> first_cpu + i по модулю числа ядер)
+  double rebalance_tolerance{0.25}; // Допустимое превышение средней нагрузки соединения
+  size_t rebalance_max_moves{32}; // Максимум переносов потоков за один rebalance()
+};
+
+/// @brief Статистика шарда
+struct StreamShardStats {
+  size_t shard{0};
+  int cpu{-1}; // Ядро (-1 - без привязки)
+  size_t connections{0};
+  size_t streams{0};
+  uint64_t messages{0}; // Всего принято сообщений
+  uint64_t errors{0}; // Сообщений, которые не удалось разобрать
+  uint64_t reconnects{0};
+  double messages_per_sec{0.0}; // Скорость за последний интервал статистики
+  size_t queue_bytes{0}; // Ожидают обработки (буфер приема + сокет)
+  size_t max_queue_bytes{0}; // Максимум queue_bytes с момента запуска
+  size_t pending_requests{0}; // Управляющих сообщений в очереди
+};
+
+/// @brief Менеджер подписок на потоки рыночных данных.
+/// Упаковывает потоки в объединенные соединения (не более max_streams_per_connection на соединение),
+/// распределяет соединения по шардам - рабочим потокам с привязкой к ядрам. Каждый шард опрашивает
+/// свои соединения по кругу, обрабатывая не более poll_budget сообщений соединения за проход, поэтому
+/// активный поток не задерживает остальные. SUBSCRIBE/UNSUBSCRIBE отправляются рабочим потоком
+/// с соблюдением лимита управляющих сообщений. Обработчики событий вызываются из рабочих потоков
+/// (одновременно из разных шардов) и должны быть установлены до первого subscribe().
+class StreamManager {
+private:
+  struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+  };
+  using RateMap = std::unordered_map<std::string, uint64_t, StringHash, std::equal_to<>>;
+
+  struct Request {
+    bool subscribe{true};
+    std::vector<std::string> streams{};
+  };
+
+  struct Connection {
+    std::unique_ptr<MarketStream> stream{};
+    size_t shard{0};
+    std::mutex mtx; // streams, requests, rates
+    std::vector<std::string> streams{}; // Назначенные потоки
+    std::deque<Request> requests{}; // Ожидающие отправки SUBSCRIBE/UNSUBSCRIBE
+    std::unordered_map<std::string, double> rates{}; // Сообщений/сек по потокам за последний интервал
+    std::atomic<bool> retired{false};
+    // Только рабочий поток шарда
+    RateMap counts{};
+    std::chrono::steady_clock::time_point window_start{};
+    size_t window_requests{0};
+    std::chrono::steady_clock::time_point last_connect{};
+    uint64_t errors_seen{0};
+  };
+
+  struct Shard {
+    size_t index{0};
+    int cpu{-1};
+    std::thread thread{};
+    std::mutex mtx; // connections, retired
+    std::vector<std::shared_ptr<Connection>> connections{};
+    std::vector<std::shared_ptr<Connection>> retired{}; // Удаленные соединения, закрываемые рабочим потоком
+    std::atomic<bool> changed{false};
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> reconnects{0};
+    std::atomic<double> rate{0.0};
+    std::atomic<size_t> queue_bytes{0};
+    std::atomic<size_t> max_queue_bytes{0};
+  };
+
+  StreamManagerConfig config;
+  std::vector<std::unique_ptr<Shard>> shards{};
+  mutable std::mutex mtx; // connections, assigned
+  std::vector<std::shared_ptr<Connection>> connections{};
+  std::map<std::string, std::shared_ptr<Connection>, std::less<>> assigned{};
+  std::atomic<bool> running{false};
+  std::function<void(const TradeEvent&)> trade_cb{};
+  std::function<void(const BookTickerEvent&)> book_ticker_cb{};
+  std::function<void(const DepthEvent&)> depth_cb{};
+  std::function<void(const KlineEvent&)> kline_cb{};
+
+  std::shared_ptr<Connection> make_connection();
+  std::shared_ptr<Connection> pick_connection();
+  Status open_connection(Connection &conn);
+  void enqueue(Connection &conn, bool subscribe, const std::vector<std::string> &streams);
+  void attach(const std::shared_ptr<Connection> &conn);
+  void detach(const std::shared_ptr<Connection> &conn);
+  void worker(Shard &shard);
+  void send_requests(Connection &conn);
+  void publish_stats(Shard &shard, std::vector<std::shared_ptr<Connection>> &local, double sec);
+public:
+  /// @brief Конструктор менеджера
+  /// @param config Настройки
+  StreamManager(StreamManagerConfig config = StreamManagerConfig{});
+  StreamManager(const StreamManager&) = delete;
+  StreamManager& operator=(const StreamManager&) = delete;
+
+  /// @brief Обработчик сделок
+  void on_trade(std::function<void(const TradeEvent&)> callback) { trade_cb = callback; }
+  /// @brief Обработчик лучших цен
+  void on_book_ticker(std::function<void(const BookTickerEvent&)> callback) { book_ticker_cb = callback; }
+  /// @brief Обработчик изменений стакана
+  void on_depth(std::function<void(const DepthEvent&)> callback) { depth_cb = callback; }
+  /// @brief Обработчик свечей
+  void on_kline(std::function<void(const KlineEvent&)> callback) { kline_cb = callback; }
+
+  /// @brief Запуск рабочих потоков
+  void start();
+
+  /// @brief Остановка рабочих потоков и закрытие соединений
+  void stop();
+
+  /// @brief Подписка на потоки (уже подписанные пропускаются).
+  /// Новые соединения открываются синхронно, подписка в открытых соединениях - рабочими потоками.
+  /// @param streams Имена потоков (stream_name)
+  /// @return Status (code 0 - успех)
+  Status subscribe(const std::vector<std::string> &streams);
+
+  /// @brief Отписка от потоков. Опустевшие соединения закрываются.
+  /// @param streams Имена потоков
+  /// @return Количество отписанных потоков
+  size_t unsubscribe(const std::vector<std::string> &streams);
+
+  /// @brief Перенос потоков из перегруженных соединений в наименее нагруженные
+  /// по скорости сообщений за последний интервал статистики (SUBSCRIBE в новом соединении
+  /// ставится в очередь раньше UNSUBSCRIBE в старом)
+  /// @return Количество перенесенных потоков
+  size_t rebalance();
+
+  /// @brief Количество подписанных потоков
+  size_t stream_count() const;
+
+  /// @brief Количество соединений
+  size_t connection_count() const;
+
+  /// @brief Статистика по шардам
+  std::vector<StreamShardStats> stats() const;
+
+  ~StreamManager();
+};
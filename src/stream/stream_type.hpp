@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cctype>
+
+#include "../utils/decimal.hpp"
+#include "./depth_decoder.hpp"
+
+/// Строковые поля событий (symbol, interval) указывают в буфер приема
+/// и действительны только внутри обработчика события.
+
+/// @brief Сделка (<symbol>@trade)
+struct TradeEvent {
+  std::string_view symbol{};
+  uint64_t event_time{0};
+  uint64_t trade_id{0};
+  uint64_t trade_time{0};
+  dec::decimal<8> price{};
+  dec::decimal<8> qty{};
+  bool buyer_maker{false};
+};
+
+/// @brief Лучшие цены (<symbol>@bookTicker)
+struct BookTickerEvent {
+  std::string_view symbol{};
+  uint64_t update_id{0};
+  dec::decimal<8> bid_price{};
+  dec::decimal<8> bid_qty{};
+  dec::decimal<8> ask_price{};
+  dec::decimal<8> ask_qty{};
+};
+
+/// @brief Изменения стакана (<symbol>@depth, <symbol>@depth@100ms)
+struct DepthEvent {
+  std::string_view symbol{};
+  uint64_t event_time{0};
+  uint64_t first_update_id{0}; // U
+  uint64_t final_update_id{0}; // u
+  DepthLevels bids{};
+  DepthLevels asks{};
+};
+
+/// @brief Свеча (<symbol>@kline_<interval>)
+struct KlineEvent {
+  std::string_view symbol{};
+  std::string_view interval{};
+  uint64_t event_time{0};
+  uint64_t start_time{0};
+  uint64_t close_time{0};
+  dec::decimal<8> open{};
+  dec::decimal<8> high{};
+  dec::decimal<8> low{};
+  dec::decimal<8> close{};
+  dec::decimal<8> volume{};
+  uint64_t trades{0};
+  bool closed{false};
+};
+
+/// @brief Имя потока для торговой пары
+/// @param symbol Торговая пара ("BTCUSDT")
+/// @param type Тип потока ("trade", "bookTicker", "depth@100ms", "kline_1m")
+/// @return Имя потока ("btcusdt@trade")
+static std::string stream_name(const std::string &symbol, const std::string &type) {
+  std::string result{};
+  result.reserve(symbol.size() + type.size() + 1);
+  for (char c : symbol) {
+    result += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  result += '@';
+  result += type;
+  return result;
+}
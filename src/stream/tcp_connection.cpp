@@ -0,0 +1,172 @@
+#include "tcp_connection.hpp"
+
+#include <cstring>
+#include <cerrno>
+#include <netdb.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/err.h>
+
+Status TcpConnection::connect(const std::string &host, int port, bool tls, int timeout_ms) {
+  close();
+  Status status = tcp_connect(host, port, timeout_ms);
+  if ((0 == status.code) && tls) {
+    status = tls_connect(host);
+  }
+  if (0 != status.code) {
+    close();
+  }
+  return status;
+}
+
+void TcpConnection::adopt(int fd) {
+  close();
+  sock = fd;
+  int flag{1};
+  setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+}
+
+void TcpConnection::set_nonblocking() {
+  fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+}
+
+Status TcpConnection::tcp_connect(const std::string &host, int port, int timeout_ms) {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo *addrs{nullptr};
+  int res = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addrs);
+  if (0 != res) {
+    return Status(res, std::string(gai_strerror(res)));
+  }
+  Status status(-1, std::string("Connection failed"));
+  for (addrinfo *ai = addrs; nullptr != ai; ai = ai->ai_next) {
+    sock = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+    if (sock < 0) {
+      continue;
+    }
+    timeval tv{timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    if (0 == ::connect(sock, ai->ai_addr, ai->ai_addrlen)) {
+      int flag{1};
+      setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+      status = Status(0, std::string("OK"));
+      break;
+    }
+    status = Status(errno, std::string(strerror(errno)));
+    ::close(sock);
+    sock = -1;
+  }
+  freeaddrinfo(addrs);
+  return status;
+}
+
+Status TcpConnection::tls_connect(const std::string &host) {
+  ssl_ctx = SSL_CTX_new(TLS_client_method());
+  if (nullptr == ssl_ctx) {
+    return Status(-1, std::string("SSL_CTX_new failed"));
+  }
+  SSL_CTX_set_default_verify_paths(ssl_ctx);
+  SSL_CTX_set_verify(ssl_ctx, SSL_VERIFY_PEER, nullptr);
+  SSL_CTX_set_mode(ssl_ctx, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+  ssl = SSL_new(ssl_ctx);
+  SSL_set_fd(ssl, sock);
+  SSL_set_tlsext_host_name(ssl, host.c_str());
+  SSL_set1_host(ssl, host.c_str());
+  if (1 != SSL_connect(ssl)) {
+    unsigned long err = ERR_get_error();
+    char msg[256];
+    ERR_error_string_n(err, msg, sizeof(msg));
+    return Status(-1, std::string(msg));
+  }
+  return Status(0, std::string("OK"));
+}
+
+int TcpConnection::read(char *buffer, size_t size) {
+  if (nullptr != ssl) {
+    std::lock_guard<std::mutex> lock(ssl_mtx);
+    int n = SSL_read(ssl, buffer, static_cast<int>(size));
+    if (n > 0) {
+      return n;
+    }
+    int err = SSL_get_error(ssl, n);
+    return ((SSL_ERROR_WANT_READ == err) || (SSL_ERROR_WANT_WRITE == err)) ? 0 : -1;
+  }
+  ssize_t n = ::recv(sock, buffer, size, 0);
+  if (n > 0) {
+    return static_cast<int>(n);
+  }
+  if ((n < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno))) {
+    return 0;
+  }
+  return -1;
+}
+
+bool TcpConnection::write(const char *buffer, size_t size) {
+  size_t sent{0};
+  while (sent < size) {
+    ssize_t n{0};
+    bool again{false};
+    if (nullptr != ssl) {
+      std::lock_guard<std::mutex> lock(ssl_mtx);
+      int r = SSL_write(ssl, buffer + sent, static_cast<int>(size - sent));
+      if (r > 0) {
+        n = r;
+      }
+      else {
+        int err = SSL_get_error(ssl, r);
+        again = (SSL_ERROR_WANT_WRITE == err) || (SSL_ERROR_WANT_READ == err);
+        n = -1;
+      }
+    }
+    else {
+      n = ::send(sock, buffer + sent, size - sent, MSG_NOSIGNAL);
+      again = (n < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno));
+    }
+    if (n > 0) {
+      sent += n;
+    }
+    else if (again) {
+      pollfd pfd{sock, POLLOUT, 0};
+      ::poll(&pfd, 1, def_timeout_ms);
+    }
+    else {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TcpConnection::wait_read(int timeout_ms) {
+  if ((nullptr != ssl) && (0 < SSL_pending(ssl))) {
+    return true;
+  }
+  pollfd pfd{sock, POLLIN, 0};
+  return 0 < ::poll(&pfd, 1, timeout_ms);
+}
+
+void TcpConnection::close() {
+  std::lock_guard<std::mutex> lock(ssl_mtx);
+  if (nullptr != ssl) {
+    SSL_shutdown(ssl);
+    SSL_free(ssl);
+    ssl = nullptr;
+  }
+  if (nullptr != ssl_ctx) {
+    SSL_CTX_free(ssl_ctx);
+    ssl_ctx = nullptr;
+  }
+  if (0 <= sock) {
+    ::close(sock);
+    sock = -1;
+  }
+}
+
+TcpConnection::~TcpConnection() {
+  close();
+}
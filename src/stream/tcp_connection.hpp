@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <mutex>
+#include <openssl/ssl.h>
+
+#include "../request/request.hpp"
+
+/// @brief Соединение TCP или TLS (OpenSSL) - транспорт WebSocket и FIX сессий.
+/// Пока идет рукопожатие протокола, сокет блокирующий с таймаутами; после set_nonblocking()
+/// read() не ждет данных, ожидание - wait_read().
+class TcpConnection {
+private:
+  int sock{-1};
+  SSL_CTX *ssl_ctx{nullptr};
+  SSL *ssl{nullptr};
+  std::mutex ssl_mtx;
+
+  Status tcp_connect(const std::string &host, int port, int timeout_ms);
+  Status tls_connect(const std::string &host);
+public:
+  TcpConnection() = default;
+  TcpConnection(const TcpConnection&) = delete;
+  TcpConnection& operator=(const TcpConnection&) = delete;
+
+  /// @brief Подключение к серверу
+  /// @param host Адрес сервера
+  /// @param port Порт
+  /// @param tls True - TLS с проверкой сертификата и имени сервера
+  /// @param timeout_ms Таймаут подключения и операций блокирующего сокета
+  /// @return Status (code 0 - успех)
+  Status connect(const std::string &host, int port, bool tls, int timeout_ms = def_timeout_ms);
+
+  /// @brief Принять во владение подключенный сокет без TLS (серверная сторона локальных заглушек)
+  /// @param fd Сокет
+  void adopt(int fd);
+
+  /// @brief Перевод сокета в неблокирующий режим
+  void set_nonblocking();
+
+  /// @brief Чтение доступных данных
+  /// @return Прочитано байт; 0 - данных нет; -1 - соединение закрыто или ошибка
+  int read(char *buffer, size_t size);
+
+  /// @brief Запись всех данных (с ожиданием готовности сокета)
+  /// @return True - успех
+  bool write(const char *buffer, size_t size);
+
+  /// @brief Ожидание данных для чтения (с учетом данных, уже расшифрованных TLS)
+  /// @param timeout_ms Ожидание (0 - не ждать)
+  /// @return True - данные есть
+  bool wait_read(int timeout_ms);
+
+  /// @brief Соединение установлено (сокет не закрыт)
+  bool valid() const { return 0 <= sock; }
+
+  /// @brief Дескриптор сокета
+  int fd() const { return sock; }
+
+  /// @brief Закрытие соединения
+  void close();
+
+  ~TcpConnection();
+};
@@ -0,0 +1,255 @@
+#include "user_stream.hpp"
+
+#include "./json_scan.hpp"
+#include "../utils/fast_decimal.hpp"
+
+UserDataStream::UserDataStream(Binance &binance, UserStreamConfig config)
+    : UserDataStream(ListenKeyApi{[&binance]() { return binance.create_listen_key(); },
+                                  [&binance](const std::string &key) { binance.keepalive_listen_key(key); },
+                                  [&binance](const std::string &key) { binance.close_listen_key(key); }},
+                     config) {}
+
+UserDataStream::UserDataStream(ListenKeyApi api, UserStreamConfig config) : api(api), config(config), ws(config.buffer_size) {}
+
+Status UserDataStream::start() {
+  if (running) {
+    return Status(0, std::string("OK"));
+  }
+  need_key = true;
+  need_reconnect = false;
+  Status status = open();
+  if (0 != status.code) {
+    return status;
+  }
+  running = true;
+  reader = std::thread(&UserDataStream::read_loop, this);
+  timer = std::thread(&UserDataStream::keepalive_loop, this);
+  return status;
+}
+
+void UserDataStream::stop() {
+  if (!running.exchange(false)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    cv.notify_all();
+  }
+  if (reader.joinable()) {
+    reader.join();
+  }
+  if (timer.joinable()) {
+    timer.join();
+  }
+  std::string key{};
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    key.swap(listen_key);
+  }
+  if (!key.empty() && api.close) {
+    try {
+      api.close(key);
+    }
+    catch (BinanceException &) {}
+  }
+}
+
+UserStreamStats UserDataStream::stats() const {
+  return UserStreamStats{n_messages.load(), n_orders.load(), n_balances.load(), n_errors.load(),
+                         n_reconnects.load(), n_keepalives.load(), n_keepalive_errors.load()};
+}
+
+Status UserDataStream::open() {
+  std::string key{};
+  if (need_key.exchange(false)) {
+    try {
+      key = api.create();
+    }
+    catch (BinanceException &e) {
+      need_key = true;
+      return Status(e.e_code, e.e_msg);
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    listen_key = key;
+  }
+  else {
+    std::lock_guard<std::mutex> lock(mtx);
+    key = listen_key;
+  }
+  return ws.connect(config.host, config.port, "/ws/" + key, config.tls);
+}
+
+bool UserDataStream::wait(std::chrono::milliseconds delay) {
+  std::unique_lock<std::mutex> lock(mtx);
+  cv.wait_for(lock, delay, [this]() { return !running; });
+  return running;
+}
+
+void UserDataStream::read_loop() {
+  std::chrono::milliseconds delay{config.reconnect_min};
+  while (running) {
+    if (need_reconnect.exchange(false)) {
+      ws.close();
+    }
+    if (!ws.is_open()) {
+      if (0 != open().code) {
+        if (!wait(delay)) {
+          break;
+        }
+        delay = std::min(delay * 2, config.reconnect_max);
+        continue;
+      }
+      delay = config.reconnect_min;
+      n_reconnects++;
+      if (reconnect_cb) {
+        try {
+          reconnect_cb();
+        }
+        catch (BinanceException &) {
+          n_errors++;
+        }
+      }
+    }
+    ws.poll([this](WsOpcode, std::string_view message) { dispatch(message); }, 100);
+  }
+  ws.close();
+}
+
+void UserDataStream::keepalive_loop() {
+  std::unique_lock<std::mutex> lock(mtx);
+  while (running) {
+    if (cv.wait_for(lock, config.keepalive, [this]() { return !running; })) {
+      break;
+    }
+    std::string key{listen_key};
+    lock.unlock();
+    try {
+      api.keepalive(key);
+      n_keepalives++;
+    }
+    catch (BinanceException &) {
+      // Ключ недействителен: поток чтения переподключится с новым ключом
+      n_keepalive_errors++;
+      need_key = true;
+      need_reconnect = true;
+    }
+    lock.lock();
+  }
+}
+
+void UserDataStream::dispatch(std::string_view message) {
+  n_messages++;
+  std::string_view data{message};
+  std::string_view value{};
+  if (JsonScanner::find(message, "data", value) && value.starts_with('{')) {
+    data = value;
+  }
+  std::string_view type{};
+  if (!JsonScanner::find(data, "e", type)) {
+    n_errors++;
+    return;
+  }
+  bool ok{true};
+  if ("executionReport" == type) {
+    ok = decode_execution_report(data);
+  }
+  else if ("outboundAccountPosition" == type) {
+    ok = decode_account_position(data);
+  }
+  else if ("listenKeyExpired" == type) {
+    need_key = true;
+    need_reconnect = true;
+  }
+  if (!ok) {
+    n_errors++;
+  }
+}
+
+bool UserDataStream::decode_execution_report(std::string_view data) {
+  ExecutionReport &ev = report;
+  ev = ExecutionReport{};
+  JsonScanner scanner{data};
+  std::string_view key{};
+  std::string_view value{};
+  int fields{0};
+  while (scanner.next(key, value)) {
+    if (1 != key.size()) {
+      continue;
+    }
+    switch (key[0]) {
+      case 'E': ev.event_time = json_to_u64(value); break;
+      case 's': ev.order.symbol = value; fields++; break;
+      case 'c': ev.client_order_id = value; break;
+      case 'S': ev.order.side = str_to_side(value); break;
+      case 'q': ev.order.origQty = str_to_decimal<8>(value); break;
+      case 'p': ev.order.price = str_to_decimal<8>(value); break;
+      case 'P': ev.order.stopPrice = str_to_decimal<8>(value); break;
+      case 'Q': ev.order.quoteOrderQty = str_to_decimal<8>(value); break;
+      case 'o': ev.order.type = str_to_order_type(value); break;
+      case 'f': ev.order.timeInForce = str_to_time_in_force(value); break;
+      case 'x': ev.execution_type = value; break;
+      case 'X': ev.order.status = str_to_order_status(value); fields++; break;
+      case 'r': ev.reject_reason = value; break;
+      case 'i': ev.order.orderId = json_to_u64(value); fields++; break;
+      case 'l': ev.last_qty = str_to_decimal<8>(value); break;
+      case 'z': ev.cum_qty = str_to_decimal<8>(value); break;
+      case 'L': ev.last_price = str_to_decimal<8>(value); break;
+      case 'n': ev.commission = str_to_decimal<8>(value); break;
+      case 'N': ev.commission_asset = ("null" == value) ? std::string_view() : value; break;
+      case 'T': ev.order.time = json_to_u64(value); break;
+      case 't': ev.trade_id = ("-1" == value) ? 0 : json_to_u64(value); break;
+      case 'm': ev.maker = ("true" == value); break;
+      case 'Z': ev.cum_quote_qty = str_to_decimal<8>(value); break;
+      default: break;
+    }
+  }
+  if (3 != fields) {
+    return false;
+  }
+  n_orders++;
+  if (order_cb) {
+    order_cb(ev);
+  }
+  return true;
+}
+
+bool UserDataStream::decode_account_position(std::string_view data) {
+  std::string_view balances{};
+  if (!JsonScanner::find(data, "B", balances)) {
+    return false;
+  }
+  balance_update.clear();
+  JsonScanner array{balances};
+  std::string_view item{};
+  while (array.next(item)) {
+    JsonScanner scanner{item};
+    std::string_view key{};
+    std::string_view value{};
+    std::string_view asset{};
+    BalanceData asset_balance{};
+    while (scanner.next(key, value)) {
+      if ("a" == key) {
+        asset = value;
+      }
+      else if ("f" == key) {
+        asset_balance.free = str_to_decimal<8>(value);
+      }
+      else if ("l" == key) {
+        asset_balance.locked = str_to_decimal<8>(value);
+      }
+    }
+    if (asset.empty()) {
+      return false;
+    }
+    balance_update.balance[std::string(asset)] = asset_balance;
+  }
+  n_balances++;
+  if (balance_cb) {
+    balance_cb(balance_update);
+  }
+  return true;
+}
+
+UserDataStream::~UserDataStream() {
+  stop();
+}
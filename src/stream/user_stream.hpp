@@ -0,0 +1,139 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <functional>
+
+#include "../binance/binance.hpp"
+#include "./websocket.hpp"
+
+/// @brief Настройки потока пользовательских данных
+struct UserStreamConfig {
+  std::string host{"stream.binance.com"};
+  int port{9443};
+  bool tls{true};
+  std::chrono::milliseconds keepalive{30 * 60 * 1000}; // Период продления listenKey (ключ действует 60 минут)
+  std::chrono::milliseconds reconnect_min{500}; // Начальная задержка переподключения
+  std::chrono::milliseconds reconnect_max{30000}; // Максимальная задержка переподключения
+  size_t buffer_size{1 << 16};
+};
+
+/// @brief Отчет об исполнении ордера (executionReport)
+struct ExecutionReport {
+  Order order{}; // Ордер: тип, timeInForce, цены и количества заявки, статус после события, time - время события ордера (T)
+  std::string client_order_id{};
+  std::string execution_type{}; // NEW, CANCELED, REPLACED, REJECTED, TRADE, EXPIRED, TRADE_PREVENTION
+  std::string reject_reason{};
+  uint64_t event_time{0};
+  uint64_t trade_id{0};
+  dec::decimal<8> last_qty{}; // Исполнено этим событием
+  dec::decimal<8> last_price{};
+  dec::decimal<8> cum_qty{}; // Исполнено всего
+  dec::decimal<8> cum_quote_qty{};
+  dec::decimal<8> commission{};
+  std::string commission_asset{};
+  bool maker{false};
+};
+
+/// @brief Статистика потока пользовательских данных
+struct UserStreamStats {
+  uint64_t messages{0};
+  uint64_t orders{0}; // executionReport
+  uint64_t balances{0}; // outboundAccountPosition
+  uint64_t errors{0}; // Сообщений, которые не удалось разобрать, и ошибок обработчика on_reconnect
+  uint64_t reconnects{0};
+  uint64_t keepalives{0};
+  uint64_t keepalive_errors{0};
+};
+
+/// @brief Поток пользовательских данных Binance (listenKey + WebSocket /ws/<listenKey>).
+/// Заменяет опрос open_orders/order_info/balance: executionReport передается обработчику как ExecutionReport
+/// (с Order внутри), outboundAccountPosition - как Balance с измененными активами.
+/// Обработчики вызываются из потока чтения. Ключ продлевается потоком таймера; при ошибке продления,
+/// событии listenKeyExpired или разрыве соединения поток переподключается автоматически
+/// (с новым ключом при необходимости) с экспоненциальной задержкой.
+/// События между разрывом и переподключением (в том числе при смене listenKey) сервер не повторяет и они теряются:
+/// вызывающий код должен сверить состояние в обработчике on_reconnect (open_orders и balance).
+class UserDataStream {
+public:
+  /// @brief Операции с listenKey (по умолчанию - методы Binance)
+  struct ListenKeyApi {
+    std::function<std::string()> create{};
+    std::function<void(const std::string&)> keepalive{};
+    std::function<void(const std::string&)> close{};
+  };
+private:
+  ListenKeyApi api;
+  UserStreamConfig config;
+  WebSocket ws;
+  std::function<void(const ExecutionReport&)> order_cb{};
+  std::function<void(const Balance&)> balance_cb{};
+  std::function<void()> reconnect_cb{};
+  ExecutionReport report{};
+  Balance balance_update{};
+  std::mutex mtx; // listen_key, cv
+  std::condition_variable cv;
+  std::string listen_key{};
+  std::atomic<bool> running{false};
+  std::atomic<bool> need_key{false}; // Нужен новый listenKey
+  std::atomic<bool> need_reconnect{false};
+  std::thread reader{};
+  std::thread timer{};
+  std::atomic<uint64_t> n_messages{0};
+  std::atomic<uint64_t> n_orders{0};
+  std::atomic<uint64_t> n_balances{0};
+  std::atomic<uint64_t> n_errors{0};
+  std::atomic<uint64_t> n_reconnects{0};
+  std::atomic<uint64_t> n_keepalives{0};
+  std::atomic<uint64_t> n_keepalive_errors{0};
+
+  Status open();
+  void read_loop();
+  void keepalive_loop();
+  bool wait(std::chrono::milliseconds delay);
+  void dispatch(std::string_view message);
+  bool decode_execution_report(std::string_view data);
+  bool decode_account_position(std::string_view data);
+public:
+  /// @brief Конструктор потока поверх клиента Binance
+  /// @param binance Клиент Binance (должен жить дольше потока)
+  /// @param config Настройки
+  UserDataStream(Binance &binance, UserStreamConfig config = UserStreamConfig{});
+
+  /// @brief Конструктор потока с произвольными операциями listenKey
+  /// @param api Операции с listenKey
+  /// @param config Настройки
+  UserDataStream(ListenKeyApi api, UserStreamConfig config = UserStreamConfig{});
+  UserDataStream(const UserDataStream&) = delete;
+  UserDataStream& operator=(const UserDataStream&) = delete;
+
+  /// @brief Обработчик изменений ордеров (устанавливается до start)
+  void on_order(std::function<void(const ExecutionReport&)> callback) { order_cb = callback; }
+  /// @brief Обработчик изменений баланса (устанавливается до start)
+  void on_balance(std::function<void(const Balance&)> callback) { balance_cb = callback; }
+  /// @brief Обработчик переподключения (устанавливается до start). Вызывается из потока чтения после каждого
+  /// переподключения до первого события нового соединения: события за время разрыва потеряны, обработчик должен
+  /// загрузить состояние заново (open_orders по своим парам и balance). События, пришедшие во время сверки,
+  /// передаются обработчикам после нее. BinanceException обработчика учитывается в stats().errors
+  void on_reconnect(std::function<void()> callback) { reconnect_cb = callback; }
+
+  /// @brief Создание listenKey, подключение и запуск потоков чтения и продления ключа
+  /// @return Status (code 0 - успех)
+  Status start();
+
+  /// @brief Остановка потоков, закрытие соединения и listenKey
+  void stop();
+
+  /// @brief Соединение открыто
+  bool is_connected() const { return ws.is_open(); }
+
+  /// @brief Статистика потока
+  UserStreamStats stats() const;
+
+  ~UserDataStream();
+};
@@ -0,0 +1,349 @@
+#include "websocket.hpp"
+
+#include <cstring>
+#include <unistd.h>
+#include <openssl/sha.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+namespace {
+
+const std::string ws_guid{"258EAFA5-E914-47DA-95CA-C5AB0DC11B85"};
+
+std::string base64(const unsigned char *data, size_t size) {
+  std::string result(4 * ((size + 2) / 3), '\0');
+  int n = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(result.data()), data, static_cast<int>(size));
+  result.resize(n);
+  return result;
+}
+
+std::string accept_key(const std::string &key) {
+  std::string src{key + ws_guid};
+  unsigned char digest[SHA_DIGEST_LENGTH];
+  SHA1(reinterpret_cast<const unsigned char*>(src.data()), src.size(), digest);
+  return base64(digest, SHA_DIGEST_LENGTH);
+}
+
+/// @brief Значение поля HTTP заголовка (без учета регистра имени)
+std::string header_value(const std::string &header, const std::string &name) {
+  size_t pos{0};
+  while (pos < header.size()) {
+    size_t end = header.find("\r\n", pos);
+    if (std::string::npos == end) {
+      end = header.size();
+    }
+    std::string_view line{header.data() + pos, end - pos};
+    size_t colon = line.find(':');
+    if ((std::string_view::npos != colon) && (colon == name.size()) &&
+        std::equal(name.begin(), name.end(), line.begin(), [](char a, char b) { return std::tolower(a) == std::tolower(b); })) {
+      std::string_view value = line.substr(colon + 1);
+      while (!value.empty() && (' ' == value.front())) {
+        value.remove_prefix(1);
+      }
+      return std::string(value);
+    }
+    pos = end + 2;
+  }
+  return std::string{};
+}
+
+/// @brief Снятие маски на месте (по 8 байт)
+void unmask(char *data, size_t size, const unsigned char *mask) {
+  uint64_t mask64{0};
+  for (int i = 0; i < 8; i++) {
+    reinterpret_cast<unsigned char*>(&mask64)[i] = mask[i % 4];
+  }
+  size_t i{0};
+  for (; i + 8 <= size; i += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data + i, 8);
+    chunk ^= mask64;
+    std::memcpy(data + i, &chunk, 8);
+  }
+  for (; i < size; i++) {
+    data[i] ^= mask[i % 4];
+  }
+}
+
+}
+
+WebSocket::WebSocket(size_t buffer_size) : ring(buffer_size) {}
+
+Status WebSocket::connect(const std::string &host, int port, const std::string &path, bool tls, int timeout_ms) {
+  close();
+  if (!ring.valid()) {
+    return Status(-1, std::string("Ring buffer allocation failed"));
+  }
+  server = false;
+  Status status = conn.connect(host, port, tls, timeout_ms);
+  if (0 == status.code) {
+    status = client_handshake(host, path);
+  }
+  if (0 != status.code) {
+    shutdown_socket();
+    return status;
+  }
+  conn.set_nonblocking();
+  open = true;
+  return status;
+}
+
+Status WebSocket::accept(int fd) {
+  close();
+  if (!ring.valid()) {
+    ::close(fd);
+    return Status(-1, std::string("Ring buffer allocation failed"));
+  }
+  server = true;
+  conn.adopt(fd);
+  Status status = server_handshake();
+  if (0 != status.code) {
+    shutdown_socket();
+    return status;
+  }
+  conn.set_nonblocking();
+  open = true;
+  return status;
+}
+
+Status WebSocket::client_handshake(const std::string &host, const std::string &path) {
+  unsigned char nonce[16];
+  RAND_bytes(nonce, sizeof(nonce));
+  std::string key{base64(nonce, sizeof(nonce))};
+  std::string request = std::format("GET {} HTTP/1.1\r\nHost: {}\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                    "Sec-WebSocket-Key: {}\r\nSec-WebSocket-Version: 13\r\nUser-Agent: binance/core/cpp/api\r\n\r\n",
+                                    path, host, key);
+  if (!conn.write(request.data(), request.size())) {
+    return Status(-1, std::string("Handshake send failed"));
+  }
+  std::string header{};
+  Status status = read_http_header(header);
+  if (0 != status.code) {
+    return status;
+  }
+  if ((0 != header.compare(0, 12, "HTTP/1.1 101")) || (accept_key(key) != header_value(header, "Sec-WebSocket-Accept"))) {
+    return Status(-1, header.substr(0, header.find("\r\n")));
+  }
+  return Status(0, std::string("OK"));
+}
+
+Status WebSocket::server_handshake() {
+  std::string header{};
+  Status status = read_http_header(header);
+  if (0 != status.code) {
+    return status;
+  }
+  std::string key{header_value(header, "Sec-WebSocket-Key")};
+  if (key.empty()) {
+    return Status(-1, std::string("Sec-WebSocket-Key not found"));
+  }
+  std::string response = std::format("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                     "Sec-WebSocket-Accept: {}\r\n\r\n", accept_key(key));
+  if (!conn.write(response.data(), response.size())) {
+    return Status(-1, std::string("Handshake send failed"));
+  }
+  return Status(0, std::string("OK"));
+}
+
+Status WebSocket::read_http_header(std::string &header) {
+  // Данные после заголовка (первые кадры) остаются в кольцевом буфере
+  while (true) {
+    std::string_view data{ring.read_ptr(), ring.readable()};
+    size_t end = data.find("\r\n\r\n");
+    if (std::string_view::npos != end) {
+      header.assign(data.substr(0, end + 2));
+      ring.consume(end + 4);
+      return Status(0, std::string("OK"));
+    }
+    if (0 == ring.writable()) {
+      return Status(-1, std::string("HTTP header too large"));
+    }
+    int n = conn.read(ring.write_ptr(), ring.writable());
+    if (n <= 0) {
+      return Status(-1, std::string("Handshake read failed"));
+    }
+    ring.commit(n);
+  }
+}
+
+int WebSocket::read_some() {
+  int total{0};
+  while (0 < ring.writable()) {
+    int n = conn.read(ring.write_ptr(), ring.writable());
+    if (n < 0) {
+      open = false;
+      return (0 < total) ? total : -1;
+    }
+    if (0 == n) {
+      break;
+    }
+    ring.commit(n);
+    total += n;
+  }
+  return total;
+}
+
+bool WebSocket::wait_read(int timeout_ms) {
+  if (!conn.wait_read(timeout_ms)) {
+    return false;
+  }
+  return 0 < read_some();
+}
+
+int WebSocket::parse_frame(WsOpcode &opcode, bool &fin, std::string_view &payload, size_t &size) {
+  size_t avail = ring.readable();
+  if (avail < 2) {
+    return 0;
+  }
+  unsigned char *p = reinterpret_cast<unsigned char*>(ring.read_ptr());
+  fin = 0 != (p[0] & 0x80);
+  opcode = static_cast<WsOpcode>(p[0] & 0x0F);
+  bool masked = 0 != (p[1] & 0x80);
+  uint64_t length = p[1] & 0x7F;
+  size_t header{2};
+  if (126 == length) {
+    if (avail < 4) {
+      return 0;
+    }
+    length = (uint64_t{p[2]} << 8) | p[3];
+    header = 4;
+  }
+  else if (127 == length) {
+    if (avail < 10) {
+      return 0;
+    }
+    length = 0;
+    for (int i = 0; i < 8; i++) {
+      length = (length << 8) | p[2 + i];
+    }
+    header = 10;
+  }
+  const unsigned char *mask{nullptr};
+  if (masked) {
+    mask = p + header;
+    header += 4;
+  }
+  if (length + header > ring.capacity()) {
+    return -1;
+  }
+  if (avail < header + length) {
+    return 0;
+  }
+  char *data = reinterpret_cast<char*>(p + header);
+  if (masked) {
+    unmask(data, length, mask);
+  }
+  payload = std::string_view(data, length);
+  size = header + length;
+  return 1;
+}
+
+int WebSocket::next_message(WsOpcode &opcode, std::string_view &payload) {
+  while (true) {
+    bool fin{true};
+    size_t size{0};
+    int r = parse_frame(opcode, fin, payload, size);
+    if (r <= 0) {
+      if (r < 0) {
+        shutdown_socket();
+      }
+      return r;
+    }
+    switch (opcode) {
+      case WsOpcode::TEXT:
+      case WsOpcode::BINARY:
+        if (fin) {
+          frame_size = size;
+          return 1;
+        }
+        fragments.assign(payload);
+        fragments_opcode = opcode;
+        break;
+      case WsOpcode::CONTINUATION:
+        fragments.append(payload);
+        if (fin) {
+          ring.consume(size);
+          frame_size = 0;
+          opcode = fragments_opcode;
+          payload = fragments;
+          return 1;
+        }
+        break;
+      case WsOpcode::PING:
+        send(WsOpcode::PONG, payload);
+        break;
+      case WsOpcode::CLOSE:
+        send(WsOpcode::CLOSE, payload.substr(0, std::min<size_t>(payload.size(), 2)));
+        ring.consume(size);
+        shutdown_socket();
+        return -1;
+      default:
+        break;
+    }
+    ring.consume(size);
+  }
+}
+
+void WebSocket::release() {
+  ring.consume(frame_size);
+  frame_size = 0;
+}
+
+bool WebSocket::send(WsOpcode opcode, std::string_view payload) {
+  std::lock_guard<std::mutex> lock(send_mtx);
+  if (!conn.valid()) {
+    return false;
+  }
+  send_buffer.clear();
+  send_buffer.push_back(static_cast<char>(0x80 | static_cast<uint8_t>(opcode)));
+  uint8_t mask_bit = server ? 0x00 : 0x80;
+  size_t length = payload.size();
+  if (length < 126) {
+    send_buffer.push_back(static_cast<char>(mask_bit | length));
+  }
+  else if (length <= 0xFFFF) {
+    send_buffer.push_back(static_cast<char>(mask_bit | 126));
+    send_buffer.push_back(static_cast<char>((length >> 8) & 0xFF));
+    send_buffer.push_back(static_cast<char>(length & 0xFF));
+  }
+  else {
+    send_buffer.push_back(static_cast<char>(mask_bit | 127));
+    for (int i = 7; i >= 0; i--) {
+      send_buffer.push_back(static_cast<char>((length >> (8 * i)) & 0xFF));
+    }
+  }
+  size_t offset = send_buffer.size();
+  if (server) {
+    send_buffer.append(payload);
+  }
+  else {
+    uint32_t mask_key = static_cast<uint32_t>(mask_gen());
+    unsigned char mask[4];
+    std::memcpy(mask, &mask_key, 4);
+    send_buffer.append(reinterpret_cast<const char*>(mask), 4);
+    offset += 4;
+    send_buffer.append(payload);
+    unmask(send_buffer.data() + offset, length, mask);
+  }
+  return conn.write(send_buffer.data(), send_buffer.size());
+}
+
+void WebSocket::close() {
+  if (open) {
+    send(WsOpcode::CLOSE, std::string_view("\x03\xE8", 2));
+  }
+  shutdown_socket();
+}
+
+void WebSocket::shutdown_socket() {
+  open = false;
+  std::lock_guard<std::mutex> send_lock(send_mtx);
+  conn.close();
+  ring.clear();
+  fragments.clear();
+  frame_size = 0;
+}
+
+WebSocket::~WebSocket() {
+  close();
+}
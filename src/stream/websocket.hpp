@@ -0,0 +1,127 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <mutex>
+#include <random>
+#include <atomic>
+
+#include "../request/request.hpp"
+#include "./tcp_connection.hpp"
+#include "../utils/ring_buffer.hpp"
+
+/// @brief Размер буфера приема WebSocket по умолчанию
+const size_t def_ws_buffer_size = 1 << 20;
+
+/// @brief Тип кадра WebSocket (RFC 6455)
+enum class WsOpcode : uint8_t {
+  CONTINUATION = 0x0,
+  TEXT = 0x1,
+  BINARY = 0x2,
+  CLOSE = 0x8,
+  PING = 0x9,
+  PONG = 0xA
+};
+
+/// @brief Клиент (или серверная сторона для локальных заглушек) WebSocket поверх TCP/TLS(OpenSSL).
+/// Входящие кадры разбираются на месте в кольцевом буфере, маска снимается без копирования,
+/// сообщение передается обработчику как std::string_view (действительно только внутри обработчика).
+/// PING/PONG/CLOSE обрабатываются автоматически.
+class WebSocket {
+private:
+  TcpConnection conn;
+  bool server{false}; // Серверная сторона: кадры отправляются без маски
+  std::atomic<bool> open{false};
+  RingBuffer ring;
+  std::string fragments{}; // Сборка фрагментированных сообщений
+  WsOpcode fragments_opcode{WsOpcode::TEXT};
+  size_t frame_size{0}; // Размер последнего выданного кадра (освобождается в release)
+  std::mutex send_mtx;
+  std::string send_buffer{};
+  std::mt19937 mask_gen{std::random_device{}()};
+
+  Status client_handshake(const std::string &host, const std::string &path);
+  Status server_handshake();
+  Status read_http_header(std::string &header);
+  int read_some();
+  bool wait_read(int timeout_ms);
+  int parse_frame(WsOpcode &opcode, bool &fin, std::string_view &payload, size_t &size);
+  int next_message(WsOpcode &opcode, std::string_view &payload);
+  void release();
+  void shutdown_socket();
+public:
+  /// @brief Конструктор WebSocket
+  /// @param buffer_size Размер кольцевого буфера приема (максимальный размер кадра)
+  WebSocket(size_t buffer_size = def_ws_buffer_size);
+  WebSocket(const WebSocket&) = delete;
+  WebSocket& operator=(const WebSocket&) = delete;
+
+  /// @brief Подключение к серверу и рукопожатие WebSocket
+  /// @param host Адрес сервера
+  /// @param port Порт
+  /// @param path Путь ресурса (например "/ws/btcusdt@trade")
+  /// @param tls True - wss (TLS), False - ws
+  /// @param timeout_ms Таймаут подключения
+  /// @return Status (code 0 - успех)
+  Status connect(const std::string &host, int port, const std::string &path, bool tls, int timeout_ms = def_timeout_ms);
+
+  /// @brief Рукопожатие серверной стороны на принятом сокете (для локальных заглушек)
+  /// @param fd Принятый сокет (передается во владение WebSocket)
+  /// @return Status (code 0 - успех)
+  Status accept(int fd);
+
+  /// @brief Отправка кадра
+  /// @param opcode Тип кадра
+  /// @param payload Данные
+  /// @return True - успех
+  bool send(WsOpcode opcode, std::string_view payload);
+
+  /// @brief Отправка текстового сообщения
+  bool send_text(std::string_view payload) { return send(WsOpcode::TEXT, payload); }
+
+  /// @brief Прием и обработка сообщений
+  /// @param on_message Обработчик (WsOpcode, std::string_view)
+  /// @param timeout_ms Ожидание данных (0 - не ждать)
+  /// @param max_messages Не более сообщений за вызов (-1 - без ограничения), остальные остаются в буфере
+  /// @return Количество обработанных сообщений; -1 - соединение закрыто
+  template<typename F>
+  int poll(F &&on_message, int timeout_ms, int max_messages = -1) {
+    if (!open) {
+      return -1;
+    }
+    WsOpcode opcode{WsOpcode::TEXT};
+    std::string_view payload{};
+    int r = next_message(opcode, payload);
+    if (0 == r) {
+      if (!wait_read(timeout_ms)) {
+        return open ? 0 : -1;
+      }
+      r = next_message(opcode, payload);
+    }
+    int count{0};
+    while (0 < r) {
+      on_message(opcode, payload);
+      release();
+      count++;
+      if (count == max_messages) {
+        break;
+      }
+      r = next_message(opcode, payload);
+    }
+    return ((0 > r) && (0 == count)) ? -1 : count;
+  }
+
+  /// @brief Закрыть соединение (с отправкой кадра CLOSE)
+  void close();
+
+  /// @brief Соединение открыто
+  bool is_open() const { return open; }
+
+  /// @brief Дескриптор сокета (для ожидания нескольких соединений одним poll)
+  int fd() const { return conn.fd(); }
+
+  /// @brief Количество принятых, но еще не обработанных байт
+  size_t buffered() const { return ring.readable(); }
+
+  ~WebSocket();
+};
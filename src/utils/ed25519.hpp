@@ -0,0 +1,76 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+
+/// @brief Подпись Ed25519 ключом API Binance (session.logon WebSocket API, Logon FIX API).
+/// Подпись возвращается в base64, как ее ожидает Binance.
+class Ed25519Signer {
+private:
+  EVP_PKEY *key{nullptr};
+public:
+  /// @brief Конструктор подписи
+  /// @param pem Закрытый ключ Ed25519 в формате PEM (PKCS#8)
+  explicit Ed25519Signer(const std::string &pem) {
+    BIO *bio = BIO_new_mem_buf(pem.data(), static_cast<int>(pem.size()));
+    if (bio) {
+      key = PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr);
+      BIO_free(bio);
+    }
+    if (key && (EVP_PKEY_ED25519 != EVP_PKEY_id(key))) {
+      EVP_PKEY_free(key);
+      key = nullptr;
+    }
+  }
+  Ed25519Signer(const Ed25519Signer&) = delete;
+  Ed25519Signer& operator=(const Ed25519Signer&) = delete;
+
+  /// @brief Ключ загружен
+  bool valid() const { return nullptr != key; }
+
+  /// @brief Подпись данных
+  /// @param data Подписываемые данные
+  /// @return Подпись в base64 (пустая строка - ошибка)
+  std::string sign(std::string_view data) const {
+    if (!key) {
+      return std::string{};
+    }
+    unsigned char signature[64];
+    size_t size{sizeof(signature)};
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    bool ok = ctx && (1 == EVP_DigestSignInit(ctx, nullptr, nullptr, nullptr, key)) &&
+              (1 == EVP_DigestSign(ctx, signature, &size, reinterpret_cast<const unsigned char*>(data.data()), data.size()));
+    EVP_MD_CTX_free(ctx);
+    if (!ok) {
+      return std::string{};
+    }
+    std::string result(4 * ((size + 2) / 3), '\0');
+    EVP_EncodeBlock(reinterpret_cast<unsigned char*>(result.data()), signature, static_cast<int>(size));
+    return result;
+  }
+
+  /// @brief Новый закрытый ключ Ed25519 в формате PEM (для локальных заглушек и тестов)
+  static std::string generate_pem() {
+    std::string pem{};
+    EVP_PKEY *new_key{nullptr};
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, nullptr);
+    if (ctx && (1 == EVP_PKEY_keygen_init(ctx)) && (1 == EVP_PKEY_keygen(ctx, &new_key))) {
+      BIO *bio = BIO_new(BIO_s_mem());
+      if (bio && (1 == PEM_write_bio_PrivateKey(bio, new_key, nullptr, nullptr, 0, nullptr, nullptr))) {
+        char *data{nullptr};
+        long size = BIO_get_mem_data(bio, &data);
+        pem.assign(data, size);
+      }
+      BIO_free(bio);
+    }
+    EVP_PKEY_free(new_key);
+    EVP_PKEY_CTX_free(ctx);
+    return pem;
+  }
+
+  ~Ed25519Signer() {
+    EVP_PKEY_free(key);
+  }
+};
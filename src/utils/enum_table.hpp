@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <bit>
+#include <utility>
+#include <type_traits>
+
+/// @brief Значение перечисления и его имя в протоколе
+template<typename E>
+struct EnumName {
+  E value;
+  std::string_view name;
+};
+
+/// @brief Таблица перечисление <-> строка, построенная при компиляции.
+/// enum -> string_view - индекс массива по значению перечисления;
+/// string_view -> enum - совершенный хеш (FNV-1a с подобранным seed): одна ячейка и одно сравнение строк.
+/// Значения перечисления должны быть плотными (0..N), имена - уникальными; иначе таблица не компилируется.
+/// @tparam E Перечисление
+/// @tparam N Количество значений
+template<typename E, size_t N>
+class EnumTable {
+private:
+  using U = std::underlying_type_t<E>;
+  static constexpr size_t slot_count = std::bit_ceil(N * 4);
+  std::array<EnumName<E>, N> entries{};
+  std::array<uint8_t, N + 1> names{}; // Индекс записи + 1 по значению перечисления (0 - нет имени)
+  std::array<uint8_t, slot_count> slots{}; // Индекс записи + 1 по хешу имени (0 - пусто)
+  uint32_t seed{0};
+
+  static constexpr uint32_t hash(std::string_view name, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    for (char c : name) {
+      h ^= static_cast<uint8_t>(c);
+      h *= 16777619u;
+    }
+    return h ^ (h >> 15);
+  }
+
+  constexpr bool place() {
+    slots.fill(0);
+    for (size_t i = 0; i < N; i++) {
+      size_t slot = hash(entries[i].name, seed) & (slot_count - 1);
+      if (0 != slots[slot]) {
+        return false;
+      }
+      slots[slot] = static_cast<uint8_t>(i + 1);
+    }
+    return true;
+  }
+public:
+  constexpr explicit EnumTable(const std::array<EnumName<E>, N> &init) : entries(init) {
+    static_assert(N < 255, "EnumTable supports up to 254 values");
+    for (size_t i = 0; i < N; i++) {
+      U value = static_cast<U>(entries[i].value);
+      if (std::cmp_less(value, 0) || std::cmp_greater(value, N) || (0 != names[value])) {
+        throw "EnumTable: enum values must be dense and unique";
+      }
+      names[value] = static_cast<uint8_t>(i + 1);
+    }
+    for (seed = 0; seed < 65536; seed++) {
+      if (place()) {
+        return;
+      }
+    }
+    throw "EnumTable: no perfect hash (duplicate names)";
+  }
+
+  /// @brief Имя значения
+  /// @param value Значение
+  /// @param fallback Имя для значения вне таблицы
+  constexpr std::string_view to_str(E value, std::string_view fallback) const {
+    U index = static_cast<U>(value);
+    if (std::cmp_less(index, 0) || std::cmp_greater(index, N) || (0 == names[index])) {
+      return fallback;
+    }
+    return entries[names[index] - 1].name;
+  }
+
+  /// @brief Значение по имени
+  /// @param name Имя
+  /// @param fallback Значение для имени вне таблицы
+  constexpr E from_str(std::string_view name, E fallback) const {
+    size_t index = slots[hash(name, seed) & (slot_count - 1)];
+    return ((0 != index) && (entries[index - 1].name == name)) ? entries[index - 1].value : fallback;
+  }
+};
+
+/// @brief Таблица перечисления: make_enum_table<Side>({{Side::BUY, "BUY"}, {Side::SELL, "SELL"}})
+template<typename E, size_t N>
+constexpr EnumTable<E, N> make_enum_table(const EnumName<E> (&entries)[N]) {
+  return EnumTable<E, N>{std::to_array(entries)};
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string_view>
+#include <cstdint>
+
+#include "./decimal.hpp"
+
+/// @brief Быстрое преобразование десятичной строки ("-123.45600000") в целое с масштабом 10^Prec.
+/// Цифры после Prec знаков отбрасываются, экспоненциальная запись не поддерживается.
+/// @tparam Prec Количество знаков после запятой
+/// @param str Строка
+/// @param value Результат
+/// @return True - успех; False - строка не является числом
+template<int Prec = 8>
+static bool str_to_fixed(std::string_view str, int64_t &value) {
+  size_t pos{0};
+  bool negative{false};
+  if ((pos < str.size()) && (('-' == str[pos]) || ('+' == str[pos]))) {
+    negative = ('-' == str[pos]);
+    pos++;
+  }
+  int64_t result{0};
+  int digits{0};
+  int frac_digits{-1};
+  for (; pos < str.size(); pos++) {
+    char c = str[pos];
+    if (('0' <= c) && (c <= '9')) {
+      if (frac_digits < 0) {
+        result = result * 10 + (c - '0');
+      }
+      else if (frac_digits < Prec) {
+        result = result * 10 + (c - '0');
+        frac_digits++;
+      }
+      digits++;
+    }
+    else if (('.' == c) && (frac_digits < 0)) {
+      frac_digits = 0;
+    }
+    else {
+      return false;
+    }
+  }
+  if (0 == digits) {
+    return false;
+  }
+  for (int i = (frac_digits < 0) ? 0 : frac_digits; i < Prec; i++) {
+    result *= 10;
+  }
+  value = negative ? -result : result;
+  return true;
+}
+
+/// @brief Быстрое преобразование десятичной строки в dec::decimal<Prec>
+/// @tparam Prec Количество знаков после запятой
+/// @param str Строка
+/// @return Число (0 - строка не является числом)
+template<int Prec = 8>
+static dec::decimal<Prec> str_to_decimal(std::string_view str) {
+  int64_t value{0};
+  dec::decimal<Prec> result{};
+  if (str_to_fixed<Prec>(str, value)) {
+    result.setUnbiased(value);
+  }
+  return result;
+}
+
+/// @brief Быстрое преобразование целого с масштабом 10^Prec в десятичную строку ("-123.45600000")
+/// @tparam Prec Количество знаков после запятой
+/// @param out Буфер (не меньше 21 + Prec байт)
+/// @param value Число
+/// @return Количество записанных байт
+template<int Prec = 8>
+static size_t fixed_to_chars(char *out, int64_t value) {
+  char *pos = out;
+  uint64_t abs_value = (value < 0) ? (~static_cast<uint64_t>(value) + 1) : static_cast<uint64_t>(value);
+  if (value < 0) {
+    *pos++ = '-';
+  }
+  uint64_t scale{1};
+  for (int i = 0; i < Prec; i++) {
+    scale *= 10;
+  }
+  uint64_t integer = abs_value / scale;
+  uint64_t fraction = abs_value % scale;
+  char digits[20];
+  int n{0};
+  do {
+    digits[n++] = static_cast<char>('0' + integer % 10);
+    integer /= 10;
+  } while (0 != integer);
+  while (0 < n) {
+    *pos++ = digits[--n];
+  }
+  if (0 < Prec) {
+    *pos++ = '.';
+    for (int i = Prec - 1; i >= 0; i--) {
+      pos[i] = static_cast<char>('0' + fraction % 10);
+      fraction /= 10;
+    }
+    pos += Prec;
+  }
+  return static_cast<size_t>(pos - out);
+}
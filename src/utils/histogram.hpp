@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <bit>
+
+/// @brief Гистограмма задержек (нс) с логарифмически-линейными корзинами.
+/// 4 корзины на каждую степень двойки (погрешность перцентилей до 25%),
+/// запись без блокировок из любого количества потоков.
+class LatencyHistogram {
+private:
+  static const size_t sub_buckets{4};
+  static const size_t bucket_count{252};
+  std::array<std::atomic<uint64_t>, bucket_count> counts{};
+  std::atomic<uint64_t> n_count{0};
+  std::atomic<uint64_t> n_total{0};
+  std::atomic<uint64_t> n_max{0};
+
+  static size_t bucket_index(uint64_t value) {
+    if (value < sub_buckets) {
+      return value;
+    }
+    size_t exp = std::bit_width(value) - 1;
+    size_t sub = (value >> (exp - 2)) & (sub_buckets - 1);
+    return sub_buckets * (exp - 1) + sub;
+  }
+
+  static uint64_t bucket_upper(size_t index) {
+    if (index < sub_buckets) {
+      return index;
+    }
+    size_t exp = index / sub_buckets + 1;
+    uint64_t lower = (sub_buckets + index % sub_buckets) << (exp - 2);
+    return lower + (uint64_t{1} << (exp - 2)) - 1;
+  }
+public:
+  /// @brief Добавить измерение
+  /// @param value_ns Задержка в нс
+  void add(uint64_t value_ns) {
+    counts[bucket_index(value_ns)].fetch_add(1, std::memory_order_relaxed);
+    n_count.fetch_add(1, std::memory_order_relaxed);
+    n_total.fetch_add(value_ns, std::memory_order_relaxed);
+    uint64_t prev = n_max.load(std::memory_order_relaxed);
+    while ((prev < value_ns) && !n_max.compare_exchange_weak(prev, value_ns, std::memory_order_relaxed)) {}
+  }
+
+  /// @brief Количество измерений
+  uint64_t count() const {
+    return n_count.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Среднее значение (нс)
+  double mean() const {
+    uint64_t n = count();
+    return (0 == n) ? 0.0 : static_cast<double>(n_total.load(std::memory_order_relaxed)) / n;
+  }
+
+  /// @brief Максимальное значение (нс)
+  uint64_t max() const {
+    return n_max.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Перцентиль (верхняя граница корзины, нс)
+  /// @param p Перцентиль 0.0 - 100.0
+  uint64_t percentile(double p) const {
+    uint64_t n = count();
+    if (0 == n) {
+      return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * n);
+    rank = (rank < 1) ? 1 : ((rank > n) ? n : rank);
+    uint64_t seen{0};
+    for (size_t i = 0; i < bucket_count; i++) {
+      seen += counts[i].load(std::memory_order_relaxed);
+      if (seen >= rank) {
+        uint64_t upper = bucket_upper(i);
+        return (upper < max()) ? upper : max();
+      }
+    }
+    return max();
+  }
+
+  /// @brief Сброс измерений
+  void reset() {
+    for (auto &c : counts) {
+      c.store(0, std::memory_order_relaxed);
+    }
+    n_count.store(0, std::memory_order_relaxed);
+    n_total.store(0, std::memory_order_relaxed);
+    n_max.store(0, std::memory_order_relaxed);
+  }
+};
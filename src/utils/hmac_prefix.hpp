@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <openssl/evp.h>
+
+/// @brief HMAC-SHA256 с сохраненным состоянием после общего начала сообщения.
+/// Ключ и префикс хешируются один раз в конструкторе; sign() копирует состояние
+/// (без выделения памяти) и хеширует только окончание сообщения.
+/// Результат совпадает с hmac_sha256(key, prefix + suffix). Один объект - один поток.
+class HmacSha256Prefix {
+private:
+  EVP_MD_CTX *inner{nullptr}; // H((K ^ ipad) || prefix)
+  EVP_MD_CTX *outer{nullptr}; // H(K ^ opad)
+  EVP_MD_CTX *work{nullptr};
+public:
+  /// @brief Конструктор
+  /// @param key Секретный ключ
+  /// @param prefix Общее начало подписываемых сообщений
+  HmacSha256Prefix(std::string_view key, std::string_view prefix) {
+    const size_t block_size{64};
+    unsigned char block[block_size]{};
+    if (key.size() > block_size) {
+      unsigned int size{0};
+      EVP_Digest(key.data(), key.size(), block, &size, EVP_sha256(), nullptr);
+    }
+    else {
+      std::memcpy(block, key.data(), key.size());
+    }
+    unsigned char ipad[block_size];
+    unsigned char opad[block_size];
+    for (size_t i = 0; i < block_size; i++) {
+      ipad[i] = block[i] ^ 0x36;
+      opad[i] = block[i] ^ 0x5c;
+    }
+    inner = EVP_MD_CTX_new();
+    outer = EVP_MD_CTX_new();
+    work = EVP_MD_CTX_new();
+    EVP_DigestInit_ex(inner, EVP_sha256(), nullptr);
+    EVP_DigestUpdate(inner, ipad, block_size);
+    EVP_DigestUpdate(inner, prefix.data(), prefix.size());
+    EVP_DigestInit_ex(outer, EVP_sha256(), nullptr);
+    EVP_DigestUpdate(outer, opad, block_size);
+  }
+  HmacSha256Prefix(const HmacSha256Prefix&) = delete;
+  HmacSha256Prefix& operator=(const HmacSha256Prefix&) = delete;
+
+  /// @brief Подпись prefix + suffix
+  /// @param suffix Окончание сообщения
+  /// @param out Буфер не меньше 64 байт: подпись в hex (строчные)
+  /// @return Количество записанных байт (64)
+  size_t sign(std::string_view suffix, char *out) {
+    static const char digits[]{"0123456789abcdef"};
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int size{0};
+    EVP_MD_CTX_copy_ex(work, inner);
+    EVP_DigestUpdate(work, suffix.data(), suffix.size());
+    EVP_DigestFinal_ex(work, digest, &size);
+    EVP_MD_CTX_copy_ex(work, outer);
+    EVP_DigestUpdate(work, digest, size);
+    EVP_DigestFinal_ex(work, digest, &size);
+    for (unsigned int i = 0; i < size; i++) {
+      out[2 * i] = digits[digest[i] >> 4];
+      out[2 * i + 1] = digits[digest[i] & 0x0F];
+    }
+    return 2 * size;
+  }
+
+  ~HmacSha256Prefix() {
+    EVP_MD_CTX_free(inner);
+    EVP_MD_CTX_free(outer);
+    EVP_MD_CTX_free(work);
+  }
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/// @brief Выполнить fn(i) для i = 0..count-1 не более чем в max_parallel потоках (включая вызывающий).
+/// Индексы раздаются атомарным счетчиком, поэтому медленный запрос не задерживает остальные.
+/// @param count Количество задач
+/// @param max_parallel Максимум одновременных задач
+/// @param fn Задача (не должна бросать исключений)
+template<typename Fn>
+void parallel_for(size_t count, size_t max_parallel, Fn &&fn) {
+  std::atomic<size_t> next{0};
+  auto worker = [&]() {
+    for (size_t i = next++; i < count; i = next++) {
+      fn(i);
+    }
+  };
+  std::vector<std::thread> threads{};
+  size_t n_threads = std::min(std::max<size_t>(max_parallel, 1), count);
+  for (size_t t = 1; t < n_threads; t++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+/// @brief Пул потоков для parallel_for: потоки создаются при первой нужде и переиспользуются между вызовами,
+/// поэтому пакет запросов не платит за создание потоков. Вызывающий поток тоже выполняет задачи,
+/// а помощники, не успевшие начать до конца пакета, его не задерживают (вложенный вызов не блокируется).
+class WorkerPool {
+private:
+  struct Batch {
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t active{0}; // Помощников, выполняющих задачи пакета
+    bool closed{false}; // Вызывающий поток закончил: новые помощники не начинают
+    std::atomic<size_t> next{0};
+  };
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::deque<std::function<void()>> tasks{};
+  std::vector<std::thread> threads{};
+  bool stopped{false};
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+      cv.wait(lock, [this]() { return stopped || !tasks.empty(); });
+      if (tasks.empty()) {
+        return;
+      }
+      std::function<void()> task = std::move(tasks.front());
+      tasks.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+public:
+  WorkerPool() = default;
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /// @brief Выполнить fn(i) для i = 0..count-1 не более чем в max_parallel потоках (включая вызывающий)
+  /// @param count Количество задач
+  /// @param max_parallel Максимум одновременных задач
+  /// @param fn Задача (не должна бросать исключений)
+  template<typename Fn>
+  void parallel_for(size_t count, size_t max_parallel, Fn &&fn) {
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+    auto work = [&fn, count, &next = batch->next]() {
+      for (size_t i = next++; i < count; i = next++) {
+        fn(i);
+      }
+    };
+    size_t n_helpers = std::min(std::max<size_t>(max_parallel, 1), std::max<size_t>(count, 1)) - 1;
+    if (0 < n_helpers) {
+      std::lock_guard<std::mutex> lock(mtx);
+      while (threads.size() < n_helpers) {
+        threads.emplace_back(&WorkerPool::run, this);
+      }
+      for (size_t t = 0; t < n_helpers; t++) {
+        tasks.push_back([batch, &work]() {
+          {
+            std::lock_guard<std::mutex> batch_lock(batch->mtx);
+            if (batch->closed) {
+              return;
+            }
+            batch->active++;
+          }
+          work();
+          {
+            std::lock_guard<std::mutex> batch_lock(batch->mtx);
+            batch->active--;
+          }
+          batch->cv.notify_all();
+        });
+      }
+    }
+    cv.notify_all();
+    work();
+    std::unique_lock<std::mutex> batch_lock(batch->mtx);
+    batch->closed = true;
+    batch->cv.wait(batch_lock, [&batch]() { return 0 == batch->active; });
+  }
+
+  /// @brief Созданных потоков
+  size_t size() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return threads.size();
+  }
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      stopped = true;
+    }
+    cv.notify_all();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <immintrin.h>
+
+/// @brief Результат ожидания ответа
+enum class PendingResult {
+  DONE = 0, // Ответ получен
+  FAILED = 1, // Соединение закрыто или запрос не отправлен
+  TIMEOUT = 2
+};
+
+/// @brief Таблица ожидающих ответа запросов без блокировок.
+/// Запрос с id занимает ячейку id & (capacity - 1): вызывающий поток захватывает ее CAS (claim),
+/// поток чтения записывает ответ и переводит ячейку в DONE (complete), вызывающий поток
+/// активно ждет spin итераций, затем засыпает на атомике ячейки (wait). Таймауты и закрытие
+/// соединения завершают ячейки из потока чтения (expire, fail_all).
+/// id должны быть уникальны и возрастать (например, счетчик запросов или MsgSeqNum).
+class PendingTable {
+private:
+  enum SlotState : uint32_t {
+    FREE = 0,
+    CLAIMED = 1, // Захвачена вызывающим потоком, запрос еще не отправлен
+    PENDING = 2, // Ожидает ответа
+    DONE = 3,
+    FAILED = 4,
+    TIMEOUT = 5
+  };
+
+  struct Slot {
+    std::atomic<uint32_t> state{FREE};
+    std::atomic<uint64_t> id{0};
+    std::atomic<int64_t> deadline{0}; // steady_clock, тики
+    std::string response{}; // Пишет поток чтения до DONE, читает вызывающий поток после DONE
+  };
+
+  std::unique_ptr<Slot[]> slots{};
+  uint64_t mask{0};
+public:
+  /// @brief Конструктор таблицы
+  /// @param capacity Одновременных запросов (округляется вверх до степени двойки)
+  explicit PendingTable(size_t capacity) {
+    size_t size{1};
+    while (size < std::max<size_t>(capacity, 1)) {
+      size <<= 1;
+    }
+    slots = std::make_unique<Slot[]>(size);
+    mask = size - 1;
+  }
+
+  /// @brief Занять ячейку для запроса (до отправки запроса)
+  /// @param id Id запроса
+  /// @param timeout Ожидание ответа
+  /// @return False - ячейка занята более ранним запросом
+  bool claim(uint64_t id, std::chrono::milliseconds timeout) {
+    Slot &slot = slots[id & mask];
+    uint32_t state{FREE};
+    if (!slot.state.compare_exchange_strong(state, CLAIMED)) {
+      return false;
+    }
+    slot.id.store(id, std::memory_order_relaxed);
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    slot.deadline.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+    slot.state.store(PENDING);
+    return true;
+  }
+
+  /// @brief Ответ на запрос (поток чтения)
+  /// @param id Id запроса
+  /// @param response Ответ (копируется)
+  /// @return False - запрос не ожидает ответа (таймаут или чужой id)
+  bool complete(uint64_t id, std::string_view response) {
+    Slot &slot = slots[id & mask];
+    if ((PENDING != slot.state.load(std::memory_order_acquire)) || (id != slot.id.load(std::memory_order_relaxed))) {
+      return false;
+    }
+    slot.response.assign(response);
+    uint32_t state{PENDING};
+    if (!slot.state.compare_exchange_strong(state, DONE, std::memory_order_acq_rel)) {
+      return false;
+    }
+    slot.state.notify_one();
+    return true;
+  }
+
+  /// @brief Завершить запрос ошибкой (например, запрос не отправлен)
+  void fail(uint64_t id) {
+    Slot &slot = slots[id & mask];
+    uint32_t state{PENDING};
+    if ((id == slot.id.load(std::memory_order_relaxed)) && slot.state.compare_exchange_strong(state, FAILED)) {
+      slot.state.notify_one();
+    }
+  }
+
+  /// @brief Ожидание ответа; ячейка освобождается
+  /// @param id Id запроса (после успешного claim)
+  /// @param response Ответ (при DONE)
+  /// @param spin Итераций активного ожидания до засыпания
+  /// @return Результат
+  PendingResult wait(uint64_t id, std::string &response, int spin) {
+    Slot &slot = slots[id & mask];
+    uint32_t state = slot.state.load(std::memory_order_acquire);
+    for (int i = 0; (PENDING == state) && (i < spin); i++) {
+      _mm_pause();
+      state = slot.state.load(std::memory_order_acquire);
+    }
+    while (PENDING == state) {
+      slot.state.wait(PENDING, std::memory_order_acquire);
+      state = slot.state.load(std::memory_order_acquire);
+    }
+    if (DONE == state) {
+      response.swap(slot.response);
+    }
+    slot.state.store(FREE, std::memory_order_release);
+    return (DONE == state) ? PendingResult::DONE : ((TIMEOUT == state) ? PendingResult::TIMEOUT : PendingResult::FAILED);
+  }
+
+  /// @brief Завершить просроченные запросы (поток чтения)
+  /// @return Количество просроченных запросов
+  size_t expire(std::chrono::steady_clock::time_point now) {
+    size_t count{0};
+    int64_t now_count = now.time_since_epoch().count();
+    for (uint64_t i = 0; i <= mask; i++) {
+      Slot &slot = slots[i];
+      if ((PENDING != slot.state.load(std::memory_order_acquire)) || (now_count < slot.deadline.load(std::memory_order_relaxed))) {
+        continue;
+      }
+      uint32_t state{PENDING};
+      if (slot.state.compare_exchange_strong(state, TIMEOUT)) {
+        count++;
+        slot.state.notify_one();
+      }
+    }
+    return count;
+  }
+
+  /// @brief Завершить все ожидающие запросы ошибкой (соединение закрыто)
+  void fail_all() {
+    for (uint64_t i = 0; i <= mask; i++) {
+      uint32_t state{PENDING};
+      if (slots[i].state.compare_exchange_strong(state, FAILED)) {
+        slots[i].state.notify_one();
+      }
+    }
+  }
+};
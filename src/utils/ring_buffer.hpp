@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/// @brief Кольцевой буфер с зеркальным отображением памяти.
+/// Одна и та же область памяти отображена дважды подряд, поэтому любые
+/// непрочитанные данные (и свободное место) всегда доступны как непрерывный
+/// участок памяти - сообщения разбираются на месте без копирования на границе кольца.
+class RingBuffer {
+private:
+  char *data{nullptr};
+  size_t cap{0};
+  uint64_t head{0}; // Позиция чтения
+  uint64_t tail{0}; // Позиция записи
+
+  static size_t round_capacity(size_t capacity) {
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t result{page};
+    while (result < capacity) {
+      result <<= 1;
+    }
+    return result;
+  }
+public:
+  /// @brief Конструктор буфера
+  /// @param capacity Размер (округляется вверх до степени двойки, не меньше страницы)
+  explicit RingBuffer(size_t capacity) {
+    size_t size = round_capacity(capacity);
+    int fd = memfd_create("ring_buffer", MFD_CLOEXEC);
+    if (fd < 0) {
+      return;
+    }
+    if (0 != ftruncate(fd, size)) {
+      close(fd);
+      return;
+    }
+    void *addr = mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == addr) {
+      close(fd);
+      return;
+    }
+    char *base = static_cast<char*>(addr);
+    if ((MAP_FAILED == mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0)) ||
+        (MAP_FAILED == mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0))) {
+      munmap(addr, 2 * size);
+      close(fd);
+      return;
+    }
+    close(fd);
+    data = base;
+    cap = size;
+  }
+
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  /// @brief Буфер успешно создан
+  bool valid() const { return nullptr != data; }
+  /// @brief Размер буфера
+  size_t capacity() const { return cap; }
+  /// @brief Указатель на непрочитанные данные (непрерывно readable() байт)
+  char *read_ptr() { return data + (head & (cap - 1)); }
+  /// @brief Количество непрочитанных байт
+  size_t readable() const { return tail - head; }
+  /// @brief Освободить n прочитанных байт
+  void consume(size_t n) {
+    head += n;
+    if (head == tail) {
+      head = tail = 0;
+    }
+  }
+  /// @brief Указатель на свободное место (непрерывно writable() байт)
+  char *write_ptr() { return data + (tail & (cap - 1)); }
+  /// @brief Количество свободных байт
+  size_t writable() const { return cap - (tail - head); }
+  /// @brief Зафиксировать n записанных байт
+  void commit(size_t n) { tail += n; }
+  /// @brief Очистить буфер
+  void clear() { head = tail = 0; }
+
+  ~RingBuffer() {
+    if (nullptr != data) {
+      munmap(data, 2 * cap);
+    }
+  }
+};
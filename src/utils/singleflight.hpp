@@ -0,0 +1,91 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <future>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+/// @brief Статистика объединения одинаковых запросов
+struct SingleFlightStats {
+  uint64_t calls{0}; // Всего вызовов
+  uint64_t executed{0}; // Реально выполненных запросов
+  uint64_t coalesced{0}; // Вызовов, получивших результат чужого запроса
+};
+
+/// @brief Объединение одинаковых одновременных запросов (singleflight).
+/// Первый вызов с ключом выполняет запрос, остальные вызовы с тем же ключом
+/// ждут его завершения и получают тот же результат (или то же исключение).
+/// @tparam T Тип результата
+template<typename T>
+class SingleFlight {
+private:
+  struct Call {
+    std::shared_future<T> result;
+    size_t waiters{0}; // Количество ожидающих результат (без ведущего)
+  };
+  std::mutex mtx;
+  std::map<std::string, std::shared_ptr<Call>> calls;
+  std::atomic<uint64_t> n_calls{0};
+  std::atomic<uint64_t> n_executed{0};
+  std::atomic<uint64_t> n_coalesced{0};
+public:
+  /// @brief Выполнить запрос или присоединиться к уже выполняющемуся
+  /// @param key Ключ запроса (метод + путь + параметры)
+  /// @param func Функция, выполняющая запрос
+  /// @return Результат запроса
+  /// @exception Исключение, выброшенное func
+  template<typename F>
+  T run(const std::string &key, F &&func) {
+    n_calls++;
+    std::shared_ptr<Call> call;
+    std::promise<T> promise;
+    bool leader{false};
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      auto it = calls.find(key);
+      if (it != calls.end()) {
+        call = it->second;
+        call->waiters++;
+      }
+      else {
+        call = std::make_shared<Call>();
+        call->result = promise.get_future().share();
+        calls[key] = call;
+        leader = true;
+      }
+    }
+    if (!leader) {
+      n_coalesced++;
+      return call->result.get();
+    }
+    n_executed++;
+    try {
+      promise.set_value(func());
+    }
+    catch (...) {
+      promise.set_exception(std::current_exception());
+    }
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      calls.erase(key);
+    }
+    return call->result.get();
+  }
+
+  /// @brief Количество ожидающих результат запроса с ключом
+  /// @param key Ключ запроса
+  /// @return Количество ожидающих (0 - запрос не выполняется)
+  size_t waiters(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = calls.find(key);
+    return (it != calls.end()) ? it->second->waiters : 0;
+  }
+
+  /// @brief Статистика вызовов
+  SingleFlightStats stats() const {
+    return SingleFlightStats{n_calls.load(), n_executed.load(), n_coalesced.load()};
+  }
+};
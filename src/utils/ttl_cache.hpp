@@ -0,0 +1,294 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <expected>
+#include <type_traits>
+#include <unordered_map>
+
+#include "./histogram.hpp"
+
+/// @brief Политика свежести кеша.
+/// Ключей в кеше не больше max_entries: при добавлении ключа таблица перестраивается без значений
+/// старше ttl + stale, а при достижении лимита - и без самых старых значений (до 3/4 лимита)
+struct CachePolicy {
+  std::chrono::milliseconds ttl{0}; // Время жизни значения (0 - кеш выключен)
+  std::chrono::milliseconds stale{0}; // Время после ttl, когда отдается устаревшее значение с фоновым обновлением
+  size_t max_entries{1024}; // Максимальное количество ключей (0 - без ограничения)
+};
+
+/// @brief Статистика кеша
+struct CacheStats {
+  uint64_t hits{0}; // Попадания (свежее значение)
+  uint64_t stale_hits{0}; // Попадания (устаревшее значение, запущено фоновое обновление)
+  uint64_t misses{0}; // Промахи (синхронный запрос)
+  uint64_t refreshes{0}; // Фоновые обновления
+  uint64_t refresh_errors{0}; // Ошибки фоновых обновлений
+  uint64_t evicted{0}; // Ключи, удаленные из таблицы (истекшие и вытесненные лимитом)
+  uint64_t hit_p50_ns{0}; // Задержка попадания (p50)
+  uint64_t hit_p99_ns{0}; // Задержка попадания (p99)
+  uint64_t miss_p50_ns{0}; // Задержка промаха (p50)
+  uint64_t miss_p99_ns{0}; // Задержка промаха (p99)
+
+  double hit_rate() const {
+    uint64_t total = hits + stale_hits + misses;
+    return (0 == total) ? 0.0 : static_cast<double>(hits + stale_hits) / total;
+  }
+};
+
+template<typename T>
+struct is_expected : std::false_type {};
+
+template<typename T, typename E>
+struct is_expected<std::expected<T, E>> : std::true_type {};
+
+/// @brief Кеш декодированных ответов с временем жизни (TTL) и фоновым обновлением
+/// устаревших значений (stale-while-revalidate).
+/// Чтение закешированного значения выполняется без мьютекса: таблица ключей и значения
+/// хранятся в std::atomic<std::shared_ptr> и заменяются целиком (copy-on-write).
+/// Если T - std::expected, ошибка возвращается вызывающему, но не кешируется (как исключение loader).
+/// @tparam T Тип значения
+template<typename T>
+class TtlCache {
+public:
+  using Loader = std::function<T()>;
+private:
+  using time_point = std::chrono::steady_clock::time_point;
+  struct Entry {
+    T value;
+    time_point stored;
+  };
+  struct Slot {
+    std::atomic<std::shared_ptr<const Entry>> entry{};
+    std::atomic<bool> refreshing{false};
+  };
+  using SlotMap = std::unordered_map<std::string, std::shared_ptr<Slot>>;
+
+  std::atomic<std::shared_ptr<const SlotMap>> slots{std::make_shared<const SlotMap>()};
+  std::atomic<int64_t> ttl_ms{0};
+  std::atomic<int64_t> stale_ms{0};
+  std::atomic<size_t> max_entries{CachePolicy{}.max_entries};
+  std::mutex slots_mtx;
+
+  std::atomic<uint64_t> n_hits{0};
+  std::atomic<uint64_t> n_stale_hits{0};
+  std::atomic<uint64_t> n_misses{0};
+  std::atomic<uint64_t> n_refreshes{0};
+  std::atomic<uint64_t> n_refresh_errors{0};
+  std::atomic<uint64_t> n_evicted{0};
+  LatencyHistogram hit_latency{};
+  LatencyHistogram miss_latency{};
+
+  std::mutex refresh_mtx;
+  std::condition_variable refresh_cv;
+  std::deque<std::function<void()>> refresh_queue;
+  bool stopped{false};
+  std::thread refresher;
+
+  std::shared_ptr<Slot> slot(const std::string &key) {
+    std::shared_ptr<const SlotMap> current = slots.load();
+    auto it = current->find(key);
+    if (it != current->end()) {
+      return it->second;
+    }
+    std::lock_guard<std::mutex> lock(slots_mtx);
+    current = slots.load();
+    it = current->find(key);
+    if (it != current->end()) {
+      return it->second;
+    }
+    auto updated = rebuild(*current);
+    auto result = std::make_shared<Slot>();
+    (*updated)[key] = result;
+    slots.store(updated);
+    return result;
+  }
+
+  /// @brief Копия таблицы без ключей старше ttl + stale; при max_entries и больше
+  /// удаляются самые старые значения (до 3/4 лимита, чтобы не перестраивать таблицу на каждом ключе)
+  std::shared_ptr<SlotMap> rebuild(const SlotMap &current) {
+    auto updated = std::make_shared<SlotMap>();
+    updated->reserve(current.size() + 1);
+    auto keep = std::chrono::milliseconds(ttl_ms.load() + stale_ms.load());
+    time_point now = std::chrono::steady_clock::now();
+    for (auto &[key, s] : current) {
+      std::shared_ptr<const Entry> entry = s->entry.load();
+      // Пустой слот без внешних владельцев - промах, загрузка которого завершилась ошибкой
+      bool expired = entry ? (now - entry->stored >= keep) : (1 == s.use_count());
+      if (!expired) {
+        updated->emplace(key, s);
+      }
+    }
+    size_t limit = max_entries.load();
+    if ((0 < limit) && (updated->size() >= limit)) {
+      std::vector<std::pair<time_point, typename SlotMap::iterator>> ages{};
+      ages.reserve(updated->size());
+      for (auto it = updated->begin(); it != updated->end(); ++it) {
+        std::shared_ptr<const Entry> entry = it->second->entry.load();
+        ages.emplace_back(entry ? entry->stored : time_point::min(), it);
+      }
+      size_t drop = updated->size() - (limit * 3 / 4);
+      std::nth_element(ages.begin(), ages.begin() + drop, ages.end(), [](const auto &a, const auto &b) {
+        return a.first < b.first;
+      });
+      for (size_t i = 0; i < drop; i++) {
+        updated->erase(ages[i].second);
+      }
+    }
+    n_evicted += current.size() - updated->size();
+    return updated;
+  }
+
+  static bool failed(const T &value) {
+    if constexpr (is_expected<T>::value) {
+      return !value.has_value();
+    }
+    else {
+      return false;
+    }
+  }
+
+  void store(Slot &slot, T value) {
+    slot.entry.store(std::make_shared<const Entry>(Entry{std::move(value), std::chrono::steady_clock::now()}));
+  }
+
+  void schedule_refresh(std::shared_ptr<Slot> slot, Loader loader) {
+    std::lock_guard<std::mutex> lock(refresh_mtx);
+    if (stopped) {
+      slot->refreshing = false;
+      return;
+    }
+    if (!refresher.joinable()) {
+      refresher = std::thread(&TtlCache::refresh_run, this);
+    }
+    refresh_queue.push_back([this, slot, loader]() {
+      try {
+        T value = loader();
+        if (failed(value)) {
+          n_refresh_errors++;
+        }
+        else {
+          store(*slot, std::move(value));
+          n_refreshes++;
+        }
+      }
+      catch (...) {
+        n_refresh_errors++;
+      }
+      slot->refreshing = false;
+    });
+    refresh_cv.notify_one();
+  }
+
+  void refresh_run() {
+    std::unique_lock<std::mutex> lock(refresh_mtx);
+    while (true) {
+      refresh_cv.wait(lock, [this]() { return stopped || !refresh_queue.empty(); });
+      if (refresh_queue.empty()) {
+        return;
+      }
+      std::function<void()> task = std::move(refresh_queue.front());
+      refresh_queue.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+public:
+  /// @brief Установить политику свежести
+  void policy(CachePolicy policy) {
+    ttl_ms = policy.ttl.count();
+    stale_ms = policy.stale.count();
+    max_entries = policy.max_entries;
+  }
+
+  /// @brief Текущая политика свежести
+  CachePolicy policy() const {
+    return CachePolicy{std::chrono::milliseconds(ttl_ms.load()), std::chrono::milliseconds(stale_ms.load()), max_entries.load()};
+  }
+
+  /// @brief Получить значение из кеша или загрузить его
+  /// @param key Ключ (эндпоинт + параметры)
+  /// @param loader Функция загрузки (копируется для фонового обновления)
+  /// @return Значение
+  /// @exception Исключение, выброшенное loader при промахе (ошибка std::expected возвращается без исключения)
+  T get(const std::string &key, const Loader &loader) {
+    int64_t ttl = ttl_ms.load(std::memory_order_relaxed);
+    if (0 >= ttl) {
+      return loader();
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<Slot> s = slot(key);
+    std::shared_ptr<const Entry> entry = s->entry.load();
+    if (entry) {
+      int64_t age = std::chrono::duration_cast<std::chrono::milliseconds>(start - entry->stored).count();
+      if (age < ttl) {
+        n_hits++;
+        hit_latency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        return entry->value;
+      }
+      if (age < ttl + stale_ms.load(std::memory_order_relaxed)) {
+        if (!s->refreshing.exchange(true)) {
+          schedule_refresh(s, loader);
+        }
+        n_stale_hits++;
+        hit_latency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        return entry->value;
+      }
+    }
+    T value = loader();
+    if (!failed(value)) {
+      store(*s, value);
+    }
+    n_misses++;
+    miss_latency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    return value;
+  }
+
+  /// @brief Удалить все значения
+  void clear() {
+    std::lock_guard<std::mutex> lock(slots_mtx);
+    slots.store(std::make_shared<const SlotMap>());
+  }
+
+  /// @brief Количество ключей в таблице
+  size_t size() const {
+    return slots.load()->size();
+  }
+
+  /// @brief Статистика кеша
+  CacheStats stats() const {
+    CacheStats result{};
+    result.hits = n_hits.load();
+    result.stale_hits = n_stale_hits.load();
+    result.misses = n_misses.load();
+    result.refreshes = n_refreshes.load();
+    result.refresh_errors = n_refresh_errors.load();
+    result.evicted = n_evicted.load();
+    result.hit_p50_ns = hit_latency.percentile(50.0);
+    result.hit_p99_ns = hit_latency.percentile(99.0);
+    result.miss_p50_ns = miss_latency.percentile(50.0);
+    result.miss_p99_ns = miss_latency.percentile(99.0);
+    return result;
+  }
+
+  ~TtlCache() {
+    {
+      std::lock_guard<std::mutex> lock(refresh_mtx);
+      stopped = true;
+    }
+    refresh_cv.notify_all();
+    if (refresher.joinable()) {
+      refresher.join();
+    }
+  }
+};
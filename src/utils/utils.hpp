@@ -9,6 +9,7 @@
 #include <unistd.h>
 #include <sstream>
 #include <cstring>
+#include <cctype>
 #include <vector>
 #include <iostream>
 
@@ -28,11 +29,11 @@ static uint64_t current_ms_epoch() {
 
 static std::string since_epoch_dttm(uint64_t dttm, std::string format) {
   int epoch_time = dttm / 1000;
-  struct tm * timeinfo;
+  struct tm timeinfo{};
   time_t epoch_time_as_time_t = epoch_time;
-  timeinfo = localtime(&epoch_time_as_time_t);
+  localtime_r(&epoch_time_as_time_t, &timeinfo);
   std::ostringstream oss;
-  oss << std::put_time(timeinfo, "%d.%m.%Y %H:%M:%S");
+  oss << std::put_time(&timeinfo, "%d.%m.%Y %H:%M:%S");
   auto str = oss.str();
   return str;
 }
@@ -49,9 +50,27 @@ static std::string b2a_hex( char *byte_arr, int n ) {
     return HexString;
 }
 
+static std::string url_encode(const std::string &str) {
+    const static std::string HexCodes = "0123456789ABCDEF";
+    std::string result;
+    for (unsigned char c : str) {
+        if (std::isalnum(c) || ('-' == c) || ('_' == c) || ('.' == c) || ('~' == c)) {
+            result += c;
+        }
+        else {
+            result += '%';
+            result += HexCodes[( c >> 4 ) & 0x0F];
+            result += HexCodes[c & 0x0F];
+        }
+    }
+    return result;
+}
+
 static std::string hmac_sha256( const char *key, const char *data) {
-    unsigned char* digest;
-    digest = HMAC(EVP_sha256(), key, std::strlen(key), (unsigned char*)data, std::strlen(data), NULL, NULL);
+    // Подпись в буфере вызова: при md == NULL OpenSSL пишет в общий статический буфер (гонка между потоками)
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digest_len{0};
+    HMAC(EVP_sha256(), key, std::strlen(key), (unsigned char*)data, std::strlen(data), digest, &digest_len);
     return b2a_hex( (char *)digest, 32 );
 }
 
@@ -0,0 +1,2158 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <format>
+#include <random>
+#include <deque>
+#include <limits>
+#include "../src/binance/binance_type.hpp"
+#include "../src/utils/utils.hpp"
+#include "../src/binance/binance.hpp"
+#include "../src/binance/binance_impl.hpp"
+#include "../src/binance/order_template.hpp"
+#include "../src/binance/order_builder.hpp"
+#include "../src/binance/order_warmup.hpp"
+#include "../src/binance/price_batcher.hpp"
+#include "../src/binance/exchange_info.hpp"
+#include "../src/utils/ttl_cache.hpp"
+#include "../src/utils/histogram.hpp"
+#include "../src/stream/market_stream.hpp"
+#include "../src/stream/stream_manager.hpp"
+#include "../src/stream/order_book.hpp"
+#include "../src/stream/order_session.hpp"
+#include "../src/stream/user_stream.hpp"
+#include "../src/fix/fix_session.hpp"
+#include "./ws_server.hpp"
+#include "./fix_server.hpp"
+#include "./rest_server.hpp"
+
+using namespace std;
+using bench_clock = chrono::steady_clock;
+
+/// @brief Имитация задержки сети (RTT) для запросов без подключения к Binance
+const chrono::microseconds fake_rtt{1000};
+
+vector<string> bench_symbols(size_t count) {
+  vector<string> symbols{};
+  for (size_t i = 0; i < count; i++) {
+    symbols.push_back(std::format("SYM{}USDT", i));
+  }
+  return symbols;
+}
+
+void print_bench_header(const string &name) {
+  cout << "============================================" << endl;
+  cout << name << endl;
+  cout << "============================================" << endl;
+}
+
+void print_bench_row(const string &name, const string &value) {
+  cout << left << setw(35) << name << left << setw(25) << value << endl;
+}
+
+void bench_price_batcher() {
+  print_bench_header("PriceBatcher (RTT 1 ms, 16 threads x 200 calls, 50 symbols)");
+  const size_t n_threads{16};
+  const size_t n_calls{200};
+  vector<string> symbols{bench_symbols(50)};
+  auto fake_fetch = [](span<const string_view> req_symbols) {
+    this_thread::sleep_for(fake_rtt);
+    PriceTable prices{};
+    for (auto &symbol : req_symbols) {
+      prices.add(symbol, dec::decimal<8>("1.00000000"));
+    }
+    prices.build_index();
+    return prices;
+  };
+  auto run = [&](auto &&price) {
+    vector<thread> threads{};
+    auto start = bench_clock::now();
+    for (size_t t = 0; t < n_threads; t++) {
+      threads.emplace_back([&, t]() {
+        for (size_t i = 0; i < n_calls; i++) {
+          price(symbols[(t * 7 + i) % symbols.size()]);
+        }
+      });
+    }
+    for (auto &th : threads) {
+      th.join();
+    }
+    return chrono::duration<double>(bench_clock::now() - start).count();
+  };
+  double direct_sec = run([&](const string &symbol) {
+    string_view sym{symbol};
+    return fake_fetch(span<const string_view>{&sym, 1})[symbol];
+  });
+  uint64_t total_calls = n_threads * n_calls;
+  print_bench_row("Direct calls/sec", std::format("{:.0f}", total_calls / direct_sec));
+  print_bench_row("Direct weight", std::format("{}", total_calls * price_weight_single));
+  for (auto window : {chrono::microseconds{200}, chrono::microseconds{1000}}) {
+    PriceBatcher batcher{fake_fetch, PriceBatcherConfig{window, 100}};
+    double batch_sec = run([&](const string &symbol) { return batcher.symbol_price(symbol); });
+    PriceBatcherStats st{batcher.stats()};
+    string prefix = std::format("Batched({}us) ", window.count());
+    print_bench_row(prefix + "calls/sec", std::format("{:.0f}", st.calls / batch_sec));
+    print_bench_row(prefix + "requests", std::format("{}", st.requests));
+    print_bench_row(prefix + "weight", std::format("{}", st.weight));
+    print_bench_row(prefix + "weight saved", std::format("{}", st.weight_saved));
+  }
+  // Одна неверная пара в пакете: Binance отклоняет весь symbols=[...] с -1121
+  auto strict_fetch = [&](span<const string_view> req_symbols) {
+    for (auto &symbol : req_symbols) {
+      if ("BADSYMBOL" == symbol) {
+        throw BinanceException{ExceptionType::Binance, -1121, std::string{"Invalid symbol."}};
+      }
+    }
+    return fake_fetch(req_symbols);
+  };
+  PriceBatcher batcher{strict_fetch, PriceBatcherConfig{chrono::microseconds{1000}, 100}};
+  vector<string> mixed{symbols.begin(), symbols.begin() + 20};
+  mixed.push_back("BADSYMBOL");
+  atomic<uint64_t> n_priced{0};
+  atomic<uint64_t> n_rejected{0};
+  vector<thread> threads{};
+  for (auto &symbol : mixed) {
+    threads.emplace_back([&, symbol]() {
+      try {
+        if (dec::decimal<8>("1.00000000") == batcher.symbol_price(symbol)) {
+          n_priced++;
+        }
+      }
+      catch (BinanceException &e) {
+        if ((-1121 == e.e_code) && ("BADSYMBOL" == symbol)) {
+          n_rejected++;
+        }
+      }
+    });
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+  print_bench_row("Invalid symbol: priced / rejected", std::format("{} / {}", n_priced.load(), n_rejected.load()));
+  print_bench_row("Invalid symbol: requests", std::format("{}", batcher.stats().requests));
+  print_bench_row("Check", ((mixed.size() - 1 == n_priced) && (1 == n_rejected)) ? "OK" : "MISMATCH");
+}
+
+string price_payload(const vector<string> &symbols) {
+  string body{"["};
+  for (size_t i = 0; i < symbols.size(); i++) {
+    body += std::format("{}{{\"symbol\":\"{}\",\"price\":\"{}.{:08}\"}}", (0 == i) ? "" : ",", symbols[i], i % 70000, (i * 7919) % 100000000);
+  }
+  body += "]";
+  return body;
+}
+
+void bench_price_table_decode() {
+  print_bench_header("PriceTable decode (2000 symbols, /api/v3/ticker/price)");
+  const size_t n_iter{200};
+  vector<string> symbols{bench_symbols(2000)};
+  string body{price_payload(symbols)};
+  auto start = bench_clock::now();
+  size_t check{0};
+  for (size_t i = 0; i < n_iter; i++) {
+    json js = json::parse(body);
+    map<string, dec::decimal<8>> prices{};
+    for (auto &js_price : js) {
+      prices[js_price.value("symbol", string{})] = dec::decimal<8>(js_price.value("price", string{}));
+    }
+    check += prices.size();
+  }
+  double dom_us = chrono::duration<double, micro>(bench_clock::now() - start).count() / n_iter;
+  start = bench_clock::now();
+  for (size_t i = 0; i < n_iter; i++) {
+    PriceTable table{};
+    decode_price_table(body, table);
+    check += table.size();
+  }
+  double sax_us = chrono::duration<double, micro>(bench_clock::now() - start).count() / n_iter;
+  PriceTable table{};
+  decode_price_table(body, table);
+  start = bench_clock::now();
+  dec::decimal<8> sum{};
+  for (size_t i = 0; i < n_iter; i++) {
+    for (auto &symbol : symbols) {
+      sum += table[symbol];
+    }
+  }
+  double lookup_ns = chrono::duration<double, nano>(bench_clock::now() - start).count() / (n_iter * symbols.size());
+  print_bench_row("Payload size (bytes)", std::format("{}", body.size()));
+  print_bench_row("json DOM + std::map (us)", std::format("{:.1f}", dom_us));
+  print_bench_row("SAX -> PriceTable (us)", std::format("{:.1f}", sax_us));
+  print_bench_row("PriceTable lookup (ns)", std::format("{:.1f}", lookup_ns));
+  print_bench_row("Check", std::format("{} {}", check, val_to_str(sum).size()));
+}
+
+void bench_ttl_cache() {
+  print_bench_header("TtlCache (RTT 1 ms, ttl 5 ms, stale 50 ms, 8 threads x 300 ms)");
+  TtlCache<dec::decimal<8>> cache{};
+  cache.policy(CachePolicy{chrono::milliseconds(5), chrono::milliseconds(50)});
+  auto loader = []() {
+    this_thread::sleep_for(fake_rtt);
+    return dec::decimal<8>("1.00000000");
+  };
+  vector<thread> threads{};
+  atomic<uint64_t> calls{0};
+  auto stop_at = bench_clock::now() + chrono::milliseconds(300);
+  for (size_t t = 0; t < 8; t++) {
+    threads.emplace_back([&]() {
+      while (bench_clock::now() < stop_at) {
+        cache.get("/api/v3/ticker/price?symbol=BTCUSDT", loader);
+        calls++;
+      }
+    });
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+  CacheStats st{cache.stats()};
+  print_bench_row("Calls", std::format("{}", calls.load()));
+  print_bench_row("Hits / stale hits / misses", std::format("{} / {} / {}", st.hits, st.stale_hits, st.misses));
+  print_bench_row("Background refreshes", std::format("{}", st.refreshes));
+  print_bench_row("Hit rate", std::format("{:.4f}", st.hit_rate()));
+  print_bench_row("Hit latency p50/p99 (ns)", std::format("{} / {}", st.hit_p50_ns, st.hit_p99_ns));
+  print_bench_row("Miss latency p50/p99 (ns)", std::format("{} / {}", st.miss_p50_ns, st.miss_p99_ns));
+  // Ключ на каждую комбинацию пар: таблица ограничена max_entries
+  TtlCache<dec::decimal<8>> bounded{};
+  bounded.policy(CachePolicy{chrono::milliseconds(60000), chrono::milliseconds(0), 256});
+  size_t max_size{0};
+  for (size_t i = 0; i < 10000; i++) {
+    bounded.get(std::format("/api/v3/ticker/price?symbols={}", i), []() { return dec::decimal<8>("1.00000000"); });
+    max_size = std::max(max_size, bounded.size());
+  }
+  print_bench_row("Bounded keys max / evicted", std::format("{} / {}", max_size, bounded.stats().evicted));
+  print_bench_row("Check", ((256 >= max_size) && (10000 == bounded.size() + bounded.stats().evicted)) ? "OK" : "MISMATCH");
+}
+
+void bench_exchange_info() {
+  print_bench_header("ExchangeInfo round + validate (2000 symbols)");
+  vector<string> symbols{bench_symbols(2000)};
+  ExchangeInfo info{};
+  const int64_t ticks[] = {1, 100, 10000, 1000000};
+  for (size_t i = 0; i < symbols.size(); i++) {
+    SymbolFilters f{};
+    f.symbol = symbols[i];
+    f.tick_size = ticks[i % 4];
+    f.min_price = f.tick_size;
+    f.max_price = 100000000000000;
+    f.step_size = ticks[(i + 1) % 4];
+    f.min_qty = f.step_size;
+    f.max_qty = 900000000000000000;
+    f.min_notional = 500000000;
+    f.bid_mult_up = f.ask_mult_up = 500000000;
+    f.bid_mult_down = f.ask_mult_down = 20000000;
+    info.add(f);
+  }
+  vector<Order> orders{};
+  for (size_t i = 0; i < symbols.size(); i++) {
+    Order order{};
+    order.symbol = symbols[i];
+    order.side = (0 == i % 2) ? Side::BUY : Side::SELL;
+    order.price.setUnbiased(100000000 + static_cast<int64_t>(i * 7919));
+    order.origQty.setUnbiased(1000000000 + static_cast<int64_t>(i * 104729));
+    orders.push_back(order);
+  }
+  const size_t n_iter{500};
+  size_t ok{0};
+  dec::decimal<8> avg_price{"1.00000000"};
+  auto start = bench_clock::now();
+  for (size_t it = 0; it < n_iter; it++) {
+    for (auto &order : orders) {
+      Order copy{order};
+      ok += (FilterResult::OK == info.round(copy, avg_price)) ? 1 : 0;
+    }
+  }
+  double round_ns = chrono::duration<double, nano>(bench_clock::now() - start).count() / (n_iter * orders.size());
+  print_bench_row("Round + validate (ns/order)", std::format("{:.1f}", round_ns));
+  print_bench_row("Orders passed", std::format("{} / {}", ok, n_iter * orders.size()));
+}
+
+uint64_t now_ns() {
+  return chrono::duration_cast<chrono::nanoseconds>(bench_clock::now().time_since_epoch()).count();
+}
+
+string trade_message(uint64_t id) {
+  return std::format("{{\"stream\":\"btcusdt@trade\",\"data\":{{\"e\":\"trade\",\"E\":1700000000000,\"s\":\"BTCUSDT\","
+                     "\"t\":{},\"p\":\"65000.12000000\",\"q\":\"0.00150000\",\"T\":1700000000000,\"m\":true,\"M\":true}}}}", id);
+}
+
+string stream_message(uint64_t id) {
+  switch (id % 4) {
+    case 1:
+      return std::format("{{\"stream\":\"btcusdt@bookTicker\",\"data\":{{\"u\":{},\"s\":\"BTCUSDT\",\"b\":\"65000.12000000\","
+                         "\"B\":\"1.50000000\",\"a\":\"65000.13000000\",\"A\":\"2.00000000\"}}}}", id);
+    case 2:
+      return std::format("{{\"stream\":\"btcusdt@depth@100ms\",\"data\":{{\"e\":\"depthUpdate\",\"E\":1700000000000,\"s\":\"BTCUSDT\","
+                         "\"U\":{},\"u\":{},\"b\":[[\"65000.12000000\",\"1.50000000\"],[\"65000.11000000\",\"0.00000000\"]],"
+                         "\"a\":[[\"65000.13000000\",\"2.00000000\"]]}}}}", id, id);
+    case 3:
+      return std::format("{{\"stream\":\"btcusdt@kline_1m\",\"data\":{{\"e\":\"kline\",\"E\":1700000000000,\"s\":\"BTCUSDT\","
+                         "\"k\":{{\"t\":1700000000000,\"T\":1700000059999,\"s\":\"BTCUSDT\",\"i\":\"1m\",\"f\":1,\"L\":2,"
+                         "\"o\":\"65000.00000000\",\"c\":\"65000.12000000\",\"h\":\"65010.00000000\",\"l\":\"64990.00000000\","
+                         "\"v\":\"12.50000000\",\"n\":{},\"x\":false,\"q\":\"812500.00000000\",\"V\":\"6.0\",\"Q\":\"390000.0\",\"B\":\"0\"}}}}}}", id);
+    default:
+      return trade_message(id);
+  }
+}
+
+void bench_market_stream() {
+  print_bench_header("MarketStream (local ws stand-in, trade/bookTicker/depth/kline)");
+  const uint64_t n_messages{200000};
+  const uint64_t n_latency{2000};
+  WsStandIn stand_in{};
+  vector<string> messages{};
+  for (uint64_t i = 0; i < 64; i++) {
+    messages.push_back(stream_message(i));
+  }
+  atomic<uint64_t> send_ns{0};
+  thread server([&]() {
+    unique_ptr<WebSocket> ws{stand_in.accept_client()};
+    if (!ws) {
+      return;
+    }
+    for (uint64_t i = 0; i < n_messages; i++) {
+      ws->send_text(messages[i % messages.size()]);
+    }
+    // Клиент сообщает о завершении приема потока, иначе первое сообщение замера
+    // может быть обработано еще счетчиком пропускной способности
+    bool ready{false};
+    while (!ready && (0 <= ws->poll([&](WsOpcode, string_view) { ready = true; }, 1000))) {}
+    // Задержка: следующее сообщение отправляется после подтверждения клиента
+    for (uint64_t i = 0; i < n_latency; i++) {
+      string msg{trade_message(i)};
+      send_ns = now_ns();
+      ws->send_text(msg);
+      bool acked{false};
+      while (!acked && (0 <= ws->poll([&](WsOpcode, string_view) { acked = true; }, 1000))) {}
+    }
+    ws->close();
+  });
+  MarketStream stream{MarketStreamConfig{"127.0.0.1", stand_in.port(), false}};
+  uint64_t events{0};
+  LatencyHistogram latency{};
+  stream.on_trade([&](const TradeEvent &) { events++; });
+  stream.on_book_ticker([&](const BookTickerEvent &) { events++; });
+  stream.on_depth([&](const DepthEvent &) { events++; });
+  stream.on_kline([&](const KlineEvent &) { events++; });
+  Status status = stream.connect({});
+  if (0 != status.code) {
+    print_bench_row("Connect failed", status.msg);
+    server.join();
+    return;
+  }
+  auto start = bench_clock::now();
+  while ((events < n_messages) && (0 <= stream.poll(1000))) {}
+  double sec = chrono::duration<double>(bench_clock::now() - start).count();
+  MarketStreamStats st{stream.stats()};
+  stream.subscribe({});
+  // Ответ заглушке (любое сообщение) - подтверждение приема
+  uint64_t acks{0};
+  stream.on_trade([&](const TradeEvent &) {
+    latency.add(now_ns() - send_ns);
+    acks++;
+    stream.subscribe({});
+  });
+  while ((acks < n_latency) && (0 <= stream.poll(1000))) {}
+  server.join();
+  print_bench_row("Messages/sec", std::format("{:.0f}", st.messages / sec));
+  print_bench_row("MB/sec", std::format("{:.1f}", st.bytes / sec / 1e6));
+  print_bench_row("Events / errors", std::format("{} / {}", st.events, st.errors));
+  print_bench_row("Latency p50/p99 (ns)", std::format("{} / {}", latency.percentile(50.0), latency.percentile(99.0)));
+}
+
+void bench_stream_manager() {
+  print_bench_header("StreamManager (2 shards x 2 connections, 1 hot connection x10)");
+  const size_t n_conn{4};
+  const uint64_t n_cold{20000};
+  const uint64_t n_hot{10 * n_cold};
+  WsStandIn stand_in{};
+  thread server([&]() {
+    vector<thread> senders{};
+    for (size_t k = 0; k < n_conn; k++) {
+      shared_ptr<WebSocket> ws{stand_in.accept_client()};
+      if (!ws) {
+        break;
+      }
+      senders.emplace_back([ws, k, n = (0 == k) ? n_hot : n_cold]() {
+        for (uint64_t i = 0; i < n; i++) {
+          ws->send_text(std::format("{{\"stream\":\"sym{}usdt@trade\",\"data\":{{\"e\":\"trade\",\"E\":1700000000000,"
+                                    "\"s\":\"SYM{}USDT\",\"t\":{},\"p\":\"65000.12000000\",\"q\":\"0.00150000\","
+                                    "\"T\":1700000000000,\"m\":true}}}}", k, k, (k << 32) | i));
+        }
+        // Соединение закрывает клиент
+        while (0 <= ws->poll([](WsOpcode, string_view) {}, 1000)) {}
+      });
+    }
+    for (auto &sender : senders) {
+      sender.join();
+    }
+  });
+  StreamManagerConfig config{};
+  config.stream = MarketStreamConfig{"127.0.0.1", stand_in.port(), false};
+  config.shards = 2;
+  config.max_streams_per_connection = 1;
+  StreamManager manager{config};
+  array<atomic<uint64_t>, 4> counts{};
+  array<atomic<uint64_t>, 4> done_ns{};
+  auto start = bench_clock::now();
+  manager.on_trade([&](const TradeEvent &ev) {
+    size_t k = ev.trade_id >> 32;
+    uint64_t expected = (0 == k) ? n_hot : n_cold;
+    if (expected == ++counts[k]) {
+      done_ns[k] = chrono::duration_cast<chrono::nanoseconds>(bench_clock::now() - start).count();
+    }
+  });
+  manager.start();
+  Status status = manager.subscribe({"sym0usdt@trade", "sym1usdt@trade", "sym2usdt@trade", "sym3usdt@trade"});
+  if (0 != status.code) {
+    print_bench_row("Subscribe failed", status.msg);
+    manager.stop();
+    server.join();
+    return;
+  }
+  auto finished = [&]() {
+    for (size_t k = 0; k < n_conn; k++) {
+      if (0 == done_ns[k]) {
+        return false;
+      }
+    }
+    return true;
+  };
+  while (!finished() && (bench_clock::now() - start < chrono::seconds(30))) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  double sec = chrono::duration<double>(bench_clock::now() - start).count();
+  // Статистика публикуется шардами раз в секунду
+  this_thread::sleep_for(chrono::milliseconds(1100));
+  vector<StreamShardStats> stats{manager.stats()};
+  manager.stop();
+  server.join();
+  uint64_t total{0};
+  for (auto &st : stats) {
+    total += st.messages;
+    print_bench_row(std::format("Shard {} (cpu {}) conn/streams", st.shard, st.cpu), std::format("{} / {}", st.connections, st.streams));
+    print_bench_row(std::format("Shard {} messages / errors", st.shard), std::format("{} / {}", st.messages, st.errors));
+    print_bench_row(std::format("Shard {} max queue (bytes)", st.shard), std::format("{}", st.max_queue_bytes));
+  }
+  print_bench_row("Messages/sec (all shards)", std::format("{:.0f}", total / sec));
+  uint64_t cold_ns{0};
+  for (size_t k = 1; k < n_conn; k++) {
+    cold_ns = std::max<uint64_t>(cold_ns, done_ns[k]);
+  }
+  print_bench_row("Cold streams done (ms)", std::format("{:.1f}", cold_ns / 1e6));
+  print_bench_row("Hot stream done (ms)", std::format("{:.1f}", done_ns[0] / 1e6));
+}
+
+void bench_order_book() {
+  print_bench_header("LocalOrderBook replay (5000 levels/side, 200000 diffs x 10 levels)");
+  const int64_t tick_size{1000000}; // 0.01
+  const int64_t levels{5000};
+  const size_t n_updates{200000};
+  const size_t n_events{1024}; // Изменения повторяются по кругу с новыми U/u (данные событий в кеше)
+  const int64_t mid{6500000}; // 65000.00 в тиках
+  mt19937_64 gen{42};
+  DepthSnapshot snapshot{};
+  snapshot.last_update_id = 1000;
+  for (int64_t i = 1; i <= levels; i++) {
+    snapshot.bids.price.push_back((mid - i) * tick_size);
+    snapshot.bids.qty.push_back(100000000);
+    snapshot.asks.price.push_back((mid + i) * tick_size);
+    snapshot.asks.qty.push_back(100000000);
+  }
+  vector<DepthEvent> events(n_events);
+  int64_t center{mid};
+  for (size_t i = 0; i < n_events; i++) {
+    DepthEvent &ev = events[i];
+    center += static_cast<int64_t>(gen() % 3) - 1;
+    for (int k = 0; k < 5; k++) {
+      int64_t qty = (0 == gen() % 5) ? 0 : static_cast<int64_t>(gen() % 1000000000);
+      ev.bids.price.push_back((center - 1 - static_cast<int64_t>(gen() % 50)) * tick_size);
+      ev.bids.qty.push_back(qty);
+      qty = (0 == gen() % 5) ? 0 : static_cast<int64_t>(gen() % 1000000000);
+      ev.asks.price.push_back((center + 1 + static_cast<int64_t>(gen() % 50)) * tick_size);
+      ev.asks.qty.push_back(qty);
+    }
+  }
+  auto to_decimal = [](int64_t value) {
+    dec::decimal<8> result{};
+    result.setUnbiased(value);
+    return result;
+  };
+  // std::map<dec::decimal<8>, dec::decimal<8>>
+  map<dec::decimal<8>, dec::decimal<8>, greater<dec::decimal<8>>> map_bids{};
+  map<dec::decimal<8>, dec::decimal<8>> map_asks{};
+  auto map_apply = [&](auto &side, const DepthLevels &changes) {
+    for (size_t i = 0; i < changes.size(); i++) {
+      if (0 == changes.qty[i]) {
+        side.erase(to_decimal(changes.price[i]));
+      }
+      else {
+        side[to_decimal(changes.price[i])] = to_decimal(changes.qty[i]);
+      }
+    }
+  };
+  map_apply(map_bids, snapshot.bids);
+  map_apply(map_asks, snapshot.asks);
+  auto next_event = [&](size_t i) -> DepthEvent& {
+    DepthEvent &ev = events[i % n_events];
+    ev.first_update_id = snapshot.last_update_id + 1 + 3 * i;
+    ev.final_update_id = ev.first_update_id + 2;
+    return ev;
+  };
+  auto start = bench_clock::now();
+  for (size_t i = 0; i < n_updates; i++) {
+    DepthEvent &ev = next_event(i);
+    map_apply(map_bids, ev.bids);
+    map_apply(map_asks, ev.asks);
+  }
+  double map_sec = chrono::duration<double>(bench_clock::now() - start).count();
+
+  OrderBookConfig config{};
+  config.tick_size = tick_size;
+  LocalOrderBook book{"BTCUSDT", [&](const string &, size_t) { return snapshot; }, config};
+  start = bench_clock::now();
+  for (size_t i = 0; i < n_updates; i++) {
+    book.apply(next_event(i));
+  }
+  double sec = chrono::duration<double>(bench_clock::now() - start).count();
+  // Задержка применения - отдельным проходом (включает чтение часов)
+  LocalOrderBook timed{"BTCUSDT", [&](const string &, size_t) { return snapshot; }, config};
+  LatencyHistogram latency{};
+  for (size_t i = 0; i < n_updates; i++) {
+    DepthEvent &ev = next_event(i);
+    auto t0 = bench_clock::now();
+    timed.apply(ev);
+    latency.add(chrono::duration_cast<chrono::nanoseconds>(bench_clock::now() - t0).count());
+  }
+  BookLevel top[20];
+  const size_t n_top{1000000};
+  size_t sum{0};
+  auto top_start = bench_clock::now();
+  for (size_t i = 0; i < n_top; i++) {
+    sum += book.top_bids(20, top) + book.top_asks(20, top);
+  }
+  double top_ns = chrono::duration<double, nano>(bench_clock::now() - top_start).count() / n_top;
+  bool check = (book.price(book.best_bid().tick) == map_bids.begin()->first) &&
+               (book.price(book.best_ask().tick) == map_asks.begin()->first) &&
+               (book.bid_levels() == map_bids.size()) && (book.ask_levels() == map_asks.size());
+  // Снимок недоступен: первая ошибка откладывает следующие загрузки, изменения только буферизуются
+  size_t n_fetches{0};
+  LocalOrderBook failing{"BTCUSDT", [&](const string &, size_t) -> DepthSnapshot {
+    n_fetches++;
+    throw BinanceException{ExceptionType::Transport, -1, string{"Snapshot unavailable"}};
+  }, config};
+  for (size_t i = 0; i < 1000; i++) {
+    failing.apply(next_event(i));
+  }
+  OrderBookStats failing_st{failing.stats()};
+  check = check && (1 == n_fetches) && (1 == failing_st.snapshot_errors) && (999 == failing_st.snapshot_skipped) && !failing.is_live();
+  OrderBookStats st{book.stats()};
+  print_bench_row("std::map<decimal> updates/sec", std::format("{:.0f}", n_updates / map_sec));
+  print_bench_row("LocalOrderBook updates/sec", std::format("{:.0f}", n_updates / sec));
+  print_bench_row("Apply latency p50/p99 (ns)", std::format("{} / {}", latency.percentile(50.0), latency.percentile(99.0)));
+  print_bench_row("Top-20 both sides (ns)", std::format("{:.1f}", top_ns));
+  print_bench_row("Snapshots / applied / gaps", std::format("{} / {} / {}", st.snapshots, st.updates, st.gaps));
+  print_bench_row("Failed snapshot fetch / skipped", std::format("{} / {}", n_fetches, failing_st.snapshot_skipped));
+  print_bench_row("Check", std::format("{} {}", check ? "OK" : "MISMATCH", sum));
+}
+
+void bench_depth_decoder() {
+  print_bench_header("Depth levels decode (5000 levels [[\"price\",\"qty\"],...])");
+  const size_t n_levels{5000};
+  const size_t n_iter{200};
+  mt19937_64 gen{7};
+  string raw{"["};
+  for (size_t i = 0; i < n_levels; i++) {
+    uint64_t price = 6500000000000 - i * 1000000;
+    uint64_t qty = gen() % 10000000000;
+    raw += std::format("{}[\"{}.{}\",\"{}.{}\"]", (0 == i) ? "" : ",",
+                       price / 100000000, to_string(100000000 + price % 100000000).substr(1),
+                       qty / 100000000, to_string(100000000 + qty % 100000000).substr(1));
+  }
+  raw += "]";
+  auto levels_per_sec = [&](auto &&decode) {
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < n_iter; i++) {
+      decode();
+    }
+    return (n_levels * n_iter) / chrono::duration<double>(bench_clock::now() - start).count();
+  };
+  // dec::decimal<8>(std::string) для каждой строки
+  vector<dec::decimal<8>> dec_price{};
+  vector<dec::decimal<8>> dec_qty{};
+  double decimal_rate = levels_per_sec([&]() {
+    dec_price.clear();
+    dec_qty.clear();
+    size_t pos = raw.find('"');
+    while (string::npos != pos) {
+      size_t close = raw.find('"', pos + 1);
+      dec::decimal<8> value{raw.substr(pos + 1, close - pos - 1)};
+      (dec_price.size() == dec_qty.size()) ? dec_price.push_back(value) : dec_qty.push_back(value);
+      pos = raw.find('"', close + 1);
+    }
+  });
+  DepthLevels scalar{};
+  double scalar_rate = levels_per_sec([&]() { decode_levels_scalar(raw, scalar); });
+  DepthLevels simd{};
+  double simd_rate = levels_per_sec([&]() { decode_levels(raw, simd); });
+  DepthLevels ticks{};
+  double ticks_rate = levels_per_sec([&]() { decode_levels(raw, ticks, DepthScale{1000000, 1000}); });
+  bool check = (simd.price == scalar.price) && (simd.qty == scalar.qty) && (n_levels == simd.size()) &&
+               (dec_price.back().getUnbiased() == simd.price.back()) && (simd.price.back() / 1000000 == ticks.price.back());
+  print_bench_row("Payload size (bytes)", std::format("{}", raw.size()));
+  print_bench_row("dec::decimal<8>(string) levels/sec", std::format("{:.0f}", decimal_rate));
+  print_bench_row("Scalar levels/sec", std::format("{:.0f}", scalar_rate));
+  print_bench_row("SIMD levels/sec", std::format("{:.0f}", simd_rate));
+  print_bench_row("SIMD -> ticks/lots levels/sec", std::format("{:.0f}", ticks_rate));
+  print_bench_row("Check", check ? "OK" : "MISMATCH");
+}
+
+string order_result(uint64_t order_id) {
+  return std::format("{{\"symbol\":\"VETUSDT\",\"orderId\":{},\"orderListId\":-1,\"clientOrderId\":\"bench{}\",\"transactTime\":1700000000000,"
+                     "\"price\":\"0.02700000\",\"origQty\":\"423.00000000\",\"executedQty\":\"0.00000000\",\"cummulativeQuoteQty\":\"0.00000000\","
+                     "\"status\":\"NEW\",\"timeInForce\":\"GTC\",\"type\":\"LIMIT\",\"side\":\"BUY\",\"workingTime\":1700000000000,"
+                     "\"fills\":[],\"selfTradePreventionMode\":\"NONE\"}}", order_id, order_id);
+}
+
+string order_ack(uint64_t order_id) {
+  return std::format("{{\"symbol\":\"VETUSDT\",\"orderId\":{},\"orderListId\":-1,\"clientOrderId\":\"bench{}\",\"transactTime\":1700000000000}}",
+                     order_id, order_id);
+}
+
+string order_full(uint64_t order_id) {
+  string result{order_result(order_id)};
+  result.replace(result.find("\"fills\":[]"), 10,
+                 "\"fills\":[{\"price\":\"0.02700000\",\"qty\":\"200.00000000\",\"commission\":\"0.20000000\",\"commissionAsset\":\"VET\",\"tradeId\":1},"
+                 "{\"price\":\"0.02700000\",\"qty\":\"223.00000000\",\"commission\":\"0.22300000\",\"commissionAsset\":\"VET\",\"tradeId\":2}]");
+  return result;
+}
+
+/// @brief Заглушка REST: один HTTP запрос на соединение (как Request без повторного использования соединения)
+/// @param first_byte Время (now_ns) получения первого байта последнего запроса
+void serve_rest(WsStandIn &stand_in, uint64_t n_requests, atomic<uint64_t> *first_byte = nullptr) {
+  for (uint64_t i = 0; i < n_requests; i++) {
+    int fd = stand_in.accept_raw();
+    if (0 > fd) {
+      return;
+    }
+    string data{};
+    char buffer[4096];
+    size_t need{string::npos};
+    while ((string::npos == need) || (data.size() < need)) {
+      ssize_t r = ::read(fd, buffer, sizeof(buffer));
+      if (0 >= r) {
+        break;
+      }
+      if (data.empty() && (nullptr != first_byte)) {
+        first_byte->store(now_ns());
+      }
+      data.append(buffer, r);
+      size_t end = data.find("\r\n\r\n");
+      if ((string::npos == need) && (string::npos != end)) {
+        size_t length{0};
+        size_t pos = data.find("Content-Length: ");
+        if ((string::npos != pos) && (pos < end)) {
+          length = stoull(data.substr(pos + 16));
+        }
+        need = end + 4 + length;
+      }
+    }
+    string body{order_result(i + 1)};
+    string response{std::format("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: {}\r\nConnection: close\r\n\r\n{}", body.size(), body)};
+    ::write(fd, response.data(), response.size());
+    ::close(fd);
+  }
+}
+
+/// @brief Путь Binance::create_order поверх заглушки (подпись HMAC, POST, разбор json)
+Order rest_create_order(Request &request, const Auth &auth, Order &order) {
+  headerparams header{BaseHeader()};
+  header.add("X-MBX-APIKEY", auth.api_key);
+  urlparams params;
+  params.add("symbol", order.symbol);
+  params.add("side", side_to_str(order.side));
+  params.add("type", std::string{"LIMIT"});
+  params.add("timeInForce", std::string{"GTC"});
+  params.add("quantity", order.origQty);
+  params.add("price", order.price);
+  params.add("newOrderRespType", std::string{"RESULT"});
+  params.add("recvWindow", 5000);
+  params.add("timestamp", current_ms_epoch());
+  params.add("signature", hmac_sha256(auth.user_key.c_str(), params.url_params.c_str()));
+  RequestResult r_result = request.request(RequestType::POST, "/api/v3/order", header, params);
+  if ((0 != r_result.transport.code) || (200 != r_result.header.code)) {
+    throw BinanceException{ExceptionType::Transport, r_result.transport.code, r_result.transport.msg};
+  }
+  json js = json::parse(r_result.body);
+  Order result{};
+  result.symbol = js.value("symbol", std::string{});
+  result.orderId = js.value("orderId", uint64_t{});
+  result.price = dec::decimal<8>(js.value("price", std::string{}));
+  result.origQty = dec::decimal<8>(js.value("origQty", std::string{}));
+  result.status = str_to_order_status(js.value("status", std::string{}));
+  return result;
+}
+
+/// @brief Путь Binance::create_order(OrderTemplate&) поверх заглушки
+Order rest_create_order(Request &request, OrderTemplate &order_template, const Order &order) {
+  urlparams params;
+  params.url_params = order_template.query(order.price, order.origQty, current_ms_epoch());
+  RequestResult r_result = request.request(RequestType::POST, "/api/v3/order", order_template.header(), params);
+  if ((0 != r_result.transport.code) || (200 != r_result.header.code)) {
+    throw BinanceException{ExceptionType::Transport, r_result.transport.code, r_result.transport.msg};
+  }
+  json js = json::parse(r_result.body);
+  Order result{};
+  result.orderId = js.value("orderId", uint64_t{});
+  result.status = str_to_order_status(js.value("status", std::string{}));
+  return result;
+}
+
+const Order bench_order{"VETUSDT", 0, dec::decimal<8>("0.02700000"), dec::decimal<8>("423.00000000"), Side::BUY, OrderStatus::NEW, 0};
+
+/// @brief Проверка подписи session.logon, как на сервере: ключи params без повторов,
+/// подпись Ed25519 строки отсортированных параметров (кроме signature)
+bool verify_logon(const string &pem, string_view message) {
+  json js = json::parse(message, nullptr, false);
+  if (!js.is_object() || !js.contains("params") || !js["params"].is_object()) {
+    return false;
+  }
+  const json &params = js["params"];
+  string payload{};
+  for (auto &[key, value] : params.items()) {
+    size_t count{0};
+    string quoted{std::format("\"{}\":", key)};
+    for (size_t pos = message.find(quoted); string_view::npos != pos; pos = message.find(quoted, pos + 1)) {
+      count++;
+    }
+    if (1 != count) {
+      return false;
+    }
+    if ("signature" != key) {
+      payload += std::format("{}{}={}", payload.empty() ? "" : "&", key, value.is_string() ? value.get<string>() : value.dump());
+    }
+  }
+  string signature_b64{params.value("signature", string{})};
+  unsigned char signature[96];
+  if ((88 != signature_b64.size()) || (0 > EVP_DecodeBlock(signature, reinterpret_cast<const unsigned char*>(signature_b64.data()), 88))) {
+    return false;
+  }
+  BIO *bio = BIO_new_mem_buf(pem.data(), static_cast<int>(pem.size()));
+  EVP_PKEY *key = bio ? PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr) : nullptr;
+  BIO_free(bio);
+  EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+  bool ok = key && ctx && (1 == EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr, key))
+            && (1 == EVP_DigestVerify(ctx, signature, 64, reinterpret_cast<const unsigned char*>(payload.data()), payload.size()));
+  EVP_MD_CTX_free(ctx);
+  EVP_PKEY_free(key);
+  return ok && ("bench-api-key" == params.value("apiKey", string{}));
+}
+
+void bench_user_stream_reconnect() {
+  print_bench_header("User data stream reconnect (server drop -> on_reconnect resync -> events)");
+  const string report{"{\"e\":\"executionReport\",\"E\":1700000000001,\"s\":\"VETUSDT\",\"c\":\"bench1\",\"S\":\"BUY\","
+                      "\"o\":\"LIMIT_MAKER\",\"f\":\"GTC\",\"q\":\"423.00000000\",\"p\":\"0.02700000\",\"P\":\"0.00000000\","
+                      "\"Q\":\"0.00000000\",\"x\":\"NEW\",\"X\":\"NEW\",\"i\":42,\"T\":1700000000000}"};
+  WsStandIn stand_in{};
+  std::atomic<uint64_t> keys{0};
+  UserDataStream::ListenKeyApi api{[&keys]() { return std::format("bench-key-{}", ++keys); },
+                                   [](const string &) {}, [](const string &) {}};
+  UserStreamConfig config{"127.0.0.1", stand_in.port(), false};
+  config.reconnect_min = chrono::milliseconds{10};
+  UserDataStream stream{api, config};
+  std::mutex mtx;
+  vector<string> sequence{};
+  std::atomic<uint64_t> dropped_ns{0};
+  double resync_ms{0.0};
+  stream.on_reconnect([&]() {
+    std::lock_guard<std::mutex> lock(mtx);
+    resync_ms = static_cast<double>(now_ns() - dropped_ns) / 1e6;
+    sequence.push_back("resync");
+  });
+  stream.on_order([&](const ExecutionReport &ev) {
+    std::lock_guard<std::mutex> lock(mtx);
+    sequence.push_back(std::format("order {}", ev.order.orderId));
+  });
+  thread server([&]() {
+    // Первое соединение обрывается сервером, второе получает событие
+    unique_ptr<WebSocket> first{stand_in.accept_client()};
+    if (!first) {
+      return;
+    }
+    this_thread::sleep_for(chrono::milliseconds{20});
+    dropped_ns = now_ns();
+    first->close();
+    unique_ptr<WebSocket> second{stand_in.accept_client()};
+    if (!second) {
+      return;
+    }
+    second->send_text(report);
+    for (int i = 0; (i < 100) && (0 <= second->poll([](WsOpcode, string_view) {}, 10)); i++) {}
+  });
+  Status status{stream.start()};
+  for (int i = 0; i < 200; i++) {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      if (2 <= sequence.size()) {
+        break;
+      }
+    }
+    this_thread::sleep_for(chrono::milliseconds{5});
+  }
+  stream.stop();
+  server.join();
+  UserStreamStats st{stream.stats()};
+  bool ok = (0 == status.code) && (2 == sequence.size()) && ("resync" == sequence[0]) && ("order 42" == sequence[1]) && (1 == st.reconnects);
+  print_bench_row("Drop to resync (ms)", std::format("{:.1f}", resync_ms));
+  print_bench_row("Reconnects", std::format("{}", st.reconnects));
+  print_bench_row("Check", ok ? "OK" : "MISMATCH");
+}
+
+void bench_order_session() {
+  print_bench_header("OrderSession (WebSocket API vs REST, local stand-ins)");
+  const uint64_t n_orders{5000};
+  const uint64_t n_rest{500};
+  const size_t n_threads{4};
+  const Auth auth{"bench-api-key", "bench-secret"};
+  // Заглушка WebSocket API: ответ на каждый запрос с тем же id
+  WsStandIn ws_stand_in{};
+  atomic<bool> logon{false};
+  const string pem{Ed25519Signer::generate_pem()};
+  thread ws_server([&]() {
+    unique_ptr<WebSocket> ws{ws_stand_in.accept_client()};
+    if (!ws) {
+      return;
+    }
+    uint64_t order_id{0};
+    while (0 <= ws->poll([&](WsOpcode, string_view message) {
+      string_view id{};
+      string_view method{};
+      JsonScanner::find(message, "id", id);
+      JsonScanner::find(message, "method", method);
+      string result{};
+      if ("session.logon" == method) {
+        logon = verify_logon(pem, message);
+        if (!logon) {
+          ws->send_text(std::format("{{\"id\":{},\"status\":400,\"error\":{{\"code\":-1022,\"msg\":\"Signature for this request is not valid.\"}}}}", id));
+          return;
+        }
+        result = "{\"apiKey\":\"bench-api-key\",\"authorizedSince\":1700000000000,\"serverTime\":1700000000000}";
+      }
+      else {
+        result = order_result(++order_id);
+      }
+      ws->send_text(std::format("{{\"id\":{},\"status\":200,\"result\":{},\"rateLimits\":[]}}", id, result));
+    }, 1000)) {}
+  });
+  OrderSessionConfig config{"127.0.0.1", ws_stand_in.port(), "/ws-api/v3", false};
+  config.order_limit = std::numeric_limits<uint32_t>::max(); // Замер задержки, а не лимита ORDERS
+  OrderSession session{auth, pem, config};
+  Status status = session.connect();
+  if (0 != status.code) {
+    print_bench_row("Connect failed", status.msg);
+    print_bench_row("Check", "MISMATCH");
+    session.close();
+    ws_server.join();
+    return;
+  }
+  LatencyHistogram ws_latency{};
+  uint64_t ws_errors{0};
+  Order order{bench_order};
+  for (uint64_t i = 0; i < n_orders; i++) {
+    uint64_t start = now_ns();
+    try {
+      session.create_order(order);
+    }
+    catch (BinanceException &) {
+      ws_errors++;
+    }
+    ws_latency.add(now_ns() - start);
+  }
+  // Несколько потоков через одну сессию: запросы сопоставляются по id
+  atomic<uint64_t> mt_errors{0};
+  auto mt_start = bench_clock::now();
+  vector<thread> threads{};
+  for (size_t t = 0; t < n_threads; t++) {
+    threads.emplace_back([&]() {
+      Order mt_order{bench_order};
+      for (uint64_t i = 0; i < n_orders / n_threads; i++) {
+        try {
+          session.create_order(mt_order);
+        }
+        catch (BinanceException &) {
+          mt_errors++;
+        }
+      }
+    });
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+  double mt_sec = chrono::duration<double>(bench_clock::now() - mt_start).count();
+  session.close();
+  ws_server.join();
+  // REST: новое соединение и подпись HMAC на каждый ордер
+  WsStandIn rest_stand_in{};
+  thread rest_server([&]() { serve_rest(rest_stand_in, n_rest); });
+  Request request{"http://127.0.0.1", rest_stand_in.port()};
+  LatencyHistogram rest_latency{};
+  uint64_t rest_errors{0};
+  for (uint64_t i = 0; i < n_rest; i++) {
+    uint64_t start = now_ns();
+    try {
+      rest_create_order(request, auth, order);
+    }
+    catch (BinanceException &) {
+      rest_errors++;
+    }
+    rest_latency.add(now_ns() - start);
+  }
+  rest_server.join();
+  OrderSessionStats st{session.stats()};
+  print_bench_row("Session logon", logon ? "OK" : "NO");
+  print_bench_row("WS API p50/p99 (ns)", std::format("{} / {}", ws_latency.percentile(50.0), ws_latency.percentile(99.0)));
+  print_bench_row("REST p50/p99 (ns)", std::format("{} / {}", rest_latency.percentile(50.0), rest_latency.percentile(99.0)));
+  print_bench_row(std::format("WS API {} threads orders/sec", n_threads), std::format("{:.0f}", (n_orders / n_threads * n_threads) / mt_sec));
+  print_bench_row("Requests / responses", std::format("{} / {}", st.requests, st.responses));
+  print_bench_row("Errors WS / MT / REST", std::format("{} / {} / {}", ws_errors, mt_errors.load(), rest_errors));
+  print_bench_row("Check", (logon && (0 == ws_errors) && (0 == mt_errors)) ? "OK" : "MISMATCH");
+}
+
+/// @brief Тестовые данные SBE: ответ /api/v3/ticker/price (те же цены, что в price_payload)
+string sbe_price_payload(const vector<string> &symbols) {
+  SbeEncoder encoder{};
+  encoder.begin(SbeTemplate::PRICE_TICKER, 0);
+  encoder.group(SbePriceLayout::block_length, symbols.size());
+  for (size_t i = 0; i < symbols.size(); i++) {
+    encoder.entry(SbePriceLayout::block_length)
+           .set<SbePriceLayout::price_exponent>(-8)
+           .set<SbePriceLayout::price>(static_cast<int64_t>(i % 70000) * 100000000 + static_cast<int64_t>((i * 7919) % 100000000))
+           .var8(symbols[i]);
+  }
+  return encoder.data();
+}
+
+/// @brief Тестовые данные SBE: ответ newOrderRespType=RESULT (как order_result)
+string sbe_order_result(uint64_t order_id) {
+  using L = SbeOrderResultLayout;
+  SbeEncoder encoder{};
+  encoder.begin(SbeTemplate::NEW_ORDER_RESULT, L::block_length)
+         .set<L::price_exponent>(-8).set<L::qty_exponent>(-8)
+         .set<L::order_id>(static_cast<int64_t>(order_id)).set<L::order_list_id>(L::order_list_id::null)
+         .set<L::transact_time>(1700000000000).set<L::price>(2700000).set<L::orig_qty>(42300000000)
+         .set<L::executed_qty>(0).set<L::cummulative_quote_qty>(0).set<L::status>(0).set<L::side>(0)
+         .var8("VETUSDT").var8(std::format("bench{}", order_id));
+  return encoder.data();
+}
+
+void bench_sbe_decode() {
+  print_bench_header("SBE vs JSON decode (fixtures)");
+  const size_t n_iter{200};
+  const size_t n_orders{200000};
+  vector<string> symbols{bench_symbols(2000)};
+  string json_prices{price_payload(symbols)};
+  string sbe_prices{sbe_price_payload(symbols)};
+  size_t check{0};
+  auto start = bench_clock::now();
+  for (size_t i = 0; i < n_iter; i++) {
+    PriceTable table{};
+    decode_price_table(json_prices, table);
+    check += table.size();
+  }
+  double json_prices_us = chrono::duration<double, micro>(bench_clock::now() - start).count() / n_iter;
+  start = bench_clock::now();
+  for (size_t i = 0; i < n_iter; i++) {
+    PriceTable table{};
+    sbe_decode_price_table(sbe_prices, table);
+    check += table.size();
+  }
+  double sbe_prices_us = chrono::duration<double, micro>(bench_clock::now() - start).count() / n_iter;
+  PriceTable json_table{};
+  PriceTable sbe_table{};
+  decode_price_table(json_prices, json_table);
+  sbe_decode_price_table(sbe_prices, sbe_table);
+  bool prices_equal = (json_table.prices == sbe_table.prices) && (json_table.symbols == sbe_table.symbols);
+  // Ордер: разбор JSON (как Binance::create_order) и SBE
+  string json_order{order_result(12345)};
+  string sbe_order{sbe_order_result(12345)};
+  uint64_t ids{0};
+  start = bench_clock::now();
+  for (size_t i = 0; i < n_orders / 10; i++) {
+    json js = json::parse(json_order);
+    Order order{};
+    order.symbol = js.value("symbol", string{});
+    order.orderId = js.value("orderId", uint64_t{});
+    order.price = dec::decimal<8>(js.value("price", string{}));
+    order.origQty = dec::decimal<8>(js.value("origQty", string{}));
+    order.side = str_to_side(js.value("side", string{}));
+    order.status = str_to_order_status(js.value("status", string{}));
+    order.time = js.value("transactTime", uint64_t{});
+    ids += order.orderId;
+  }
+  double json_order_ns = chrono::duration<double, nano>(bench_clock::now() - start).count() / (n_orders / 10);
+  Order sbe_result{};
+  start = bench_clock::now();
+  for (size_t i = 0; i < n_orders; i++) {
+    sbe_decode_order(sbe_order, sbe_result);
+    ids += sbe_result.orderId;
+  }
+  double sbe_order_ns = chrono::duration<double, nano>(bench_clock::now() - start).count() / n_orders;
+  bool order_equal = ("VETUSDT" == sbe_result.symbol) && (12345 == sbe_result.orderId) && (bench_order.price == sbe_result.price) &&
+                     (bench_order.origQty == sbe_result.origQty) && (OrderStatus::NEW == sbe_result.status) && (Side::BUY == sbe_result.side);
+  // WebSocket API с ответами SBE (бинарные кадры)
+  WsStandIn stand_in{};
+  thread ws_server([&]() {
+    unique_ptr<WebSocket> ws{stand_in.accept_client()};
+    if (!ws) {
+      return;
+    }
+    uint64_t order_id{0};
+    SbeEncoder envelope{};
+    while (0 <= ws->poll([&](WsOpcode, string_view message) {
+      string_view id{};
+      JsonScanner::find(message, "id", id);
+      envelope.begin(SbeTemplate::WEBSOCKET_RESPONSE, SbeWsResponseLayout::block_length);
+      envelope.set<SbeWsResponseLayout::status>(200).group(0, 0).var8(id).var32(sbe_order_result(++order_id));
+      ws->send(WsOpcode::BINARY, envelope.data());
+    }, 1000)) {}
+  });
+  OrderSessionConfig config{"127.0.0.1", stand_in.port(), "/ws-api/v3", false};
+  config.order_limit = std::numeric_limits<uint32_t>::max(); // Замер задержки, а не лимита ORDERS
+  config.sbe = true;
+  OrderSession session{Auth{"bench-api-key", "bench-secret"}, string{}, config};
+  LatencyHistogram ws_latency{};
+  uint64_t ws_errors{0};
+  if (0 == session.connect().code) {
+    Order order{bench_order};
+    for (uint64_t i = 0; i < 5000; i++) {
+      uint64_t order_start = now_ns();
+      try {
+        Order placed{session.create_order(order)};
+        ws_errors += (i + 1 == placed.orderId) ? 0 : 1;
+      }
+      catch (BinanceException &) {
+        ws_errors++;
+      }
+      ws_latency.add(now_ns() - order_start);
+    }
+  }
+  session.close();
+  ws_server.join();
+  print_bench_row("Prices JSON / SBE (bytes)", std::format("{} / {}", json_prices.size(), sbe_prices.size()));
+  print_bench_row("Prices JSON SAX (us)", std::format("{:.1f}", json_prices_us));
+  print_bench_row("Prices SBE (us)", std::format("{:.1f}", sbe_prices_us));
+  print_bench_row("Order JSON DOM (ns)", std::format("{:.0f}", json_order_ns));
+  print_bench_row("Order SBE (ns)", std::format("{:.0f}", sbe_order_ns));
+  print_bench_row("WS API SBE p50/p99 (ns)", std::format("{} / {}", ws_latency.percentile(50.0), ws_latency.percentile(99.0)));
+  print_bench_row("Check", (prices_equal && order_equal && (0 == ws_errors)) ? std::format("OK {} {}", check, ids % 10) : "MISMATCH");
+}
+
+void bench_fix_session() {
+  print_bench_header("FixSession (FIX 4.4 order entry, local acceptor)");
+  const uint64_t n_orders{5000};
+  const uint64_t n_codec{200000};
+  const Auth auth{"bench-api-key", "bench-secret"};
+  // Кодеки: NewOrderSingle и разбор ExecutionReport
+  FixWriter writer{};
+  auto encode_start = bench_clock::now();
+  size_t encoded{0};
+  for (uint64_t i = 0; i < n_codec; i++) {
+    writer.begin(FixMsgType::NEW_ORDER_SINGLE, "BNCPP", "SPOT", i + 1, "20231114-22:13:20.000000");
+    encode_new_order(writer, bench_order, "bench-1");
+    encoded += writer.finish().size();
+  }
+  double encode_ns = chrono::duration<double, nano>(bench_clock::now() - encode_start).count() / n_codec;
+  writer.begin(FixMsgType::EXECUTION_REPORT, "SPOT", "BNCPP", 1, "20231114-22:13:20.000000");
+  writer.field(FixTag::CL_ORD_ID, std::string_view("bench-1")).field(FixTag::ORDER_ID, uint64_t{12345}).field(FixTag::EXEC_TYPE, '0')
+        .field(FixTag::ORD_STATUS, '0').field(FixTag::SYMBOL, std::string_view("VETUSDT")).field(FixTag::SIDE, '1')
+        .field(FixTag::PRICE, bench_order.price).field(FixTag::ORDER_QTY, bench_order.origQty)
+        .field(FixTag::TRANSACT_TIME, std::string_view("20231114-22:13:20.000000"));
+  string report_data{writer.finish()};
+  FixMessage message{};
+  FixExecutionReport report{};
+  auto decode_start = bench_clock::now();
+  uint64_t decoded{0};
+  for (uint64_t i = 0; i < n_codec; i++) {
+    if ((0 < fix_frame(report_data)) && message.parse(report_data) && decode_execution_report(message, report)) {
+      decoded += report.order.orderId;
+    }
+  }
+  double decode_ns = chrono::duration<double, nano>(bench_clock::now() - decode_start).count() / n_codec;
+  // Сессия: tick-to-ack create_order, заглушка пропускает один номер (ResendRequest -> GapFill)
+  FixStandIn stand_in{};
+  stand_in.skip_seq = 10;
+  stand_in.resend_from = 1;
+  thread fix_server([&]() { stand_in.serve(); });
+  FixSessionConfig config{"127.0.0.1", stand_in.port(), false};
+  FixSession session{auth, Ed25519Signer::generate_pem(), config};
+  Status status = session.logon();
+  if (0 != status.code) {
+    print_bench_row("Logon failed", status.msg);
+    session.logout();
+    fix_server.join();
+    return;
+  }
+  LatencyHistogram latency{};
+  uint64_t errors{0};
+  Order order{bench_order};
+  for (uint64_t i = 0; i < n_orders; i++) {
+    uint64_t start = now_ns();
+    try {
+      session.create_order(order);
+    }
+    catch (BinanceException &) {
+      errors++;
+    }
+    latency.add(now_ns() - start);
+  }
+  Order canceled{};
+  try {
+    canceled = session.cancel_order(bench_order.symbol, 1);
+  }
+  catch (BinanceException &) {
+    errors++;
+  }
+  auto [out_seq, in_seq] = session.sequence();
+  session.logout();
+  fix_server.join();
+  FixSessionStats st{session.stats()};
+  print_bench_row("NewOrderSingle encode (ns)", std::format("{:.0f}", encode_ns));
+  print_bench_row("ExecutionReport decode (ns)", std::format("{:.0f}", decode_ns));
+  print_bench_row("Logon signature", stand_in.signature.empty() ? "NO" : "OK");
+  print_bench_row("Tick-to-ack p50/p99 (ns)", std::format("{} / {}", latency.percentile(50.0), latency.percentile(99.0)));
+  print_bench_row("Cancel", (OrderStatus::CANCELED == canceled.status) ? "OK" : "FAILED");
+  print_bench_row("Sent / received", std::format("{} / {}", st.sent, st.received));
+  print_bench_row("Seq out / in", std::format("{} / {}", out_seq, in_seq));
+  print_bench_row("Resend requests / gap fills", std::format("{} / {}", st.resend_requests, stand_in.resend_requests.load()));
+  print_bench_row("Session gap fills", std::format("{} / {}", st.gap_fills, stand_in.gap_fills.load()));
+  print_bench_row("Errors", std::format("{} (decoded {})", errors + st.errors, decoded > 0 ? "OK" : "NO"));
+  bool ok = (0 == errors + st.errors) && (1 == st.gap_fills) && (1 == stand_in.gap_fills);
+  print_bench_row("Check", ok ? "OK" : "MISMATCH");
+}
+
+void bench_order_template() {
+  print_bench_header("OrderTemplate (cached prefix + HMAC state vs full build and sign)");
+  const uint64_t n_sign{200000};
+  const uint64_t n_rest{300};
+  const Auth auth{"bench-api-key", "bench-secret"};
+  Order order{bench_order};
+  OrderTemplate order_template{auth, order.symbol, order.side};
+  // CPU: сборка и подпись параметров ордера
+  size_t classic_size{0};
+  auto classic_start = bench_clock::now();
+  for (uint64_t i = 0; i < n_sign; i++) {
+    headerparams header{BaseHeader()};
+    header.add("X-MBX-APIKEY", auth.api_key);
+    urlparams params;
+    params.add("symbol", order.symbol);
+    params.add("side", side_to_str(order.side));
+    params.add("type", std::string{"LIMIT"});
+    params.add("timeInForce", std::string{"GTC"});
+    params.add("quantity", order.origQty);
+    params.add("price", order.price);
+    params.add("newOrderRespType", std::string{"RESULT"});
+    params.add("recvWindow", 5000);
+    params.add("timestamp", 1700000000000 + i);
+    params.add("signature", hmac_sha256(auth.user_key.c_str(), params.url_params.c_str()));
+    classic_size += params.url_params.size() + header.header_params.size();
+  }
+  double classic_ns = chrono::duration<double, nano>(bench_clock::now() - classic_start).count() / n_sign;
+  size_t template_size{0};
+  auto template_start = bench_clock::now();
+  for (uint64_t i = 0; i < n_sign; i++) {
+    template_size += order_template.query(order.price, order.origQty, 1700000000000 + i).size();
+  }
+  double template_ns = chrono::duration<double, nano>(bench_clock::now() - template_start).count() / n_sign;
+  // Подпись шаблона совпадает с подписью всей строки
+  string query{order_template.query(order.price, order.origQty, 1700000000000)};
+  size_t sign_pos = query.find("&signature=");
+  bool check = (string::npos != sign_pos) &&
+               (query.substr(sign_pos + 11) == hmac_sha256(auth.user_key.c_str(), query.substr(0, sign_pos).c_str()));
+  // От вызова до первого байта на стороне сервера
+  auto first_byte_latency = [&](LatencyHistogram &latency, auto &&send) {
+    WsStandIn stand_in{};
+    atomic<uint64_t> first_byte{0};
+    thread rest_server([&]() { serve_rest(stand_in, n_rest, &first_byte); });
+    Request request{"http://127.0.0.1", stand_in.port()};
+    for (uint64_t i = 0; i < n_rest; i++) {
+      uint64_t start = now_ns();
+      try {
+        send(request);
+        latency.add(first_byte.load() - start);
+      }
+      catch (BinanceException &) {
+        check = false;
+      }
+    }
+    rest_server.join();
+  };
+  LatencyHistogram classic_latency{};
+  LatencyHistogram template_latency{};
+  first_byte_latency(classic_latency, [&](Request &request) { rest_create_order(request, auth, order); });
+  first_byte_latency(template_latency, [&](Request &request) { rest_create_order(request, order_template, order); });
+  print_bench_row("Build + sign (ns)", std::format("{:.0f}", classic_ns));
+  print_bench_row("OrderTemplate query (ns)", std::format("{:.0f}", template_ns));
+  print_bench_row("Call -> first byte p50/p99 (ns)", std::format("{} / {}", classic_latency.percentile(50.0), classic_latency.percentile(99.0)));
+  print_bench_row("Template -> first byte p50/p99", std::format("{} / {}", template_latency.percentile(50.0), template_latency.percentile(99.0)));
+  print_bench_row("Check", (check && (0 < classic_size) && (0 < template_size)) ? "OK" : "MISMATCH");
+}
+
+void bench_order_resp_type() {
+  print_bench_header("newOrderRespType ACK / RESULT / FULL (decode, WS API local stand-in)");
+  const uint64_t n_decode{200000};
+  const uint64_t n_orders{5000};
+  const Auth auth{"bench-api-key", "bench-secret"};
+  string ack_body{order_ack(12345)};
+  string result_body{order_result(12345)};
+  string full_body{order_full(12345)};
+  // Разбор ответа: ACK без DOM, RESULT через json DOM (как json_to_order), FULL - сделки без DOM
+  uint64_t sum{0};
+  OrderAck ack{};
+  auto ack_start = bench_clock::now();
+  for (uint64_t i = 0; i < n_decode; i++) {
+    if (decode_order_ack(ack_body, ack)) {
+      sum += ack.orderId;
+    }
+  }
+  double ack_ns = chrono::duration<double, nano>(bench_clock::now() - ack_start).count() / n_decode;
+  auto result_start = bench_clock::now();
+  for (uint64_t i = 0; i < n_decode; i++) {
+    json js = json::parse(result_body);
+    sum += js.value("orderId", uint64_t{});
+    sum += dec::decimal<8>(js.value("price", std::string{})).getUnbiased();
+    sum += dec::decimal<8>(js.value("origQty", std::string{})).getUnbiased();
+    sum += static_cast<uint64_t>(str_to_order_status(js.value("status", std::string{})));
+  }
+  double result_ns = chrono::duration<double, nano>(bench_clock::now() - result_start).count() / n_decode;
+  vector<Fill> fills{};
+  string_view fills_array{};
+  bool check = JsonScanner::find(full_body, "fills", fills_array) && decode_fills(fills_array, fills) && (2 == fills.size()) &&
+               (dec::decimal<8>("423.00000000") == fills[0].qty + fills[1].qty) && (2 == fills[1].tradeId) && ("VET" == fills[0].commissionAsset);
+  check = check && decode_order_ack(ack_body, ack) && ("bench12345" == ack.clientOrderId) && (1700000000000 == ack.transactTime);
+  // Binance::create_order(FULL): сделки тем же разбором; число вместо строки в fills не бросает json::type_error
+  RequestResult full_response{};
+  full_response.transport = Status(0, "No error");
+  full_response.header = Status(200, "OK");
+  full_response.content_type = "application/json;charset=UTF-8";
+  full_response.body = full_body;
+  BinanceResult<Order> full_order{endpoint::NewOrderFull::decode(full_response)};
+  check = check && full_order.has_value() && (12345 == full_order->orderId) && (2 == full_order->fills.size()) && (2 == full_order->fills[1].tradeId);
+  full_response.body = "{\"symbol\":\"VETUSDT\",\"orderId\":1,\"fills\":[{\"price\":0.027,\"qty\":\"423\",\"tradeId\":7}]}";
+  full_order = endpoint::NewOrderFull::decode(full_response);
+  check = check && full_order.has_value() && (1 == full_order->fills.size()) && (dec::decimal<8>("0.027") == full_order->fills[0].price);
+  // WebSocket API: ответ заглушки по запрошенному newOrderRespType
+  WsStandIn stand_in{};
+  thread ws_server([&]() {
+    unique_ptr<WebSocket> ws{stand_in.accept_client()};
+    if (!ws) {
+      return;
+    }
+    uint64_t order_id{0};
+    while (0 <= ws->poll([&](WsOpcode, string_view message) {
+      string_view id{};
+      JsonScanner::find(message, "id", id);
+      string result{};
+      if (string_view::npos != message.find("\"newOrderRespType\":\"ACK\"")) {
+        result = order_ack(++order_id);
+      }
+      else if (string_view::npos != message.find("\"newOrderRespType\":\"FULL\"")) {
+        result = order_full(++order_id);
+      }
+      else {
+        result = order_result(++order_id);
+      }
+      ws->send_text(std::format("{{\"id\":{},\"status\":200,\"result\":{},\"rateLimits\":[]}}", id, result));
+    }, 1000)) {}
+  });
+  OrderSessionConfig config{"127.0.0.1", stand_in.port(), "/ws-api/v3", false};
+  config.order_limit = std::numeric_limits<uint32_t>::max(); // Замер задержки, а не лимита ORDERS
+  OrderSession session{auth, Ed25519Signer::generate_pem(), config};
+  Status status = session.connect();
+  if (0 != status.code) {
+    print_bench_row("Connect failed", status.msg);
+    ws_server.join();
+    return;
+  }
+  LatencyHistogram ack_latency{};
+  LatencyHistogram result_latency{};
+  LatencyHistogram full_latency{};
+  Order order{bench_order};
+  uint64_t errors{0};
+  for (uint64_t i = 0; i < n_orders; i++) {
+    try {
+      uint64_t start = now_ns();
+      sum += session.create_order_ack(order).orderId;
+      ack_latency.add(now_ns() - start);
+      start = now_ns();
+      sum += session.create_order(order).orderId;
+      result_latency.add(now_ns() - start);
+      start = now_ns();
+      Order full{session.create_order(order, OrderRespType::FULL)};
+      full_latency.add(now_ns() - start);
+      check = check && (2 == full.fills.size());
+    }
+    catch (BinanceException &) {
+      errors++;
+    }
+  }
+  session.close();
+  ws_server.join();
+  print_bench_row("ACK decode (ns)", std::format("{:.0f}", ack_ns));
+  print_bench_row("RESULT decode DOM (ns)", std::format("{:.0f}", result_ns));
+  print_bench_row("WS ACK p50/p99 (ns)", std::format("{} / {}", ack_latency.percentile(50.0), ack_latency.percentile(99.0)));
+  print_bench_row("WS RESULT p50/p99 (ns)", std::format("{} / {}", result_latency.percentile(50.0), result_latency.percentile(99.0)));
+  print_bench_row("WS FULL p50/p99 (ns)", std::format("{} / {}", full_latency.percentile(50.0), full_latency.percentile(99.0)));
+  print_bench_row("Check", (check && (0 == errors) && (0 < sum)) ? "OK" : "MISMATCH");
+}
+
+void bench_order_types() {
+  print_bench_header("Order types and timeInForce (params, FIX, IOC vs GTC + cancel)");
+  const uint64_t n_orders{3000};
+  const Auth auth{"bench-api-key", "bench-secret"};
+  const dec::decimal<8> price{"0.02700000"};
+  const dec::decimal<8> qty{"423.00000000"};
+  const dec::decimal<8> stop{"0.02600000"};
+  auto query = [](const Order &order) {
+    urlparams params;
+    order_params(order, [&params](const char *key, std::string_view value) { params.add(key, value); });
+    return params.url_params;
+  };
+  // Параметры запроса по типу ордера
+  vector<pair<Order, string>> expected{
+    {limit_order("VETUSDT", Side::BUY, price, qty), "symbol=VETUSDT&side=BUY&type=LIMIT&timeInForce=GTC&quantity=423.00000000&price=0.02700000"},
+    {limit_order<TimeInForce::IOC>("VETUSDT", Side::BUY, price, qty), "symbol=VETUSDT&side=BUY&type=LIMIT&timeInForce=IOC&quantity=423.00000000&price=0.02700000"},
+    {limit_order<TimeInForce::FOK>("VETUSDT", Side::SELL, price, qty), "symbol=VETUSDT&side=SELL&type=LIMIT&timeInForce=FOK&quantity=423.00000000&price=0.02700000"},
+    {limit_maker_order("VETUSDT", Side::BUY, price, qty), "symbol=VETUSDT&side=BUY&type=LIMIT_MAKER&quantity=423.00000000&price=0.02700000"},
+    {market_order("VETUSDT", Side::SELL, qty), "symbol=VETUSDT&side=SELL&type=MARKET&quantity=423.00000000"},
+    {market_quote_order("VETUSDT", Side::BUY, dec::decimal<8>("10.00000000")), "symbol=VETUSDT&side=BUY&type=MARKET&quoteOrderQty=10.00000000"},
+    {stop_loss_limit_order("VETUSDT", Side::SELL, price, qty, stop),
+     "symbol=VETUSDT&side=SELL&type=STOP_LOSS_LIMIT&timeInForce=GTC&quantity=423.00000000&price=0.02700000&stopPrice=0.02600000"},
+    {take_profit_limit_order<TimeInForce::IOC>("VETUSDT", Side::BUY, price, qty, stop),
+     "symbol=VETUSDT&side=BUY&type=TAKE_PROFIT_LIMIT&timeInForce=IOC&quantity=423.00000000&price=0.02700000&stopPrice=0.02600000"}};
+  bool check{true};
+  for (auto &[order, params] : expected) {
+    check = check && (query(order) == params);
+  }
+  // FIX: тип, TimeInForce и стоп-цена переживают кодирование и разбор
+  FixWriter writer{};
+  FixMessage message{};
+  FixExecutionReport report{};
+  for (auto &[order, params] : expected) {
+    writer.begin(FixMsgType::EXECUTION_REPORT, "SPOT", "BNCPP", 1, "20231114-22:13:20.000000");
+    encode_new_order(writer, order, "bench-1");
+    string data{writer.finish()};
+    check = check && message.parse(data) && decode_execution_report(message, report) && (order.type == report.order.type) &&
+            (!order_type_has_time_in_force(order.type) || (order.timeInForce == report.order.timeInForce)) &&
+            (order.stopPrice == report.order.stopPrice);
+  }
+  auto params_start = bench_clock::now();
+  size_t params_size{0};
+  for (uint64_t i = 0; i < n_orders * 10; i++) {
+    params_size += query(expected[i % expected.size()].first).size();
+  }
+  double params_ns = chrono::duration<double, nano>(bench_clock::now() - params_start).count() / (n_orders * 10);
+  // WebSocket API: IOC (один запрос, остаток истекает на бирже) против GTC + отмена
+  WsStandIn stand_in{};
+  thread ws_server([&]() {
+    unique_ptr<WebSocket> ws{stand_in.accept_client()};
+    if (!ws) {
+      return;
+    }
+    uint64_t order_id{0};
+    while (0 <= ws->poll([&](WsOpcode, string_view message) {
+      string_view id{};
+      string_view method{};
+      JsonScanner::find(message, "id", id);
+      JsonScanner::find(message, "method", method);
+      string result{order_result(++order_id)};
+      if (string_view::npos != message.find("\"timeInForce\":\"IOC\"")) {
+        result.replace(result.find("\"status\":\"NEW\""), 14, "\"status\":\"EXPIRED\"");
+      }
+      else if ("order.cancel" == method) {
+        result.replace(result.find("\"status\":\"NEW\""), 14, "\"status\":\"CANCELED\"");
+      }
+      ws->send_text(std::format("{{\"id\":{},\"status\":200,\"result\":{},\"rateLimits\":[]}}", id, result));
+    }, 1000)) {}
+  });
+  OrderSessionConfig config{"127.0.0.1", stand_in.port(), "/ws-api/v3", false};
+  config.order_limit = std::numeric_limits<uint32_t>::max(); // Замер задержки, а не лимита ORDERS
+  OrderSession session{auth, Ed25519Signer::generate_pem(), config};
+  Status status = session.connect();
+  if (0 != status.code) {
+    print_bench_row("Connect failed", status.msg);
+    ws_server.join();
+    return;
+  }
+  LatencyHistogram ioc_latency{};
+  LatencyHistogram cancel_latency{};
+  uint64_t errors{0};
+  for (uint64_t i = 0; i < n_orders; i++) {
+    try {
+      Order ioc{limit_order<TimeInForce::IOC>("VETUSDT", Side::BUY, price, qty)};
+      uint64_t start = now_ns();
+      Order done{session.create_order(ioc)};
+      ioc_latency.add(now_ns() - start);
+      check = check && (OrderStatus::EXPIRED == done.status);
+      Order gtc{limit_order("VETUSDT", Side::BUY, price, qty)};
+      start = now_ns();
+      Order placed{session.create_order(gtc)};
+      Order canceled{session.cancel_order(placed.symbol, placed.orderId)};
+      cancel_latency.add(now_ns() - start);
+      check = check && (OrderStatus::CANCELED == canceled.status);
+    }
+    catch (BinanceException &) {
+      errors++;
+    }
+  }
+  session.close();
+  ws_server.join();
+  print_bench_row("order_params (ns)", std::format("{:.0f}", params_ns));
+  print_bench_row("IOC p50/p99 (ns)", std::format("{} / {}", ioc_latency.percentile(50.0), ioc_latency.percentile(99.0)));
+  print_bench_row("GTC + cancel p50/p99 (ns)", std::format("{} / {}", cancel_latency.percentile(50.0), cancel_latency.percentile(99.0)));
+  print_bench_row("Check", (check && (0 == errors) && (0 < params_size)) ? "OK" : "MISMATCH");
+}
+
+/// @brief Путь Binance::test_order поверх заглушки (подпись HMAC, POST /api/v3/order/test)
+void rest_test_order(Request &request, const Auth &auth, const Order &order) {
+  headerparams header{BaseHeader()};
+  header.add("X-MBX-APIKEY", auth.api_key);
+  urlparams params;
+  order_params(order, [&params](const char *key, std::string_view value) { params.add(key, value); });
+  params.add("newOrderRespType", std::string{"RESULT"});
+  params.add("recvWindow", 5000);
+  params.add("timestamp", current_ms_epoch());
+  params.add("signature", hmac_sha256(auth.user_key.c_str(), params.url_params.c_str()));
+  RequestResult r_result = request.request(RequestType::POST, "/api/v3/order/test", header, params);
+  if ((0 != r_result.transport.code) || (200 != r_result.header.code) || !json::parse(r_result.body).is_object()) {
+    throw BinanceException{ExceptionType::Transport, r_result.transport.code, r_result.transport.msg};
+  }
+}
+
+void bench_order_warmup() {
+  print_bench_header("Order warmup (/api/v3/order/test, keep-alive REST stand-in)");
+  const uint64_t n_orders{300};
+  const uint64_t n_bursts{20};
+  const chrono::milliseconds idle{50};
+  const Auth auth{"bench-api-key", "bench-secret"};
+  atomic<uint64_t> order_id{0};
+  auto handler = [&order_id](string_view request_line) -> string {
+    return request_line.starts_with("POST /api/v3/order/test ") ? string{"{}"} : order_result(++order_id);
+  };
+  auto timed_order = [&auth](Request &request) {
+    Order order{bench_order};
+    uint64_t start = now_ns();
+    rest_create_order(request, auth, order);
+    return now_ns() - start;
+  };
+  uint64_t errors{0};
+  uint64_t cold_ns{0};
+  LatencyHistogram steady{};
+  LatencyHistogram idle_first{};
+  LatencyHistogram warm_first{};
+  uint64_t connections{0};
+  WarmupStats warmup_stats{};
+  try {
+    RestStandIn stand_in{handler};
+    Request request{"http://127.0.0.1", stand_in.port()};
+    // Первый ордер открывает соединение, далее - установившийся режим
+    cold_ns = timed_order(request);
+    for (uint64_t i = 0; i < n_orders; i++) {
+      steady.add(timed_order(request));
+    }
+    // Первый ордер всплеска после простоя: без прогрева и с test_order по таймеру
+    for (uint64_t i = 0; i < n_bursts; i++) {
+      this_thread::sleep_for(idle);
+      idle_first.add(timed_order(request));
+    }
+    OrderWarmup warmup{[&]() { rest_test_order(request, auth, bench_order); }, WarmupConfig{chrono::milliseconds{5}}};
+    warmup.start();
+    for (uint64_t i = 0; i < n_bursts; i++) {
+      this_thread::sleep_for(idle);
+      warm_first.add(timed_order(request));
+    }
+    warmup.stop();
+    warmup_stats = warmup.stats();
+    connections = stand_in.accepted;
+  }
+  catch (BinanceException &) {
+    errors++;
+  }
+  print_bench_row("Cold first order (ns)", std::format("{}", cold_ns));
+  print_bench_row("Steady p50/p99 (ns)", std::format("{} / {}", steady.percentile(50.0), steady.percentile(99.0)));
+  print_bench_row("After idle p50/p99 (ns)", std::format("{} / {}", idle_first.percentile(50.0), idle_first.percentile(99.0)));
+  print_bench_row("After idle + warmup p50/p99", std::format("{} / {}", warm_first.percentile(50.0), warm_first.percentile(99.0)));
+  print_bench_row("Warmup runs / errors", std::format("{} / {}", warmup_stats.runs, warmup_stats.errors));
+  print_bench_row("Connections", std::format("{}", connections));
+  print_bench_row("Check", ((0 == errors) && (0 == warmup_stats.errors) && (0 < warmup_stats.runs)) ? "OK" : "MISMATCH");
+}
+
+/// @brief Транспорт к локальной заглушке: тот же Request (libcurl), что и у RestTransport
+struct StandInTransport {
+  int port{0};
+
+  RequestResult request(RequestType r_type, const std::string &path, const headerparams &h_params, const urlparams &u_params) {
+    Request request{"http://127.0.0.1", port};
+    return request.request(r_type, path, h_params, u_params);
+  }
+};
+
+/// @brief Часы без хода времени: постоянный timestamp, окно лимита не сменяется во время замера
+struct FixedClock {
+  uint64_t now_ms() const {
+    return 1700000000000;
+  }
+};
+
+void bench_order_ladder() {
+  print_bench_header(std::format("Order ladder ({} orders, RTT 1 ms, serial vs concurrent)", order_burst_limit));
+  const size_t n_orders{order_burst_limit};
+  const size_t n_parallel{8};
+  const Auth auth{"bench-api-key", "bench-secret"};
+  vector<Order> ladder{};
+  for (size_t i = 0; i < n_orders; i++) {
+    Order order{bench_order};
+    order.price = bench_order.price - dec::decimal<8>(static_cast<int64_t>(i)) / 10000;
+    ladder.push_back(order);
+  }
+  atomic<uint64_t> order_id{0};
+  atomic<uint64_t> rest_errors{0};
+  auto elapsed_ms = [](bench_clock::time_point start) {
+    return chrono::duration<double, milli>(bench_clock::now() - start).count();
+  };
+  // REST: задержка ответа fake_rtt на каждый запрос, поток на соединение
+  RestStandIn stand_in{[&order_id](string_view) -> string {
+    this_thread::sleep_for(fake_rtt);
+    return order_result(++order_id);
+  }};
+  auto rest_order = [&](size_t i) {
+    try {
+      Request order_request{"http://127.0.0.1", stand_in.port()};
+      rest_create_order(order_request, auth, ladder[i]);
+    }
+    catch (BinanceException &) {
+      rest_errors++;
+    }
+  };
+  // Прогрев соединений, чтобы сравнивать только запросы
+  parallel_for(n_parallel, n_parallel, rest_order);
+  auto serial_start = bench_clock::now();
+  for (size_t i = 0; i < n_orders; i++) {
+    rest_order(i);
+  }
+  double serial_ms = elapsed_ms(serial_start);
+  auto parallel_start = bench_clock::now();
+  parallel_for(n_orders, n_parallel, rest_order);
+  double parallel_ms = elapsed_ms(parallel_start);
+  uint64_t connections = stand_in.accepted;
+  // Binance::create_orders: потоки пула клиента; второй пакет за 10 секунд превышает бюджет ORDERS и не отправляется
+  BasicBinance<StandInTransport, HmacSigner, FixedClock> client{auth, StandInTransport{stand_in.port()}};
+  uint64_t client_errors{0};
+  auto client_start = bench_clock::now();
+  for (auto &result : client.create_orders(ladder, n_parallel)) {
+    client_errors += result.has_value() ? 0 : 1;
+  }
+  double client_ms = elapsed_ms(client_start);
+  uint64_t client_sent = order_id;
+  size_t client_rejected{0};
+  for (auto &result : client.create_orders(ladder, n_parallel)) {
+    client_rejected += (!result.has_value() && (-1015 == result.error().code)) ? 1 : 0;
+  }
+  bool client_ok = (0 == client_errors) && (n_orders == client.orders_used()) && (n_orders == client_rejected) && (client_sent == order_id);
+  // WebSocket API: ответ уходит через fake_rtt после запроса, без блокировки следующих запросов
+  WsStandIn ws_stand_in{};
+  thread ws_server([&]() {
+    unique_ptr<WebSocket> ws{ws_stand_in.accept_client()};
+    if (!ws) {
+      return;
+    }
+    deque<pair<bench_clock::time_point, string>> replies{};
+    int polled{0};
+    while (0 <= polled) {
+      polled = ws->poll([&](WsOpcode, string_view message) {
+        string_view id{};
+        JsonScanner::find(message, "id", id);
+        replies.emplace_back(bench_clock::now() + fake_rtt,
+                             std::format("{{\"id\":{},\"status\":200,\"result\":{},\"rateLimits\":[]}}", id, order_result(++order_id)));
+      }, replies.empty() ? 100 : 0);
+      while (!replies.empty() && (replies.front().first <= bench_clock::now())) {
+        ws->send_text(replies.front().second);
+        replies.pop_front();
+      }
+    }
+  });
+  OrderSessionConfig config{"127.0.0.1", ws_stand_in.port(), "/ws-api/v3", false};
+  config.order_limit = 2 * n_orders;
+  OrderSession session{auth, Ed25519Signer::generate_pem(), config};
+  uint64_t ws_errors{0};
+  size_t ws_rejected{0};
+  uint64_t ws_sent{0};
+  double ws_serial_ms{0.0};
+  double ws_pipelined_ms{0.0};
+  if (0 == session.connect().code) {
+    auto ws_serial_start = bench_clock::now();
+    for (auto &order : ladder) {
+      try {
+        session.create_order(order);
+      }
+      catch (BinanceException &) {
+        ws_errors++;
+      }
+    }
+    ws_serial_ms = elapsed_ms(ws_serial_start);
+    auto ws_pipelined_start = bench_clock::now();
+    for (auto &result : session.create_orders(ladder)) {
+      ws_errors += result.has_value() ? 0 : 1;
+    }
+    ws_pipelined_ms = elapsed_ms(ws_pipelined_start);
+    ws_sent = session.stats().requests;
+    for (auto &result : session.create_orders(ladder)) {
+      ws_rejected += (!result.has_value() && (-1015 == result.error().code)) ? 1 : 0;
+    }
+    ws_sent = session.stats().requests - ws_sent;
+    session.close();
+  }
+  else {
+    ws_errors++;
+  }
+  ws_server.join();
+  print_bench_row("REST serial (ms)", std::format("{:.1f}", serial_ms));
+  print_bench_row(std::format("REST {} in flight (ms)", n_parallel), std::format("{:.1f}", parallel_ms));
+  print_bench_row("REST connections", std::format("{}", connections));
+  print_bench_row("Binance::create_orders (ms)", std::format("{:.1f}", client_ms));
+  print_bench_row("WS API serial (ms)", std::format("{:.1f}", ws_serial_ms));
+  print_bench_row("WS API pipelined (ms)", std::format("{:.1f}", ws_pipelined_ms));
+  print_bench_row("Over ORDERS budget: REST / WS", std::format("{} / {} rejected", client_rejected, ws_rejected));
+  // Сессия считает окно по системному времени: при смене окна во время замера часть пакета уходит
+  bool budget_ok = client_ok && (0 < ws_rejected) && (n_orders == ws_rejected + ws_sent);
+  print_bench_row("Check", ((0 == rest_errors) && (0 == ws_errors) && (parallel_ms < serial_ms) && budget_ok) ? "OK" : "MISMATCH");
+}
+
+/// @brief Прежний разбор ошибки: json DOM, исключение BinanceException и перехват json::parse_error
+void throwing_check_error(const RequestResult &r_result) {
+  if (200 != r_result.header.code) {
+    try {
+      json js = json::parse(r_result.body);
+      if (js.contains("code") && (js.contains("msg"))) {
+        throw BinanceException{ExceptionType::Binance, js["code"], js["msg"]};
+      }
+      throw BinanceException{ExceptionType::Server, r_result.header.code, r_result.header.msg};
+    }
+    catch (json::parse_error &) {
+      throw BinanceException{ExceptionType::Transport, r_result.header.code, r_result.header.msg};
+    }
+  }
+}
+
+void bench_error_path() {
+  print_bench_header("Reject path (-2010 LIMIT_MAKER reject, exception vs expected)");
+  const uint64_t n_rejects{200000};
+  const size_t n_threads{4};
+  RequestResult reject{};
+  reject.transport = Status(0, "No error");
+  reject.header = Status(400, "Bad Request");
+  reject.content_type = "application/json;charset=UTF-8";
+  reject.body = "{\"code\":-2010,\"msg\":\"Order would immediately match and take.\"}";
+  auto throwing = [&reject]() {
+    try {
+      throwing_check_error(reject);
+    }
+    catch (BinanceException &e) {
+      return e.e_code;
+    }
+    return 0;
+  };
+  auto expected = [&reject]() {
+    return response_error(reject).code;
+  };
+  auto measure = [&](auto &&reject_path, LatencyHistogram &latency) {
+    int64_t sum{0};
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < n_rejects; i++) {
+      uint64_t t = now_ns();
+      sum += reject_path();
+      latency.add(now_ns() - t);
+    }
+    return std::make_pair(static_cast<double>(now_ns() - start) / n_rejects, sum);
+  };
+  auto threaded = [&](auto &&reject_path) {
+    auto mt_start = bench_clock::now();
+    vector<thread> threads{};
+    for (size_t t = 0; t < n_threads; t++) {
+      threads.emplace_back([&]() {
+        for (uint64_t i = 0; i < n_rejects / n_threads; i++) {
+          reject_path();
+        }
+      });
+    }
+    for (auto &th : threads) {
+      th.join();
+    }
+    return (n_rejects / n_threads * n_threads) / chrono::duration<double>(bench_clock::now() - mt_start).count();
+  };
+  LatencyHistogram throwing_latency{};
+  LatencyHistogram expected_latency{};
+  auto [throwing_ns, throwing_sum] = measure(throwing, throwing_latency);
+  auto [expected_ns, expected_sum] = measure(expected, expected_latency);
+  double throwing_mt = threaded(throwing);
+  double expected_mt = threaded(expected);
+  BinanceError error{response_error(reject)};
+  // Текст вне таблицы не запоминается: -1021 с разницей времени -> общий текст по коду
+  BinanceError drift{make_error(ExceptionType::Binance, -1021, "Timestamp for this request was 1000ms ahead of the server's time.")};
+  BinanceError unknown{make_error(ExceptionType::Binance, -9999, "Some new error text")};
+  print_bench_row("json DOM + throw (ns)", std::format("{:.0f}", throwing_ns));
+  print_bench_row("expected (ns)", std::format("{:.0f}", expected_ns));
+  print_bench_row("json DOM + throw p50/p99 (ns)", std::format("{} / {}", throwing_latency.percentile(50.0), throwing_latency.percentile(99.0)));
+  print_bench_row("expected p50/p99 (ns)", std::format("{} / {}", expected_latency.percentile(50.0), expected_latency.percentile(99.0)));
+  print_bench_row(std::format("throw {} threads rejects/sec", n_threads), std::format("{:.0f}", throwing_mt));
+  print_bench_row(std::format("expected {} threads rejects/sec", n_threads), std::format("{:.0f}", expected_mt));
+  bool ok = (throwing_sum == expected_sum) && (ErrorMessage::WOULD_MATCH == error.message) && (ExceptionType::Binance == error.type)
+            && (error.exception().e_msg == "Order would immediately match and take.") && (sizeof(BinanceError) <= 12)
+            && (ErrorMessage::OUTSIDE_RECV_WINDOW == drift.message) && (ErrorMessage::BINANCE_ERROR == unknown.message)
+            && (-9999 == unknown.code);
+  print_bench_row("Check", ok ? "OK" : "MISMATCH");
+}
+
+/// @brief Прежнее преобразование: std::map строится на каждый вызов
+OrderStatus map_str_to_order_status(std::string status) {
+  std::map<std::string, OrderStatus> status_m {
+    {std::string{"NONE"}, OrderStatus::NONE},
+    {std::string{"NEW"}, OrderStatus::NEW},
+    {std::string{"FILLED"}, OrderStatus::FILLED},
+    {std::string{"CANCELED"}, OrderStatus::CANCELED},
+    {std::string{"PARTIALLY_FILLED"}, OrderStatus::PARTIALLY_FILLED},
+    {std::string{"REJECTED"}, OrderStatus::REJECTED},
+    {std::string{"EXPIRED"}, OrderStatus::EXPIRED},
+    {std::string{"PENDING_NEW"}, OrderStatus::PENDING_NEW},
+    {std::string{"PENDING_CANCEL"}, OrderStatus::PENDING_CANCEL},
+    {std::string{"EXPIRED_IN_MATCH"}, OrderStatus::EXPIRED_IN_MATCH}
+  };
+  if (status_m.find(status) != status_m.end()) {
+    return status_m[status];
+  }
+  return OrderStatus::NONE;
+}
+
+std::string map_order_status_to_str(OrderStatus status) {
+  std::map<OrderStatus, std::string> status_m {
+    {OrderStatus::NONE, std::string{"NONE"}},
+    {OrderStatus::NEW, std::string{"NEW"}},
+    {OrderStatus::FILLED, std::string{"FILLED"}},
+    {OrderStatus::CANCELED, std::string{"CANCELED"}},
+    {OrderStatus::PARTIALLY_FILLED, std::string{"PARTIALLY_FILLED"}},
+    {OrderStatus::REJECTED, std::string{"REJECTED"}},
+    {OrderStatus::EXPIRED, std::string{"EXPIRED"}},
+    {OrderStatus::PENDING_NEW, std::string{"PENDING_NEW"}},
+    {OrderStatus::PENDING_CANCEL, std::string{"PENDING_CANCEL"}},
+    {OrderStatus::EXPIRED_IN_MATCH, std::string{"EXPIRED_IN_MATCH"}}
+  };
+  if (status_m.find(status) != status_m.end()) {
+    return status_m[status];
+  }
+  return std::string{"NONE"};
+}
+
+// Таблицы строятся при компиляции: преобразования доступны в constant expression
+static_assert(OrderStatus::EXPIRED_IN_MATCH == str_to_order_status("EXPIRED_IN_MATCH"));
+static_assert(OrderStatus::NONE == str_to_order_status("EXPIRED_IN_MATCH_"));
+static_assert("TAKE_PROFIT_LIMIT" == order_type_to_str(OrderType::TAKE_PROFIT_LIMIT));
+static_assert("NONE" == order_type_to_str(OrderType::NONE));
+static_assert(Side::SELL == str_to_side("SELL"));
+static_assert(TimeInForce::NONE == str_to_time_in_force(""));
+static_assert("RESULT" == order_resp_type_to_str(OrderRespType::NONE));
+
+void bench_enum_tables() {
+  print_bench_header("Enum <-> string (std::map per call vs constexpr tables)");
+  const uint64_t n_iterations{200000};
+  vector<string> names{};
+  for (int i = 0; i <= static_cast<int>(OrderStatus::EXPIRED_IN_MATCH); i++) {
+    names.emplace_back(order_status_to_str(static_cast<OrderStatus>(i)));
+  }
+  names.emplace_back("UNKNOWN");
+  auto per_call_ns = [&](auto &&convert) {
+    uint64_t sum{0};
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < n_iterations; i++) {
+      sum += convert(names[i % names.size()]);
+    }
+    return std::make_pair(static_cast<double>(now_ns() - start) / n_iterations, sum);
+  };
+  auto [map_from_ns, map_from_sum] = per_call_ns([](const string &name) { return static_cast<uint64_t>(map_str_to_order_status(name)); });
+  auto [table_from_ns, table_from_sum] = per_call_ns([](const string &name) { return static_cast<uint64_t>(str_to_order_status(name)); });
+  auto [map_to_ns, map_to_sum] = per_call_ns([](const string &name) { return map_order_status_to_str(map_str_to_order_status(name)).size(); });
+  auto [table_to_ns, table_to_sum] = per_call_ns([](const string &name) { return order_status_to_str(str_to_order_status(name)).size(); });
+  // Полный обход: каждое имя переводится в значение и обратно
+  bool round_trip{true};
+  for (const string &name : names) {
+    round_trip = round_trip && (map_str_to_order_status(name) == str_to_order_status(name))
+                 && (map_order_status_to_str(str_to_order_status(name)) == order_status_to_str(str_to_order_status(name)));
+  }
+  for (int i = 0; i <= static_cast<int>(OrderType::TAKE_PROFIT_LIMIT); i++) {
+    OrderType type = static_cast<OrderType>(i);
+    round_trip = round_trip && ((OrderType::NONE == type) || (type == str_to_order_type(order_type_to_str(type))));
+  }
+  print_bench_row("std::map str -> enum (ns)", std::format("{:.1f}", map_from_ns));
+  print_bench_row("table str -> enum (ns)", std::format("{:.1f}", table_from_ns));
+  print_bench_row("std::map round trip (ns)", std::format("{:.1f}", map_to_ns));
+  print_bench_row("table round trip (ns)", std::format("{:.1f}", table_to_ns));
+  print_bench_row("Check", (round_trip && (map_from_sum == table_from_sum) && (map_to_sum == table_to_sum)) ? "OK" : "MISMATCH");
+}
+
+// Таблица эндпоинтов проверяется при компиляции
+static_assert(endpoint::QueryOrder::info.path == "/api/v3/order");
+static_assert(EndpointAuth::SIGNED == endpoint::Account::info.auth);
+static_assert(!endpoint::NewOrderFull::info.sbe, "fills only in JSON");
+static_assert(RequestType::DELETE == endpoint::CancelOpenOrders::info.method);
+
+/// @brief Прежний разбор ордера вручную: проверка ошибки, JSON DOM, json_to_order
+BinanceResult<Order> hand_decode_order(const RequestResult &r_result) {
+  BinanceError error{response_error(r_result)};
+  if (ExceptionType::None != error.type) {
+    return std::unexpected(error);
+  }
+  json js = json::parse(r_result.body, nullptr, false);
+  if (!js.is_object()) {
+    return std::unexpected(BinanceError{ExceptionType::Server, r_result.header.code, ErrorMessage::INVALID_RESPONSE});
+  }
+  return json_to_order(js);
+}
+
+void bench_endpoint_dispatch() {
+  print_bench_header("Endpoint dispatch (hand-written decode vs call<Endpoint> bookkeeping + decode)");
+  const uint64_t n_calls{100000};
+  RequestResult response{};
+  response.transport = Status(0, "No error");
+  response.header = Status(200, "OK");
+  response.content_type = "application/json;charset=UTF-8";
+  response.body = "{\"symbol\":\"BTCUSDT\",\"orderId\":28,\"clientOrderId\":\"6gCrw2kRUAF9CvJDGP16IP\",\"price\":\"64000.00000000\","
+                  "\"origQty\":\"0.00100000\",\"executedQty\":\"0.00000000\",\"status\":\"NEW\",\"timeInForce\":\"GTC\","
+                  "\"type\":\"LIMIT\",\"side\":\"BUY\",\"time\":1507725176595}";
+  WeightBudget budget{request_weight_limit};
+  EndpointCounters counters{};
+  // Тот же учет, что в Binance::call<E>, без транспорта
+  auto dispatched = [&]() -> BinanceResult<Order> {
+    if (!budget.acquire(endpoint::QueryOrder::info.weight, current_ms_epoch())) {
+      return std::unexpected(BinanceError{ExceptionType::Filter, -1003, ErrorMessage::WEIGHT_BUDGET});
+    }
+    uint64_t t = now_ns();
+    BinanceResult<Order> result{endpoint::QueryOrder::decode(response)};
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.weight.fetch_add(endpoint::QueryOrder::info.weight, std::memory_order_relaxed);
+    if (!result.has_value()) {
+      counters.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+    counters.latency.add(now_ns() - t);
+    return result;
+  };
+  auto per_call_ns = [&](auto &&path) {
+    uint64_t sum{0};
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < n_calls; i++) {
+      BinanceResult<Order> order{path()};
+      sum += order.has_value() ? order->orderId : 0;
+    }
+    return std::make_pair(static_cast<double>(now_ns() - start) / n_calls, sum);
+  };
+  budget.limit(std::numeric_limits<uint64_t>::max() / 2);
+  auto [hand_ns, hand_sum] = per_call_ns([&]() { return hand_decode_order(response); });
+  auto [call_ns, call_sum] = per_call_ns(dispatched);
+  // Бюджет исчерпан: запрос отклоняется до транспорта
+  Binance binance{Auth{"bench-api-key", "bench-secret"}};
+  binance.weight_limit(0);
+  uint64_t start = now_ns();
+  uint64_t n_rejected{0};
+  for (uint64_t i = 0; i < n_calls; i++) {
+    BinanceResult<bool> ping{binance.call<endpoint::Ping>()};
+    n_rejected += (!ping.has_value() && (-1003 == ping.error().code)) ? 1 : 0;
+  }
+  double rejected_ns = static_cast<double>(now_ns() - start) / n_calls;
+  EndpointStats stats{binance.endpoint_stats(EndpointId::PING)};
+  // Смена минуты обнуляет занятый вес
+  WeightBudget window{10};
+  bool window_ok = window.acquire(10, 60000) && !window.acquire(1, 60001) && window.acquire(10, 120000) && (10 == window.weight_used());
+  // Потоки на границах минут: вес не теряется при смене окна и не уходит в переполнение при отказе
+  WeightBudget shared_budget{1000};
+  std::atomic<uint64_t> granted{0};
+  vector<thread> racers{};
+  for (size_t t = 0; t < 8; t++) {
+    racers.emplace_back([&]() {
+      for (uint64_t i = 0; i < 2000; i++) {
+        granted += shared_budget.acquire(1, 60000 * (1 + i / 500)) ? 1 : 0;
+      }
+    });
+  }
+  for (auto &th : racers) {
+    th.join();
+  }
+  bool race_ok = (granted <= 4000) && (granted >= 1000) && (1000 == shared_budget.weight_used());
+  print_bench_row("hand-written decode (ns)", std::format("{:.0f}", hand_ns));
+  print_bench_row("call<QueryOrder> decode (ns)", std::format("{:.0f}", call_ns));
+  print_bench_row("budget reject, no request (ns)", std::format("{:.0f}", rejected_ns));
+  print_bench_row("Endpoints in table", std::format("{}", endpoint_count));
+  bool ok = (hand_sum == call_sum) && (28 * n_calls == call_sum) && (n_calls == counters.calls) && (0 == counters.errors)
+            && (n_calls == n_rejected) && (n_calls == stats.rejected) && (0 == stats.calls) && window_ok && race_ok;
+  print_bench_row("Check", ok ? "OK" : "MISMATCH");
+}
+
+/// @brief Транспорт без сети: готовый ответ, запрос запоминается для проверки
+struct NullTransport {
+  const RequestResult *response{nullptr};
+  std::atomic<uint64_t> *calls{nullptr};
+  std::string *last_query{nullptr};
+
+  RequestResult request(RequestType, const std::string &, const headerparams &, const urlparams &u_params) {
+    calls->fetch_add(1, std::memory_order_relaxed);
+    *last_query = u_params.url_params;
+    return *response;
+  }
+};
+
+/// @brief Тот же транспорт через виртуальный интерфейс (для сравнения с прямым вызовом политики)
+struct VirtualBackend {
+  virtual ~VirtualBackend() = default;
+  virtual RequestResult request(RequestType r_type, const std::string &path, const headerparams &h_params, const urlparams &u_params) = 0;
+};
+
+struct NullBackend : VirtualBackend {
+  NullTransport transport{};
+  RequestResult request(RequestType r_type, const std::string &path, const headerparams &h_params, const urlparams &u_params) override {
+    return transport.request(r_type, path, h_params, u_params);
+  }
+};
+
+struct VirtualTransport {
+  VirtualBackend *backend{nullptr};
+  RequestResult request(RequestType r_type, const std::string &path, const headerparams &h_params, const urlparams &u_params) {
+    return backend->request(r_type, path, h_params, u_params);
+  }
+};
+
+struct NullSigner {
+  std::string sign(const std::string &, const std::string &) const {
+    return std::string{"0"};
+  }
+};
+
+void bench_client_overhead() {
+  print_bench_header("Client layer CPU per call (null transport, order_info)");
+  const uint64_t n_calls{100000};
+  RequestResult response{};
+  response.transport = Status(0, "No error");
+  response.header = Status(200, "OK");
+  response.content_type = "application/json;charset=UTF-8";
+  response.body = "{\"symbol\":\"BTCUSDT\",\"orderId\":28,\"clientOrderId\":\"6gCrw2kRUAF9CvJDGP16IP\",\"price\":\"64000.00000000\","
+                  "\"origQty\":\"0.00100000\",\"executedQty\":\"0.00000000\",\"status\":\"NEW\",\"timeInForce\":\"GTC\","
+                  "\"type\":\"LIMIT\",\"side\":\"BUY\",\"time\":1507725176595}";
+  std::atomic<uint64_t> calls{0};
+  std::string last_query{};
+  NullTransport null_transport{&response, &calls, &last_query};
+  Auth auth{"bench-api-key", "bench-secret"};
+  auto per_call_ns = [&](auto &&path) {
+    uint64_t sum{0};
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < n_calls; i++) {
+      BinanceResult<Order> order{path()};
+      sum += order.has_value() ? order->orderId : 0;
+    }
+    return std::make_pair(static_cast<double>(now_ns() - start) / n_calls, sum);
+  };
+  auto [decode_ns, decode_sum] = per_call_ns([&]() { return endpoint::QueryOrder::decode(response); });
+  BasicBinance<NullTransport> client{auth, null_transport};
+  client.weight_limit(std::numeric_limits<uint64_t>::max() / 2);
+  auto [client_ns, client_sum] = per_call_ns([&]() { return client.try_order_info("BTCUSDT", 28); });
+  NullBackend backend{};
+  backend.transport = null_transport;
+  BasicBinance<VirtualTransport> virtual_client{auth, VirtualTransport{&backend}};
+  virtual_client.weight_limit(std::numeric_limits<uint64_t>::max() / 2);
+  auto [virtual_ns, virtual_sum] = per_call_ns([&]() { return virtual_client.try_order_info("BTCUSDT", 28); });
+  BasicBinance<NullTransport, NullSigner, FixedClock> bare_client{auth, null_transport};
+  bare_client.weight_limit(std::numeric_limits<uint64_t>::max() / 2);
+  auto [bare_ns, bare_sum] = per_call_ns([&]() { return bare_client.try_order_info("BTCUSDT", 28); });
+  bool fixed_timestamp = last_query.contains("timestamp=1700000000000") && last_query.ends_with("signature=0");
+  print_bench_row("decode only (ns)", std::format("{:.0f}", decode_ns));
+  print_bench_row("client, inline policy (ns)", std::format("{:.0f}", client_ns));
+  print_bench_row("client, virtual transport (ns)", std::format("{:.0f}", virtual_ns));
+  print_bench_row("client, no HMAC (ns)", std::format("{:.0f}", bare_ns));
+  print_bench_row("client layer (ns)", std::format("{:.0f}", client_ns - decode_ns));
+  bool ok = (decode_sum == client_sum) && (client_sum == virtual_sum) && (virtual_sum == bare_sum) && (28 * n_calls == bare_sum)
+            && (3 * n_calls == calls) && fixed_timestamp && (n_calls == client.endpoint_stats(EndpointId::QUERY_ORDER).calls);
+  print_bench_row("Check", ok ? "OK" : "MISMATCH");
+}
+
+void bench_cached_error() {
+  print_bench_header("Cached endpoint reject (-1121 through TtlCache + SingleFlight, no exception)");
+  const uint64_t n_calls{100000};
+  RequestResult reject{};
+  reject.transport = Status(0, "No error");
+  reject.header = Status(400, "Bad Request");
+  reject.content_type = "application/json;charset=UTF-8";
+  reject.body = "{\"code\":-1121,\"msg\":\"Invalid symbol.\"}";
+  std::atomic<uint64_t> calls{0};
+  std::string last_query{};
+  BasicBinance<NullTransport> client{Auth{"bench-api-key", "bench-secret"}, NullTransport{&reject, &calls, &last_query}};
+  client.weight_limit(std::numeric_limits<uint64_t>::max() / 2);
+  client.cache_policy("/api/v3/ticker/price", CachePolicy{chrono::milliseconds(60000), chrono::milliseconds(60000)});
+  uint64_t n_errors{0};
+  uint64_t start = now_ns();
+  for (uint64_t i = 0; i < n_calls; i++) {
+    BinanceResult<dec::decimal<8>> price{client.try_symbol_price("NOSUCHPAIR")};
+    n_errors += (!price.has_value() && (-1121 == price.error().code)) ? 1 : 0;
+  }
+  double reject_ns = static_cast<double>(now_ns() - start) / n_calls;
+  // Ошибка не кешируется: каждый вызов обращается к серверу
+  CacheStats st{client.cache_stats("/api/v3/ticker/price")};
+  bool thrown{false};
+  try {
+    client.symbol_price("NOSUCHPAIR");
+  }
+  catch (BinanceException &e) {
+    thrown = (-1121 == e.e_code);
+  }
+  const vector<string> symbols{"NOSUCHPAIR", "NOSUCHPAIR2"};
+  vector<CancelAllResult> canceled{client.cancel_all(std::span<const string>{symbols})};
+  bool cancel_ok = (2 == canceled.size()) && (ExceptionType::Binance == canceled[0].error.type) && (-1121 == canceled[1].error.code)
+                   && (canceled[0].error.msg() == "Invalid symbol.");
+  print_bench_row("try_symbol_price reject (ns)", std::format("{:.0f}", reject_ns));
+  print_bench_row("Requests / cache hits", std::format("{} / {}", calls.load(), st.hits + st.stale_hits));
+  bool ok = (n_calls == n_errors) && (n_calls + 3 == calls) && (0 == st.hits + st.stale_hits) && (n_calls == st.misses) && thrown && cancel_ok;
+  print_bench_row("Check", ok ? "OK" : "MISMATCH");
+}
+
+void bench_shared_client() {
+  print_bench_header("Shared client throughput (one Binance, N strategy threads)");
+  const uint64_t n_requests{2000};
+  const chrono::microseconds fake_rtt{200};
+  const vector<size_t> thread_counts{1, 2, 4, 8};
+  std::atomic<uint64_t> order_id{0};
+  RestStandIn stand_in{[&order_id, fake_rtt](string_view) -> string {
+    this_thread::sleep_for(fake_rtt);
+    return order_result(++order_id);
+  }};
+  BasicBinance<StandInTransport> binance{Auth{"bench-api-key", "bench-secret"}, StandInTransport{stand_in.port()}};
+  binance.weight_limit(std::numeric_limits<uint64_t>::max() / 2);
+  std::atomic<uint64_t> errors{0};
+  auto run = [&](size_t n_threads) {
+    auto start = bench_clock::now();
+    vector<thread> threads{};
+    for (size_t t = 0; t < n_threads; t++) {
+      threads.emplace_back([&, t]() {
+        for (uint64_t i = t; i < n_requests; i += n_threads) {
+          BinanceResult<Order> order{binance.try_cancel_order("VETUSDT", i + 1)};
+          errors += order.has_value() ? 0 : 1;
+        }
+      });
+    }
+    for (auto &th : threads) {
+      th.join();
+    }
+    return n_requests / chrono::duration<double>(bench_clock::now() - start).count();
+  };
+  // Первые соединения и easy handle потоков
+  run(thread_counts.back());
+  vector<double> throughput{};
+  for (size_t n_threads : thread_counts) {
+    throughput.push_back(run(n_threads));
+    print_bench_row(std::format("{} threads req/sec", n_threads), std::format("{:.0f}", throughput.back()));
+  }
+  // Подпись из многих потоков: прежний hmac_sha256 возвращал общий статический буфер OpenSSL
+  std::atomic<uint64_t> hmac_mismatches{0};
+  vector<thread> signers{};
+  for (size_t t = 0; t < thread_counts.back(); t++) {
+    signers.emplace_back([&, t]() {
+      std::string payload{std::format("symbol=VETUSDT&orderId={}&timestamp=1700000000000", t)};
+      std::string expected{hmac_sha256("bench-secret", payload.c_str())};
+      for (uint64_t i = 0; i < 20000; i++) {
+        hmac_mismatches += (expected == hmac_sha256("bench-secret", payload.c_str())) ? 0 : 1;
+      }
+    });
+  }
+  for (auto &th : signers) {
+    th.join();
+  }
+  uint64_t connections = stand_in.accepted;
+  print_bench_row("Scaling 8 / 1 threads", std::format("{:.1f}x", throughput.back() / throughput.front()));
+  print_bench_row("Connections opened", std::format("{}", connections));
+  print_bench_row("Errors", std::format("{}", errors.load()));
+  bool ok = (0 == errors) && (0 == hmac_mismatches) && (throughput.back() > 2 * throughput.front())
+            && ((thread_counts.size() + 1) * n_requests == binance.endpoint_stats(EndpointId::CANCEL_ORDER).calls);
+  print_bench_row("Check", ok ? "OK" : "MISMATCH");
+}
+
+/// @brief Транспорт с ответом по методу: SBE ответ чужой схемы на любой запрос, JSON - на запрос без SBE
+struct ForeignSchemaTransport {
+  std::atomic<uint64_t> *calls{nullptr};
+
+  RequestResult request(RequestType r_type, const std::string &, const headerparams &h_params, const urlparams &) {
+    calls->fetch_add(1, std::memory_order_relaxed);
+    RequestResult result{};
+    result.transport = Status(0, "No error");
+    result.header = Status(200, "OK");
+    bool sbe_accept{false};
+    for (const std::string &line : h_params.header_params) {
+      sbe_accept = sbe_accept || line.starts_with("X-MBX-SBE");
+    }
+    if (sbe_accept) {
+      // Заголовок SBE: blockLength, templateId, schemaId = 999, version
+      result.content_type = std::string{sbe_content_type};
+      result.body = std::string{"\x08\x00\x01\x00\xe7\x03\x01\x00", 8} + std::string(8, '\0');
+    }
+    else {
+      result.content_type = "application/json;charset=UTF-8";
+      result.body = (RequestType::GET == r_type) ? std::string{"{\"serverTime\":1700000000000}"} : order_result(1);
+    }
+    return result;
+  }
+};
+
+void bench_sbe_fallback() {
+  print_bench_header("SBE fallback (foreign schema on 200: resend GET only)");
+  std::atomic<uint64_t> calls{0};
+  Auth auth{"bench-api-key", "bench-secret"};
+  // Ордер уже выставлен сервером: повтора нет, ошибка INVALID_RESPONSE, формат переключается на JSON
+  BasicBinance<ForeignSchemaTransport> order_client{auth, ForeignSchemaTransport{&calls}};
+  order_client.response_format(ResponseFormat::SBE);
+  Order order{"VETUSDT", 0, dec::decimal<8>("0.027"), dec::decimal<8>("423"), Side::BUY, OrderStatus::NEW, 0};
+  BinanceResult<Order> created{order_client.try_create_order(order)};
+  uint64_t order_calls = calls.exchange(0);
+  bool order_ok = !created.has_value() && (ErrorMessage::INVALID_RESPONSE == created.error().message)
+                  && (ResponseFormat::JSON == order_client.response_format());
+  // Чтение повторяется в JSON
+  BasicBinance<ForeignSchemaTransport> time_client{auth, ForeignSchemaTransport{&calls}};
+  time_client.response_format(ResponseFormat::SBE);
+  BinanceResult<uint64_t> time{time_client.call<endpoint::Time>()};
+  uint64_t time_calls = calls.exchange(0);
+  bool time_ok = time.has_value() && (1700000000000 == *time);
+  print_bench_row("Order requests sent", std::format("{}", order_calls));
+  print_bench_row("Time requests sent", std::format("{}", time_calls));
+  print_bench_row("Check", (order_ok && (1 == order_calls) && time_ok && (2 == time_calls)) ? "OK" : "MISMATCH");
+}
+
+int main() {
+  bench_price_batcher();
+  bench_price_table_decode();
+  bench_ttl_cache();
+  bench_exchange_info();
+  bench_market_stream();
+  bench_stream_manager();
+  bench_order_book();
+  bench_depth_decoder();
+  bench_order_session();
+  bench_user_stream_reconnect();
+  bench_sbe_decode();
+  bench_fix_session();
+  bench_order_template();
+  bench_order_resp_type();
+  bench_order_types();
+  bench_order_warmup();
+  bench_order_ladder();
+  bench_error_path();
+  bench_enum_tables();
+  bench_endpoint_dispatch();
+  bench_client_overhead();
+  bench_cached_error();
+  bench_shared_client();
+  bench_sbe_fallback();
+  cout << "==================OK========================" << endl;
+  return 0;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <chrono>
+
+#include "../src/stream/tcp_connection.hpp"
+#include "../src/utils/ring_buffer.hpp"
+#include "../src/fix/fix_codec.hpp"
+#include "./ws_server.hpp"
+
+/// @brief Локальная заглушка FIX сервера Binance (fix-oe, без TLS) для бенчмарков и проверок.
+/// Отвечает на Logon, NewOrderSingle (ExecutionReport NEW), OrderCancelRequest (ExecutionReport CANCELED),
+/// TestRequest и ResendRequest (SequenceReset-GapFill); skip_seq пропускает исходящий номер, чтобы проверить обработку разрыва,
+/// resend_from после Logon запрашивает повтор у клиента, чтобы проверить его GapFill.
+class FixStandIn {
+private:
+  WsStandIn listener{};
+  TcpConnection conn{};
+  FixWriter writer{};
+  FixMessage message{};
+  uint64_t out_seq{1};
+  uint64_t order_id{0};
+
+  void send(FixMsgType type, auto &&body) {
+    if ((0 != skip_seq) && (out_seq == skip_seq)) {
+      out_seq++;
+    }
+    writer.begin(type, "SPOT", sender, out_seq++, fix_time(1700000000000000));
+    body(writer);
+    std::string_view data = writer.finish();
+    conn.write(data.data(), data.size());
+  }
+
+  void execution(std::string_view cl_ord_id, uint64_t id, char status) {
+    send(FixMsgType::EXECUTION_REPORT, [&](FixWriter &w) {
+      w.field(FixTag::CL_ORD_ID, cl_ord_id)
+       .field(FixTag::ORDER_ID, id)
+       .field(FixTag::EXEC_TYPE, status)
+       .field(FixTag::ORD_STATUS, status)
+       .field(FixTag::SYMBOL, message.get(FixTag::SYMBOL))
+       .field(FixTag::SIDE, '1')
+       .field(FixTag::PRICE, std::string_view("0.02700000"))
+       .field(FixTag::ORDER_QTY, std::string_view("423.00000000"))
+       .field(FixTag::CUM_QTY, std::string_view("0.00000000"))
+       .field(FixTag::TRANSACT_TIME, std::string_view("20231114-22:13:20.000000"));
+    });
+  }
+public:
+  std::string sender{"BNCPP"};
+  uint64_t skip_seq{0}; // Пропустить исходящий MsgSeqNum (0 - без разрыва)
+  uint64_t resend_from{0}; // После Logon запросить повтор сообщений клиента с этого номера (0 - без запроса)
+  std::atomic<uint64_t> logons{0};
+  std::atomic<uint64_t> orders{0};
+  std::atomic<uint64_t> resend_requests{0};
+  std::atomic<uint64_t> gap_fills{0}; // GapFill клиента с OrigSendingTime
+  std::string signature{}; // RawData последнего Logon
+
+  /// @brief Порт заглушки
+  int port() const { return listener.port(); }
+
+  /// @brief Обслуживание одного подключения до Logout или разрыва
+  void serve() {
+    int fd = listener.accept_raw();
+    if (0 > fd) {
+      return;
+    }
+    conn.adopt(fd);
+    conn.set_nonblocking();
+    RingBuffer ring{1 << 16};
+    while (conn.valid()) {
+      if (!conn.wait_read(1000)) {
+        continue;
+      }
+      int n = conn.read(ring.write_ptr(), ring.writable());
+      if (0 > n) {
+        break;
+      }
+      ring.commit(n);
+      int64_t size{0};
+      bool logout{false};
+      while (0 < (size = fix_frame(std::string_view(ring.read_ptr(), ring.readable())))) {
+        message.parse(std::string_view(ring.read_ptr(), size));
+        switch (message.type()) {
+          case FixMsgType::LOGON:
+            logons++;
+            signature = message.get(FixTag::RAW_DATA);
+            out_seq = 1;
+            send(FixMsgType::LOGON, [this](FixWriter &w) {
+              w.field(FixTag::ENCRYPT_METHOD, '0')
+               .field(FixTag::HEART_BT_INT, message.get(FixTag::HEART_BT_INT))
+               .field(FixTag::RESET_SEQ_NUM_FLAG, 'Y');
+            });
+            if (0 != resend_from) {
+              send(FixMsgType::RESEND_REQUEST, [this](FixWriter &w) {
+                w.field(FixTag::BEGIN_SEQ_NO, resend_from).field(FixTag::END_SEQ_NO, uint64_t{0});
+              });
+            }
+            break;
+          case FixMsgType::NEW_ORDER_SINGLE:
+            orders++;
+            execution(message.get(FixTag::CL_ORD_ID), ++order_id, '0');
+            break;
+          case FixMsgType::ORDER_CANCEL_REQUEST:
+            execution(message.get(FixTag::CL_ORD_ID), message.get_u64(FixTag::ORDER_ID), '4');
+            break;
+          case FixMsgType::TEST_REQUEST:
+            send(FixMsgType::HEARTBEAT, [this](FixWriter &w) { w.field(FixTag::TEST_REQ_ID, message.get(FixTag::TEST_REQ_ID)); });
+            break;
+          case FixMsgType::RESEND_REQUEST: {
+            // Пропущенный номер закрывается GapFill
+            resend_requests++;
+            uint64_t begin = message.get_u64(FixTag::BEGIN_SEQ_NO);
+            uint64_t next = out_seq;
+            writer.begin(FixMsgType::SEQUENCE_RESET, "SPOT", sender, begin, fix_time(1700000000000000));
+            writer.field(FixTag::POSS_DUP_FLAG, 'Y').field(FixTag::ORIG_SENDING_TIME, std::string_view(fix_time(1700000000000000)));
+            writer.field(FixTag::GAP_FILL_FLAG, 'Y').field(FixTag::NEW_SEQ_NO, next);
+            std::string_view data = writer.finish();
+            conn.write(data.data(), data.size());
+            break;
+          }
+          case FixMsgType::SEQUENCE_RESET:
+            // PossDupFlag=Y без OrigSendingTime (122) сервер отклоняет
+            if (("Y" == message.get(FixTag::GAP_FILL_FLAG)) && !message.get(FixTag::ORIG_SENDING_TIME).empty()) {
+              gap_fills++;
+            }
+            break;
+          case FixMsgType::LOGOUT:
+            send(FixMsgType::LOGOUT, [](FixWriter &) {});
+            logout = true;
+            break;
+          default:
+            break;
+        }
+        ring.consume(size);
+      }
+      if ((0 > size) || logout) {
+        break;
+      }
+    }
+    conn.close();
+  }
+};
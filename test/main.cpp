@@ -5,6 +5,12 @@
 #include "../src/binance/binance_type.hpp"
 #include "../src/utils/utils.hpp"
 #include "../src/binance/binance.hpp"
+#include "../src/binance/order_template.hpp"
+#include "../src/binance/order_builder.hpp"
+#include "../src/binance/order_warmup.hpp"
+#include "../src/stream/user_stream.hpp"
+#include "../src/stream/order_session.hpp"
+#include "../src/fix/fix_session.hpp"
 
 using namespace std;
 
@@ -145,6 +151,62 @@ void test_price(Binance &binance) {
   }
 }
 
+void test_sbe(Binance &binance) {
+  binance.response_format(ResponseFormat::SBE);
+  try {
+    cout << left << setw(25) << "SBE timestamp" << left << setw(25) << binance.timestamp_ms() << endl;
+    cout << left << setw(25) << "SBE price " + test_symbol << left << setw(25) << val_to_str(binance.symbol_price(test_symbol)) << endl;
+    cout << left << setw(25) << "SBE all prices" << left << setw(25) << binance.all_prices().size() << endl;
+    cout << left << setw(25) << "Response format" << left << setw(25)
+         << ((ResponseFormat::SBE == binance.response_format()) ? "SBE" : "JSON (fallback)") << endl;
+  }
+  catch(const BinanceException& e) {
+    print_error("SBE", e);
+  }
+  binance.response_format(ResponseFormat::JSON);
+}
+
+void test_prices(Binance &binance) {
+  try {
+    vector<string_view> symbols{test_symbol, "BTCUSDT"};
+    PriceTable table{binance.prices(symbols)};
+    for (auto &symbol : symbols) {
+      cout << left << setw(25) << "Prices " + string(symbol) << left << setw(25) << val_to_str(table[symbol]) << endl;
+    }
+    cout << left << setw(25) << "All prices(symbols)" << left << setw(25) << binance.all_prices().size() << endl;
+  }
+  catch(const BinanceException& e) {
+    print_error("Prices", e);
+  }
+}
+
+void test_price_cache(Binance &binance) {
+  try {
+    binance.cache_policy("/api/v3/ticker/price", CachePolicy{chrono::milliseconds(1000), chrono::milliseconds(5000)});
+    for (int i = 0; i < 3; i++) {
+      binance.symbol_price(test_symbol);
+    }
+    CacheStats stats{binance.cache_stats("/api/v3/ticker/price")};
+    cout << left << setw(25) << "Price cache hit rate" << left << setw(25) << stats.hit_rate() << endl;
+    binance.cache_policy("/api/v3/ticker/price", CachePolicy{});
+  }
+  catch(const BinanceException& e) {
+    print_error("Price cache", e);
+  }
+}
+
+void test_exchange_info(Binance &binance) {
+  try {
+    shared_ptr<const ExchangeInfo> info{binance.load_exchange_info()};
+    cout << left << setw(25) << "Exchange info(symbols)" << left << setw(25) << info->size() << endl;
+    Order order{test_order};
+    cout << left << setw(25) << "Filters " + test_symbol << left << setw(25) << filter_result_to_str(info->round(order)) << endl;
+  }
+  catch(const BinanceException& e) {
+    print_error("Exchange info", e);
+  }
+}
+
 void test_asset_balance(Binance &binance) {
   try {
     Balance balance{binance.balance()};
@@ -184,6 +246,162 @@ void test_create_open_cancel_orders(Binance &binance) {
   }
 }
 
+void test_requote_orders(Binance &binance) {
+  try {
+    Order new_order{binance.create_order(test_order)};
+    cout << left << setw(25) << "Create new order" << left << setw(25) << "OK" << endl;
+    print_order_header();
+    print_order(new_order);
+    AmendResult amended{binance.amend_order(new_order.symbol, new_order.orderId, dec::decimal<8>("400.00000000"))};
+    cout << "============================================" << endl;
+    cout << left << setw(25) << "Amend keep priority" << left << setw(25) << "OK" << endl;
+    print_order(amended.order);
+    Order requote{test_order};
+    requote.price = dec::decimal<8>("0.02600000");
+    CancelReplaceResult replaced{binance.cancel_replace(new_order.orderId, requote)};
+    cout << "============================================" << endl;
+    cout << left << setw(25) << "Cancel replace" << left << setw(25)
+         << ((LegResult::SUCCESS == replaced.new_order_result) ? "OK" : replaced.cancel_msg + replaced.new_order_msg) << endl;
+    print_order(replaced.canceled);
+    print_order(replaced.created);
+    if (LegResult::SUCCESS == replaced.new_order_result) {
+      binance.cancel_order(replaced.created.symbol, replaced.created.orderId);
+    }
+  }
+  catch(const BinanceException& e) {
+    print_error("Requote orders", e);
+  }
+}
+
+void test_cancel_all(Binance &binance) {
+  try {
+    binance.create_order(test_order);
+    binance.create_order(test_order);
+    vector<Order> canceled{binance.cancel_all(test_symbol)};
+    cout << left << setw(25) << "Cancel all " + test_symbol << left << setw(25) << canceled.size() << endl;
+    vector<string> symbols{test_symbol, "BTCUSDT"};
+    for (auto &result : binance.cancel_all(symbols)) {
+      cout << left << setw(25) << "Cancel all " + result.symbol << left << setw(25)
+           << ((ExceptionType::None == result.error.type) ? std::to_string(result.orders.size()) : std::string{result.error.msg()}) << endl;
+    }
+  }
+  catch(const BinanceException& e) {
+    print_error("Cancel all", e);
+  }
+}
+
+void test_create_orders(Binance &binance) {
+  try {
+    vector<Order> ladder{};
+    for (int64_t i = 0; i < 5; i++) {
+      Order order{test_order};
+      order.price = test_order.price - dec::decimal<8>(i) / 10000;
+      ladder.push_back(order);
+    }
+    size_t created{0};
+    for (auto &result : binance.create_orders(ladder)) {
+      if (result.has_value()) {
+        created++;
+      }
+      else {
+        print_error("Create orders", result.error().exception());
+      }
+    }
+    cout << left << setw(25) << "Create orders" << left << setw(25) << std::format("{} / {}", created, ladder.size()) << endl;
+    binance.cancel_all(test_symbol);
+  }
+  catch(const BinanceException& e) {
+    print_error("Create orders", e);
+  }
+}
+
+void test_try_api(Binance &binance) {
+  BinanceResult<Order> canceled{binance.try_cancel_order(test_symbol, 1)};
+  if (canceled.has_value()) {
+    cout << left << setw(25) << "Try cancel unknown" << left << setw(25) << "UNEXPECTED" << endl;
+    return;
+  }
+  BinanceError error{canceled.error()};
+  cout << left << setw(25) << "Try cancel unknown" << left << setw(25)
+       << std::format("{} {} {}", error.code, (ErrorMessage::UNKNOWN_ORDER == error.message) ? "UNKNOWN_ORDER" : "OTHER", error.msg()) << endl;
+  BinanceResult<Balance> balance{binance.try_balance()};
+  cout << left << setw(25) << "Try balance" << left << setw(25) << (balance.has_value() ? "OK" : std::string{balance.error().msg()}) << endl;
+}
+
+void test_endpoint_call(Binance &binance) {
+  BinanceResult<uint64_t> time{binance.call<endpoint::Time>()};
+  cout << left << setw(25) << "Call time" << left << setw(25) << (time.has_value() ? std::to_string(*time) : std::string{time.error().msg()}) << endl;
+  urlparams params;
+  params.add("symbol", test_symbol);
+  BinanceResult<std::vector<Order>> orders{binance.call<endpoint::OpenOrders>(params)};
+  cout << left << setw(25) << "Call open orders" << left << setw(25) << (orders.has_value() ? std::to_string(orders->size()) : std::string{orders.error().msg()}) << endl;
+  for (EndpointId id : {EndpointId::TIME, EndpointId::OPEN_ORDERS}) {
+    EndpointStats stats{binance.endpoint_stats(id)};
+    cout << left << setw(25) << endpoint_table[static_cast<size_t>(id)].name << left << setw(25)
+         << std::format("calls {} errors {} weight {} p50 {} us", stats.calls, stats.errors, stats.weight, stats.p50_ns / 1000) << endl;
+  }
+  cout << left << setw(25) << "Weight used" << left << setw(25) << binance.weight_used() << endl;
+}
+
+void test_order_template(Binance &binance) {
+  try {
+    OrderTemplate order_template{get_auth(), test_symbol, Side::BUY};
+    Order order{binance.create_order(order_template, test_order.price, test_order.origQty)};
+    cout << left << setw(25) << "Template order" << left << setw(25) << order.orderId << endl;
+    binance.cancel_order(order.symbol, order.orderId);
+  }
+  catch(const BinanceException& e) {
+    print_error("Template order", e);
+  }
+}
+
+void test_order_ack(Binance &binance) {
+  try {
+    OrderAck ack{binance.create_order_ack(test_order)};
+    cout << left << setw(25) << "Order ACK" << left << setw(25) << std::format("{} {}", ack.orderId, ack.clientOrderId) << endl;
+    binance.cancel_order(ack.symbol, ack.orderId);
+    Order order{binance.create_order(test_order, OrderRespType::FULL)};
+    cout << left << setw(25) << "Order FULL fills" << left << setw(25) << order.fills.size() << endl;
+    binance.cancel_order(order.symbol, order.orderId);
+  }
+  catch(const BinanceException& e) {
+    print_error("Order ACK", e);
+  }
+}
+
+void test_order_types(Binance &binance) {
+  try {
+    // Цена ниже рынка: IOC истекает сразу, LIMIT_MAKER остается в книге
+    Order ioc{limit_order<TimeInForce::IOC>(test_symbol, Side::BUY, test_order.price, test_order.origQty)};
+    Order expired{binance.create_order(ioc)};
+    cout << left << setw(25) << "Order IOC" << left << setw(25) << order_status_to_str(expired.status) << endl;
+    Order maker{limit_maker_order(test_symbol, Side::BUY, test_order.price, test_order.origQty)};
+    Order resting{binance.create_order(maker)};
+    cout << left << setw(25) << "Order LIMIT_MAKER" << left << setw(25) << order_status_to_str(resting.status) << endl;
+    binance.cancel_order(resting.symbol, resting.orderId);
+  }
+  catch(const BinanceException& e) {
+    print_error("Order types", e);
+  }
+}
+
+void test_warmup(Binance &binance) {
+  try {
+    binance.test_order(test_order);
+    cout << left << setw(25) << "Test order" << left << setw(25) << "OK" << endl;
+    OrderWarmup warmup{binance, test_order, WarmupConfig{chrono::milliseconds{1000}}};
+    warmup.start();
+    this_thread::sleep_for(chrono::milliseconds{2500});
+    warmup.stop();
+    WarmupStats st{warmup.stats()};
+    cout << left << setw(25) << "Warmup runs/errors" << left << setw(25) << std::format("{} / {}", st.runs, st.errors) << endl;
+    cout << left << setw(25) << "Warmup last (us)" << left << setw(25) << st.last_ns / 1000 << endl;
+  }
+  catch(const BinanceException& e) {
+    print_error("Warmup", e);
+  }
+}
+
 void test_filled_orders_info(Binance &binance) {
   try {
     vector<Order> all_orders{binance.all_orders(test_symbol)};
@@ -204,6 +422,112 @@ void test_filled_orders_info(Binance &binance) {
   }
 }
 
+void test_user_stream(Binance &binance) {
+  UserDataStream stream{binance};
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::vector<ExecutionReport> reports{};
+  stream.on_order([&](const ExecutionReport &report) {
+    std::lock_guard<std::mutex> lock(mtx);
+    reports.push_back(report);
+    cv.notify_all();
+  });
+  // События за время разрыва потеряны: после переподключения ордера и баланс загружаются заново
+  stream.on_reconnect([&]() {
+    std::vector<Order> open{binance.open_orders(test_symbol)};
+    binance.balance();
+    cout << left << setw(25) << "User stream resync" << left << setw(25) << open.size() << endl;
+  });
+  Status status{stream.start()};
+  if (0 != status.code) {
+    cout << left << setw(25) << "User stream" << left << setw(25) << status.msg << endl;
+    return;
+  }
+  cout << left << setw(25) << "User stream" << left << setw(25) << "OK" << endl;
+  try {
+    Order new_order{binance.create_order(test_order)};
+    binance.cancel_order(new_order.symbol, new_order.orderId);
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait_for(lock, std::chrono::seconds(10), [&]() { return reports.size() >= 2; });
+    print_order_header();
+    bool fields_ok{!reports.empty()};
+    for (ExecutionReport &report : reports) {
+      print_order(report.order);
+      fields_ok = fields_ok && (test_order.type == report.order.type) && (test_order.timeInForce == report.order.timeInForce);
+    }
+    cout << left << setw(25) << "Report type/timeInForce" << left << setw(25) << (fields_ok ? "OK" : "MISMATCH") << endl;
+  }
+  catch(const BinanceException& e) {
+    print_error("User stream", e);
+  }
+  stream.stop();
+}
+
+void test_order_session() {
+  OrderSession session{get_auth()};
+  Status status{session.connect()};
+  if (0 != status.code) {
+    cout << left << setw(25) << "Order session" << left << setw(25) << status.msg << endl;
+    return;
+  }
+  try {
+    Order new_order{session.create_order(test_order)};
+    cout << left << setw(25) << "WS API create order" << left << setw(25) << "OK" << endl;
+    print_order_header();
+    print_order(new_order);
+    Order cancel_order{session.cancel_order(new_order.symbol, new_order.orderId)};
+    cout << "============================================" << endl;
+    cout << left << setw(25) << "WS API cancel order" << left << setw(25) << "OK" << endl;
+    print_order(cancel_order);
+  }
+  catch(const BinanceException& e) {
+    print_error("Order session", e);
+  }
+}
+
+/// @brief Закрытый ключ Ed25519 (PEM) из файла ed25519_key конфигурации (пустая строка - ключа нет)
+string get_ed25519_pem() {
+  ifstream ifs(config_path.c_str());
+  stringstream buffer;
+  buffer << ifs.rdbuf();
+  if (!json::accept(buffer.str())) {
+    return string{};
+  }
+  json js = json::parse(buffer.str());
+  ifstream key(js.value("ed25519_key", string{}).c_str());
+  stringstream pem;
+  pem << key.rdbuf();
+  return pem.str();
+}
+
+void test_fix_session() {
+  string pem{get_ed25519_pem()};
+  if (pem.empty()) {
+    cout << left << setw(25) << "FIX session" << left << setw(25) << "No ed25519_key" << endl;
+    return;
+  }
+  FixSession session{get_auth(), pem};
+  Status status{session.logon()};
+  if (0 != status.code) {
+    cout << left << setw(25) << "FIX session" << left << setw(25) << status.msg << endl;
+    return;
+  }
+  try {
+    Order new_order{session.create_order(test_order)};
+    cout << left << setw(25) << "FIX create order" << left << setw(25) << "OK" << endl;
+    print_order_header();
+    print_order(new_order);
+    Order cancel_order{session.cancel_order(new_order.symbol, new_order.orderId)};
+    cout << "============================================" << endl;
+    cout << left << setw(25) << "FIX cancel order" << left << setw(25) << "OK" << endl;
+    print_order(cancel_order);
+  }
+  catch(const BinanceException& e) {
+    print_error("FIX session", e);
+  }
+  session.logout();
+}
+
 int main() {
   Binance binance{get_auth()};
   cout << "============================================" << endl;
@@ -220,6 +544,14 @@ int main() {
   cout << "============================================" << endl;
   test_price(binance);
   cout << "============================================" << endl;
+  test_prices(binance);
+  cout << "============================================" << endl;
+  test_price_cache(binance);
+  cout << "============================================" << endl;
+  test_sbe(binance);
+  cout << "============================================" << endl;
+  test_exchange_info(binance);
+  cout << "============================================" << endl;
   cout << "===============AUTH REQUEST=================" << endl;
   cout << "============================================" << endl << endl;
   cout << "============================================" << endl;
@@ -228,6 +560,30 @@ int main() {
   test_filled_orders_info(binance);
   cout << "============================================" << endl;
   test_create_open_cancel_orders(binance);
+  cout << "============================================" << endl;
+  test_requote_orders(binance);
+  cout << "============================================" << endl;
+  test_cancel_all(binance);
+  cout << "============================================" << endl;
+  test_create_orders(binance);
+  cout << "============================================" << endl;
+  test_try_api(binance);
+  cout << "============================================" << endl;
+  test_endpoint_call(binance);
+  cout << "============================================" << endl;
+  test_order_template(binance);
+  cout << "============================================" << endl;
+  test_order_ack(binance);
+  cout << "============================================" << endl;
+  test_order_types(binance);
+  cout << "============================================" << endl;
+  test_warmup(binance);
+  cout << "============================================" << endl;
+  test_user_stream(binance);
+  cout << "============================================" << endl;
+  test_order_session();
+  cout << "============================================" << endl;
+  test_fix_session();
   cout << "==================OK========================" << endl;
   return 0;
 }
\ No newline at end of file
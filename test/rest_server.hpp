@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <format>
+#include <poll.h>
+
+#include "./ws_server.hpp"
+
+/// @brief Локальная заглушка REST с keep-alive: несколько HTTP запросов на соединение, поток на соединение.
+/// Ответ на запрос формирует handler по первой строке запроса ("POST /api/v3/order/test HTTP/1.1").
+class RestStandIn {
+private:
+  WsStandIn listener{};
+  std::function<std::string(std::string_view)> handler;
+  std::atomic<bool> running{true};
+  std::thread acceptor{};
+  std::mutex mtx;
+  std::vector<std::thread> connections{};
+
+  void serve(int fd) {
+    std::string data{};
+    char buffer[4096];
+    while (running) {
+      pollfd pfd{fd, POLLIN, 0};
+      if (0 >= ::poll(&pfd, 1, 50)) {
+        continue;
+      }
+      ssize_t r = ::read(fd, buffer, sizeof(buffer));
+      if (0 >= r) {
+        break;
+      }
+      data.append(buffer, r);
+      size_t end{0};
+      while (std::string::npos != (end = data.find("\r\n\r\n"))) {
+        size_t length{0};
+        size_t pos = data.find("Content-Length: ");
+        if ((std::string::npos != pos) && (pos < end)) {
+          length = std::stoull(data.substr(pos + 16));
+        }
+        if (data.size() < end + 4 + length) {
+          break;
+        }
+        std::string body{handler(std::string_view(data).substr(0, data.find("\r\n")))};
+        data.erase(0, end + 4 + length);
+        requests++;
+        std::string response{std::format("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: {}\r\n\r\n{}", body.size(), body)};
+        ::write(fd, response.data(), response.size());
+      }
+    }
+    ::close(fd);
+  }
+public:
+  std::atomic<uint64_t> accepted{0}; // Принятых соединений
+  std::atomic<uint64_t> requests{0};
+
+  explicit RestStandIn(std::function<std::string(std::string_view)> handler) : handler(handler) {
+    acceptor = std::thread([this]() {
+      while (true) {
+        int fd = listener.accept_raw();
+        if ((0 > fd) || !running) {
+          if (0 <= fd) {
+            ::close(fd);
+          }
+          break;
+        }
+        accepted++;
+        std::lock_guard<std::mutex> lock(mtx);
+        connections.emplace_back(&RestStandIn::serve, this, fd);
+      }
+    });
+  }
+  RestStandIn(const RestStandIn&) = delete;
+  RestStandIn& operator=(const RestStandIn&) = delete;
+
+  /// @brief Порт заглушки
+  int port() const { return listener.port(); }
+
+  ~RestStandIn() {
+    running = false;
+    // Разблокировать accept подключением к себе
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(listener.port());
+    ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    ::close(fd);
+    acceptor.join();
+    for (auto &connection : connections) {
+      connection.join();
+    }
+  }
+};
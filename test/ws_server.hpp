@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include "../src/stream/websocket.hpp"
+
+/// @brief Локальная заглушка WebSocket сервера Binance (ws://127.0.0.1:<port>) для бенчмарков
+class WsStandIn {
+private:
+  int listen_fd{-1};
+  int listen_port{0};
+public:
+  WsStandIn() {
+    listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    int flag{1};
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    listen(listen_fd, 64);
+    socklen_t len = sizeof(addr);
+    getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    listen_port = ntohs(addr.sin_port);
+  }
+
+  /// @brief Порт заглушки
+  int port() const { return listen_port; }
+
+  /// @brief Принять подключение и выполнить рукопожатие WebSocket
+  /// @return Соединение (nullptr - ошибка)
+  std::unique_ptr<WebSocket> accept_client() {
+    int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) {
+      return nullptr;
+    }
+    auto ws = std::make_unique<WebSocket>();
+    if (0 != ws->accept(fd).code) {
+      return nullptr;
+    }
+    return ws;
+  }
+
+  /// @brief Принять подключение без рукопожатия WebSocket (для заглушек других протоколов)
+  /// @return Сокет (-1 - ошибка)
+  int accept_raw() {
+    return accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+  }
+
+  ~WsStandIn() {
+    if (0 <= listen_fd) {
+      close(listen_fd);
+    }
+  }
+};